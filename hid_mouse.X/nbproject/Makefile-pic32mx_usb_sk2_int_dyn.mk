@@ -45,17 +45,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=../src/system_config/pic32mx_usb_sk2_int_dyn/framework/system/clk/src/sys_clk_static.c ../src/system_config/pic32mx_usb_sk2_int_dyn/framework/system/ports/src/sys_ports_static.c ../src/system_config/pic32mx_usb_sk2_int_dyn/system_init.c ../src/system_config/pic32mx_usb_sk2_int_dyn/system_tasks.c ../src/system_config/pic32mx_usb_sk2_int_dyn/system_interrupt.c ../src/app.c ../src/main.c ../src/mouse.c ../../../../../../../../../MPLABXProjects/HWone.X/i2c_display.c ../../../../../../../../../MPLABXProjects/HWone.X/i2c_master_int.c ../../../../../../bsp/pic32mx_usb_sk2/bsp_sys_init.c ../../../../../../framework/driver/usb/usbfs/src/dynamic/drv_usb.c ../../../../../../framework/driver/usb/usbfs/src/dynamic/drv_usb_device.c ../../../../../../framework/system/devcon/src/sys_devcon.c ../../../../../../framework/system/devcon/src/sys_devcon_pic32mx.c ../../../../../../framework/system/int/src/sys_int_pic32.c ../../../../../../framework/system/ports/src/sys_ports.c ../../../../../../framework/usb/src/dynamic/usb_device.c ../../../../../../framework/usb/src/dynamic/usb_device_hid.c
+SOURCEFILES_QUOTED_IF_SPACED=../src/system_config/pic32mx_usb_sk2_int_dyn/framework/system/clk/src/sys_clk_static.c ../src/system_config/pic32mx_usb_sk2_int_dyn/framework/system/ports/src/sys_ports_static.c ../src/system_config/pic32mx_usb_sk2_int_dyn/system_init.c ../src/system_config/pic32mx_usb_sk2_int_dyn/system_tasks.c ../src/system_config/pic32mx_usb_sk2_int_dyn/system_interrupt.c ../src/app.c ../src/main.c ../src/mouse.c ../src/accel.c ../src/spi_xfer.c ../src/spsc_ring.c ../src/motion.c ../src/timebase.c ../src/timer_wheel.c ../src/run_loop.c ../src/profiler.c ../src/trace.c ../src/capture.c ../src/tilt.c ../src/decimator.c ../src/dsp.c ../src/report_pool.c ../src/hid_idle.c ../../../../../../../../../MPLABXProjects/HWone.X/i2c_display.c ../../../../../../../../../MPLABXProjects/HWone.X/i2c_master_int.c ../../../../../../bsp/pic32mx_usb_sk2/bsp_sys_init.c ../../../../../../framework/driver/usb/usbfs/src/dynamic/drv_usb.c ../../../../../../framework/driver/usb/usbfs/src/dynamic/drv_usb_device.c ../../../../../../framework/system/devcon/src/sys_devcon.c ../../../../../../framework/system/devcon/src/sys_devcon_pic32mx.c ../../../../../../framework/system/int/src/sys_int_pic32.c ../../../../../../framework/system/ports/src/sys_ports.c ../../../../../../framework/usb/src/dynamic/usb_device.c ../../../../../../framework/usb/src/dynamic/usb_device_hid.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/102310384/sys_clk_static.o ${OBJECTDIR}/_ext/1956551008/sys_ports_static.o ${OBJECTDIR}/_ext/1774247193/system_init.o ${OBJECTDIR}/_ext/1774247193/system_tasks.o ${OBJECTDIR}/_ext/1774247193/system_interrupt.o ${OBJECTDIR}/_ext/1360937237/app.o ${OBJECTDIR}/_ext/1360937237/main.o ${OBJECTDIR}/_ext/1360937237/mouse.o ${OBJECTDIR}/_ext/572315145/i2c_display.o ${OBJECTDIR}/_ext/572315145/i2c_master_int.o ${OBJECTDIR}/_ext/1979166340/bsp_sys_init.o ${OBJECTDIR}/_ext/1585079243/drv_usb.o ${OBJECTDIR}/_ext/1585079243/drv_usb_device.o ${OBJECTDIR}/_ext/912498863/sys_devcon.o ${OBJECTDIR}/_ext/912498863/sys_devcon_pic32mx.o ${OBJECTDIR}/_ext/711155467/sys_int_pic32.o ${OBJECTDIR}/_ext/1653354328/sys_ports.o ${OBJECTDIR}/_ext/692885480/usb_device.o ${OBJECTDIR}/_ext/692885480/usb_device_hid.o
-POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/102310384/sys_clk_static.o.d ${OBJECTDIR}/_ext/1956551008/sys_ports_static.o.d ${OBJECTDIR}/_ext/1774247193/system_init.o.d ${OBJECTDIR}/_ext/1774247193/system_tasks.o.d ${OBJECTDIR}/_ext/1774247193/system_interrupt.o.d ${OBJECTDIR}/_ext/1360937237/app.o.d ${OBJECTDIR}/_ext/1360937237/main.o.d ${OBJECTDIR}/_ext/1360937237/mouse.o.d ${OBJECTDIR}/_ext/572315145/i2c_display.o.d ${OBJECTDIR}/_ext/572315145/i2c_master_int.o.d ${OBJECTDIR}/_ext/1979166340/bsp_sys_init.o.d ${OBJECTDIR}/_ext/1585079243/drv_usb.o.d ${OBJECTDIR}/_ext/1585079243/drv_usb_device.o.d ${OBJECTDIR}/_ext/912498863/sys_devcon.o.d ${OBJECTDIR}/_ext/912498863/sys_devcon_pic32mx.o.d ${OBJECTDIR}/_ext/711155467/sys_int_pic32.o.d ${OBJECTDIR}/_ext/1653354328/sys_ports.o.d ${OBJECTDIR}/_ext/692885480/usb_device.o.d ${OBJECTDIR}/_ext/692885480/usb_device_hid.o.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/102310384/sys_clk_static.o ${OBJECTDIR}/_ext/1956551008/sys_ports_static.o ${OBJECTDIR}/_ext/1774247193/system_init.o ${OBJECTDIR}/_ext/1774247193/system_tasks.o ${OBJECTDIR}/_ext/1774247193/system_interrupt.o ${OBJECTDIR}/_ext/1360937237/app.o ${OBJECTDIR}/_ext/1360937237/main.o ${OBJECTDIR}/_ext/1360937237/mouse.o ${OBJECTDIR}/_ext/1360937237/accel.o ${OBJECTDIR}/_ext/1360937237/spi_xfer.o ${OBJECTDIR}/_ext/1360937237/spsc_ring.o ${OBJECTDIR}/_ext/1360937237/motion.o ${OBJECTDIR}/_ext/1360937237/timebase.o ${OBJECTDIR}/_ext/1360937237/timer_wheel.o ${OBJECTDIR}/_ext/1360937237/run_loop.o ${OBJECTDIR}/_ext/1360937237/profiler.o ${OBJECTDIR}/_ext/1360937237/trace.o ${OBJECTDIR}/_ext/1360937237/capture.o ${OBJECTDIR}/_ext/1360937237/tilt.o ${OBJECTDIR}/_ext/1360937237/decimator.o ${OBJECTDIR}/_ext/1360937237/dsp.o ${OBJECTDIR}/_ext/1360937237/report_pool.o ${OBJECTDIR}/_ext/1360937237/hid_idle.o ${OBJECTDIR}/_ext/572315145/i2c_display.o ${OBJECTDIR}/_ext/572315145/i2c_master_int.o ${OBJECTDIR}/_ext/1979166340/bsp_sys_init.o ${OBJECTDIR}/_ext/1585079243/drv_usb.o ${OBJECTDIR}/_ext/1585079243/drv_usb_device.o ${OBJECTDIR}/_ext/912498863/sys_devcon.o ${OBJECTDIR}/_ext/912498863/sys_devcon_pic32mx.o ${OBJECTDIR}/_ext/711155467/sys_int_pic32.o ${OBJECTDIR}/_ext/1653354328/sys_ports.o ${OBJECTDIR}/_ext/692885480/usb_device.o ${OBJECTDIR}/_ext/692885480/usb_device_hid.o
+POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/102310384/sys_clk_static.o.d ${OBJECTDIR}/_ext/1956551008/sys_ports_static.o.d ${OBJECTDIR}/_ext/1774247193/system_init.o.d ${OBJECTDIR}/_ext/1774247193/system_tasks.o.d ${OBJECTDIR}/_ext/1774247193/system_interrupt.o.d ${OBJECTDIR}/_ext/1360937237/app.o.d ${OBJECTDIR}/_ext/1360937237/main.o.d ${OBJECTDIR}/_ext/1360937237/mouse.o.d ${OBJECTDIR}/_ext/1360937237/accel.o.d ${OBJECTDIR}/_ext/1360937237/spi_xfer.o.d ${OBJECTDIR}/_ext/1360937237/spsc_ring.o.d ${OBJECTDIR}/_ext/1360937237/motion.o.d ${OBJECTDIR}/_ext/1360937237/timebase.o.d ${OBJECTDIR}/_ext/1360937237/timer_wheel.o.d ${OBJECTDIR}/_ext/1360937237/run_loop.o.d ${OBJECTDIR}/_ext/1360937237/profiler.o.d ${OBJECTDIR}/_ext/1360937237/trace.o.d ${OBJECTDIR}/_ext/1360937237/capture.o.d ${OBJECTDIR}/_ext/1360937237/tilt.o.d ${OBJECTDIR}/_ext/1360937237/decimator.o.d ${OBJECTDIR}/_ext/1360937237/dsp.o.d ${OBJECTDIR}/_ext/1360937237/report_pool.o.d ${OBJECTDIR}/_ext/1360937237/hid_idle.o.d ${OBJECTDIR}/_ext/572315145/i2c_display.o.d ${OBJECTDIR}/_ext/572315145/i2c_master_int.o.d ${OBJECTDIR}/_ext/1979166340/bsp_sys_init.o.d ${OBJECTDIR}/_ext/1585079243/drv_usb.o.d ${OBJECTDIR}/_ext/1585079243/drv_usb_device.o.d ${OBJECTDIR}/_ext/912498863/sys_devcon.o.d ${OBJECTDIR}/_ext/912498863/sys_devcon_pic32mx.o.d ${OBJECTDIR}/_ext/711155467/sys_int_pic32.o.d ${OBJECTDIR}/_ext/1653354328/sys_ports.o.d ${OBJECTDIR}/_ext/692885480/usb_device.o.d ${OBJECTDIR}/_ext/692885480/usb_device_hid.o.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/_ext/102310384/sys_clk_static.o ${OBJECTDIR}/_ext/1956551008/sys_ports_static.o ${OBJECTDIR}/_ext/1774247193/system_init.o ${OBJECTDIR}/_ext/1774247193/system_tasks.o ${OBJECTDIR}/_ext/1774247193/system_interrupt.o ${OBJECTDIR}/_ext/1360937237/app.o ${OBJECTDIR}/_ext/1360937237/main.o ${OBJECTDIR}/_ext/1360937237/mouse.o ${OBJECTDIR}/_ext/572315145/i2c_display.o ${OBJECTDIR}/_ext/572315145/i2c_master_int.o ${OBJECTDIR}/_ext/1979166340/bsp_sys_init.o ${OBJECTDIR}/_ext/1585079243/drv_usb.o ${OBJECTDIR}/_ext/1585079243/drv_usb_device.o ${OBJECTDIR}/_ext/912498863/sys_devcon.o ${OBJECTDIR}/_ext/912498863/sys_devcon_pic32mx.o ${OBJECTDIR}/_ext/711155467/sys_int_pic32.o ${OBJECTDIR}/_ext/1653354328/sys_ports.o ${OBJECTDIR}/_ext/692885480/usb_device.o ${OBJECTDIR}/_ext/692885480/usb_device_hid.o
+OBJECTFILES=${OBJECTDIR}/_ext/102310384/sys_clk_static.o ${OBJECTDIR}/_ext/1956551008/sys_ports_static.o ${OBJECTDIR}/_ext/1774247193/system_init.o ${OBJECTDIR}/_ext/1774247193/system_tasks.o ${OBJECTDIR}/_ext/1774247193/system_interrupt.o ${OBJECTDIR}/_ext/1360937237/app.o ${OBJECTDIR}/_ext/1360937237/main.o ${OBJECTDIR}/_ext/1360937237/mouse.o ${OBJECTDIR}/_ext/1360937237/accel.o ${OBJECTDIR}/_ext/1360937237/spi_xfer.o ${OBJECTDIR}/_ext/1360937237/spsc_ring.o ${OBJECTDIR}/_ext/1360937237/motion.o ${OBJECTDIR}/_ext/1360937237/timebase.o ${OBJECTDIR}/_ext/1360937237/timer_wheel.o ${OBJECTDIR}/_ext/1360937237/run_loop.o ${OBJECTDIR}/_ext/1360937237/profiler.o ${OBJECTDIR}/_ext/1360937237/trace.o ${OBJECTDIR}/_ext/1360937237/capture.o ${OBJECTDIR}/_ext/1360937237/tilt.o ${OBJECTDIR}/_ext/1360937237/decimator.o ${OBJECTDIR}/_ext/1360937237/dsp.o ${OBJECTDIR}/_ext/1360937237/report_pool.o ${OBJECTDIR}/_ext/1360937237/hid_idle.o ${OBJECTDIR}/_ext/572315145/i2c_display.o ${OBJECTDIR}/_ext/572315145/i2c_master_int.o ${OBJECTDIR}/_ext/1979166340/bsp_sys_init.o ${OBJECTDIR}/_ext/1585079243/drv_usb.o ${OBJECTDIR}/_ext/1585079243/drv_usb_device.o ${OBJECTDIR}/_ext/912498863/sys_devcon.o ${OBJECTDIR}/_ext/912498863/sys_devcon_pic32mx.o ${OBJECTDIR}/_ext/711155467/sys_int_pic32.o ${OBJECTDIR}/_ext/1653354328/sys_ports.o ${OBJECTDIR}/_ext/692885480/usb_device.o ${OBJECTDIR}/_ext/692885480/usb_device_hid.o
 
 # Source Files
-SOURCEFILES=../src/system_config/pic32mx_usb_sk2_int_dyn/framework/system/clk/src/sys_clk_static.c ../src/system_config/pic32mx_usb_sk2_int_dyn/framework/system/ports/src/sys_ports_static.c ../src/system_config/pic32mx_usb_sk2_int_dyn/system_init.c ../src/system_config/pic32mx_usb_sk2_int_dyn/system_tasks.c ../src/system_config/pic32mx_usb_sk2_int_dyn/system_interrupt.c ../src/app.c ../src/main.c ../src/mouse.c ../../../../../../../../../MPLABXProjects/HWone.X/i2c_display.c ../../../../../../../../../MPLABXProjects/HWone.X/i2c_master_int.c ../../../../../../bsp/pic32mx_usb_sk2/bsp_sys_init.c ../../../../../../framework/driver/usb/usbfs/src/dynamic/drv_usb.c ../../../../../../framework/driver/usb/usbfs/src/dynamic/drv_usb_device.c ../../../../../../framework/system/devcon/src/sys_devcon.c ../../../../../../framework/system/devcon/src/sys_devcon_pic32mx.c ../../../../../../framework/system/int/src/sys_int_pic32.c ../../../../../../framework/system/ports/src/sys_ports.c ../../../../../../framework/usb/src/dynamic/usb_device.c ../../../../../../framework/usb/src/dynamic/usb_device_hid.c
+SOURCEFILES=../src/system_config/pic32mx_usb_sk2_int_dyn/framework/system/clk/src/sys_clk_static.c ../src/system_config/pic32mx_usb_sk2_int_dyn/framework/system/ports/src/sys_ports_static.c ../src/system_config/pic32mx_usb_sk2_int_dyn/system_init.c ../src/system_config/pic32mx_usb_sk2_int_dyn/system_tasks.c ../src/system_config/pic32mx_usb_sk2_int_dyn/system_interrupt.c ../src/app.c ../src/main.c ../src/mouse.c ../src/accel.c ../src/spi_xfer.c ../src/spsc_ring.c ../src/motion.c ../src/timebase.c ../src/timer_wheel.c ../src/run_loop.c ../src/profiler.c ../src/trace.c ../src/capture.c ../src/tilt.c ../src/decimator.c ../src/dsp.c ../src/report_pool.c ../src/hid_idle.c ../../../../../../../../../MPLABXProjects/HWone.X/i2c_display.c ../../../../../../../../../MPLABXProjects/HWone.X/i2c_master_int.c ../../../../../../bsp/pic32mx_usb_sk2/bsp_sys_init.c ../../../../../../framework/driver/usb/usbfs/src/dynamic/drv_usb.c ../../../../../../framework/driver/usb/usbfs/src/dynamic/drv_usb_device.c ../../../../../../framework/system/devcon/src/sys_devcon.c ../../../../../../framework/system/devcon/src/sys_devcon_pic32mx.c ../../../../../../framework/system/int/src/sys_int_pic32.c ../../../../../../framework/system/ports/src/sys_ports.c ../../../../../../framework/usb/src/dynamic/usb_device.c ../../../../../../framework/usb/src/dynamic/usb_device_hid.c
 
 
 CFLAGS=
@@ -142,6 +142,96 @@ ${OBJECTDIR}/_ext/1360937237/mouse.o: ../src/mouse.c  nbproject/Makefile-${CND_C
 	@${RM} ${OBJECTDIR}/_ext/1360937237/mouse.o 
 	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/mouse.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/mouse.o.d" -o ${OBJECTDIR}/_ext/1360937237/mouse.o ../src/mouse.c   
 	
+${OBJECTDIR}/_ext/1360937237/accel.o: ../src/accel.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/accel.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/accel.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/accel.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/accel.o.d" -o ${OBJECTDIR}/_ext/1360937237/accel.o ../src/accel.c   
+	
+${OBJECTDIR}/_ext/1360937237/spi_xfer.o: ../src/spi_xfer.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/spi_xfer.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/spi_xfer.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/spi_xfer.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/spi_xfer.o.d" -o ${OBJECTDIR}/_ext/1360937237/spi_xfer.o ../src/spi_xfer.c   
+	
+${OBJECTDIR}/_ext/1360937237/spsc_ring.o: ../src/spsc_ring.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/spsc_ring.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/spsc_ring.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/spsc_ring.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/spsc_ring.o.d" -o ${OBJECTDIR}/_ext/1360937237/spsc_ring.o ../src/spsc_ring.c   
+	
+${OBJECTDIR}/_ext/1360937237/motion.o: ../src/motion.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/motion.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/motion.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/motion.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/motion.o.d" -o ${OBJECTDIR}/_ext/1360937237/motion.o ../src/motion.c   
+	
+${OBJECTDIR}/_ext/1360937237/timebase.o: ../src/timebase.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/timebase.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/timebase.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/timebase.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/timebase.o.d" -o ${OBJECTDIR}/_ext/1360937237/timebase.o ../src/timebase.c   
+	
+${OBJECTDIR}/_ext/1360937237/timer_wheel.o: ../src/timer_wheel.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/timer_wheel.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/timer_wheel.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/timer_wheel.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/timer_wheel.o.d" -o ${OBJECTDIR}/_ext/1360937237/timer_wheel.o ../src/timer_wheel.c   
+	
+${OBJECTDIR}/_ext/1360937237/run_loop.o: ../src/run_loop.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/run_loop.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/run_loop.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/run_loop.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/run_loop.o.d" -o ${OBJECTDIR}/_ext/1360937237/run_loop.o ../src/run_loop.c   
+	
+${OBJECTDIR}/_ext/1360937237/profiler.o: ../src/profiler.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/profiler.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/profiler.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/profiler.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/profiler.o.d" -o ${OBJECTDIR}/_ext/1360937237/profiler.o ../src/profiler.c   
+	
+${OBJECTDIR}/_ext/1360937237/trace.o: ../src/trace.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/trace.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/trace.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/trace.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/trace.o.d" -o ${OBJECTDIR}/_ext/1360937237/trace.o ../src/trace.c   
+	
+${OBJECTDIR}/_ext/1360937237/capture.o: ../src/capture.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/capture.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/capture.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/capture.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/capture.o.d" -o ${OBJECTDIR}/_ext/1360937237/capture.o ../src/capture.c   
+	
+${OBJECTDIR}/_ext/1360937237/tilt.o: ../src/tilt.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tilt.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tilt.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/tilt.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/tilt.o.d" -o ${OBJECTDIR}/_ext/1360937237/tilt.o ../src/tilt.c   
+	
+${OBJECTDIR}/_ext/1360937237/decimator.o: ../src/decimator.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/decimator.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/decimator.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/decimator.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/decimator.o.d" -o ${OBJECTDIR}/_ext/1360937237/decimator.o ../src/decimator.c   
+	
+${OBJECTDIR}/_ext/1360937237/dsp.o: ../src/dsp.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/dsp.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/dsp.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/dsp.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/dsp.o.d" -o ${OBJECTDIR}/_ext/1360937237/dsp.o ../src/dsp.c   
+	
+${OBJECTDIR}/_ext/1360937237/report_pool.o: ../src/report_pool.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/report_pool.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/report_pool.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/report_pool.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/report_pool.o.d" -o ${OBJECTDIR}/_ext/1360937237/report_pool.o ../src/report_pool.c   
+	
+${OBJECTDIR}/_ext/1360937237/hid_idle.o: ../src/hid_idle.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/hid_idle.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/hid_idle.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/hid_idle.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -D__MPLAB_DEBUGGER_PK3=1 -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/hid_idle.o.d" -o ${OBJECTDIR}/_ext/1360937237/hid_idle.o ../src/hid_idle.c   
+	
 ${OBJECTDIR}/_ext/572315145/i2c_display.o: ../../../../../../../../../MPLABXProjects/HWone.X/i2c_display.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}/_ext/572315145" 
 	@${RM} ${OBJECTDIR}/_ext/572315145/i2c_display.o.d 
@@ -257,6 +347,96 @@ ${OBJECTDIR}/_ext/1360937237/mouse.o: ../src/mouse.c  nbproject/Makefile-${CND_C
 	@${RM} ${OBJECTDIR}/_ext/1360937237/mouse.o 
 	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/mouse.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/mouse.o.d" -o ${OBJECTDIR}/_ext/1360937237/mouse.o ../src/mouse.c   
 	
+${OBJECTDIR}/_ext/1360937237/accel.o: ../src/accel.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/accel.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/accel.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/accel.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/accel.o.d" -o ${OBJECTDIR}/_ext/1360937237/accel.o ../src/accel.c   
+	
+${OBJECTDIR}/_ext/1360937237/spi_xfer.o: ../src/spi_xfer.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/spi_xfer.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/spi_xfer.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/spi_xfer.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/spi_xfer.o.d" -o ${OBJECTDIR}/_ext/1360937237/spi_xfer.o ../src/spi_xfer.c   
+	
+${OBJECTDIR}/_ext/1360937237/spsc_ring.o: ../src/spsc_ring.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/spsc_ring.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/spsc_ring.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/spsc_ring.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/spsc_ring.o.d" -o ${OBJECTDIR}/_ext/1360937237/spsc_ring.o ../src/spsc_ring.c   
+	
+${OBJECTDIR}/_ext/1360937237/motion.o: ../src/motion.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/motion.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/motion.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/motion.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/motion.o.d" -o ${OBJECTDIR}/_ext/1360937237/motion.o ../src/motion.c   
+	
+${OBJECTDIR}/_ext/1360937237/timebase.o: ../src/timebase.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/timebase.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/timebase.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/timebase.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/timebase.o.d" -o ${OBJECTDIR}/_ext/1360937237/timebase.o ../src/timebase.c   
+	
+${OBJECTDIR}/_ext/1360937237/timer_wheel.o: ../src/timer_wheel.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/timer_wheel.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/timer_wheel.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/timer_wheel.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/timer_wheel.o.d" -o ${OBJECTDIR}/_ext/1360937237/timer_wheel.o ../src/timer_wheel.c   
+	
+${OBJECTDIR}/_ext/1360937237/run_loop.o: ../src/run_loop.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/run_loop.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/run_loop.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/run_loop.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/run_loop.o.d" -o ${OBJECTDIR}/_ext/1360937237/run_loop.o ../src/run_loop.c   
+	
+${OBJECTDIR}/_ext/1360937237/profiler.o: ../src/profiler.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/profiler.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/profiler.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/profiler.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/profiler.o.d" -o ${OBJECTDIR}/_ext/1360937237/profiler.o ../src/profiler.c   
+	
+${OBJECTDIR}/_ext/1360937237/trace.o: ../src/trace.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/trace.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/trace.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/trace.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/trace.o.d" -o ${OBJECTDIR}/_ext/1360937237/trace.o ../src/trace.c   
+	
+${OBJECTDIR}/_ext/1360937237/capture.o: ../src/capture.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/capture.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/capture.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/capture.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/capture.o.d" -o ${OBJECTDIR}/_ext/1360937237/capture.o ../src/capture.c   
+	
+${OBJECTDIR}/_ext/1360937237/tilt.o: ../src/tilt.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tilt.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tilt.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/tilt.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/tilt.o.d" -o ${OBJECTDIR}/_ext/1360937237/tilt.o ../src/tilt.c   
+	
+${OBJECTDIR}/_ext/1360937237/decimator.o: ../src/decimator.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/decimator.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/decimator.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/decimator.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/decimator.o.d" -o ${OBJECTDIR}/_ext/1360937237/decimator.o ../src/decimator.c   
+	
+${OBJECTDIR}/_ext/1360937237/dsp.o: ../src/dsp.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/dsp.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/dsp.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/dsp.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/dsp.o.d" -o ${OBJECTDIR}/_ext/1360937237/dsp.o ../src/dsp.c   
+	
+${OBJECTDIR}/_ext/1360937237/report_pool.o: ../src/report_pool.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/report_pool.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/report_pool.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/report_pool.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/report_pool.o.d" -o ${OBJECTDIR}/_ext/1360937237/report_pool.o ../src/report_pool.c   
+	
+${OBJECTDIR}/_ext/1360937237/hid_idle.o: ../src/hid_idle.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/hid_idle.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/hid_idle.o 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/hid_idle.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -O1 -I"../src" -I"../src/system_config" -I"../src/system_config/pic32mx_usb_sk2_int_dyn" -I"../../../../../../framework" -I"../../../../../../framework/system/common" -I"../../../../../../framework/system/devcon" -I"../../../../../../framework/system/int" -I"../../../../../../framework/system" -I"../../../../../../framework/driver/usb" -I"../../../../../../framework/usb" -I"../../../../../../bsp/pic32mx_usb_sk2" -MMD -MF "${OBJECTDIR}/_ext/1360937237/hid_idle.o.d" -o ${OBJECTDIR}/_ext/1360937237/hid_idle.o ../src/hid_idle.c   
+	
 ${OBJECTDIR}/_ext/572315145/i2c_display.o: ../../../../../../../../../MPLABXProjects/HWone.X/i2c_display.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}/_ext/572315145" 
 	@${RM} ${OBJECTDIR}/_ext/572315145/i2c_display.o.d 
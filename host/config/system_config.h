@@ -0,0 +1,148 @@
+/*******************************************************************************
+  Host System Configuration Header
+
+  File Name:
+    system_config.h
+
+  Summary:
+    Build-time configuration of the firmware built for the host.
+
+  Description:
+    Mirrors pic32mx_usb_sk2_int_dyn, the configuration the simulation stands
+    in for.  The options that tools/ and the simulator compare are wrapped
+    in #ifndef, so that host/CMakeLists.txt can build variants of it with
+    -D, and the host build points the waits of the firmware at the
+    simulated core.
+*******************************************************************************/
+
+#ifndef _SYSTEM_CONFIG_H
+#define _SYSTEM_CONFIG_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "bsp_config.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: System Service Configuration
+// *****************************************************************************
+// *****************************************************************************
+
+/* Clock System Service Configuration Options */
+#define SYS_CLK_FREQ                        80000000ul
+#define SYS_CLK_BUS_PERIPHERAL_1            80000000ul
+
+/* Interrupt System Service Configuration */
+#define SYS_INT                             true
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Middleware & Other Library Configuration
+// *****************************************************************************
+// *****************************************************************************
+
+/* Maximum device layer instances */
+#define USB_DEVICE_INSTANCES_NUMBER         1
+
+/* EP0 size in bytes */
+#ifndef USB_DEVICE_EP0_BUFFER_SIZE
+#define USB_DEVICE_EP0_BUFFER_SIZE          8
+#endif
+
+#define USB_DEVICE_SOF_EVENT_ENABLE
+
+/* Maximum instances of HID function driver */
+#define USB_DEVICE_HID_INSTANCES_NUMBER     1
+
+/* One receive plus the mouse report queue */
+#define USB_DEVICE_HID_QUEUE_DEPTH_COMBINED (1 + APP_REPORT_QUEUE_DEPTH)
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Configuration Specific Applicaton Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Switch debounce time in milliseconds */
+#define APP_USB_SWITCH_DEBOUNCE_COUNT       (160)
+
+#define MOUSE_HIGH_RESOLUTION               true
+
+#ifndef APP_REPORT_LEAD_US
+#define APP_REPORT_LEAD_US                  (150)
+#endif
+
+#ifndef APP_REPORT_QUEUE_DEPTH
+#define APP_REPORT_QUEUE_DEPTH              1
+#endif
+#define REPORT_POOL_BUFFERS                 APP_REPORT_QUEUE_DEPTH
+
+#ifndef RUN_LOOP_EVENT_DRIVEN
+#define RUN_LOOP_EVENT_DRIVEN               true
+#endif
+#define RUN_LOOP_ACCOUNTING                 true
+
+#define PROFILER_ENABLE                     true
+#define PROFILER_REPORT_ID                  2
+#define MOUSE_REPORT_ID                     1
+
+#define TRACE_ENABLE                        true
+#define TRACE_REPORT_ID                     3
+
+#define APP_STATS_ENABLE                    true
+#define APP_STATS_REPORT_ID                 4
+
+/* On here, unlike on the board: the replay tests read captures back */
+#ifndef CAPTURE_ENABLE
+#define CAPTURE_ENABLE                      true
+#endif
+#define CAPTURE_REPORT_ID                   5
+
+#ifndef DECIMATOR_ENABLE
+#define DECIMATOR_ENABLE                    true
+#endif
+
+#define ACC_ENABLE                          true
+
+#define APP_MAKE_BUFFER_DMA_READY
+
+#define APP_USB_LED_1                       BSP_LED_1
+#define APP_USB_LED_2                       BSP_LED_2
+#define APP_USB_LED_3                       BSP_LED_3
+#define APP_USB_SWITCH_1                    BSP_SWITCH_1
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Host Build
+// *****************************************************************************
+// *****************************************************************************
+
+/* The plain C kernels of dsp.c; tests build the others themselves */
+#ifndef DSP_ASE_ENABLE
+#define DSP_ASE_ENABLE                      false
+#endif
+
+/* WAIT sleeps on the simulated core */
+#define RUN_LOOP_WAIT()                     SIM_CORE_Wait()
+
+/* A blocking accelerometer register access polls for about a microsecond
+   per pass of its loop */
+#define ACC_TRANSFER_WAIT()                 SIM_CORE_Spend(80)
+
+/* The SPSC ring tests put the producer and the consumer on two threads of
+   the host, which may run on two cores */
+#define SPSC_RING_BARRIER()                 __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+#endif /* _SYSTEM_CONFIG_H */
+/*******************************************************************************
+ End of File
+ */
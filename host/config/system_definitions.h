@@ -0,0 +1,64 @@
+/*******************************************************************************
+  Host System Definitions
+
+  File Name:
+    system_definitions.h
+
+  Summary:
+    Harmony services and system objects of the host build.
+*******************************************************************************/
+
+#ifndef _SYS_DEFINITIONS_H
+#define _SYS_DEFINITIONS_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stddef.h>
+#include <xc.h>
+#include "system/common/sys_common.h"
+#include "system/common/sys_module.h"
+#include "system/clk/sys_clk.h"
+#include "system/devcon/sys_devcon.h"
+#include "system/int/sys_int.h"
+#include "system/ports/sys_ports.h"
+#include "usb/usb_device.h"
+#include "usb/usb_device_hid.h"
+#include "sim_core.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+typedef struct
+{
+    SYS_MODULE_OBJ  sysDevcon;
+    SYS_MODULE_OBJ  usbDevObject0;
+
+} SYSTEM_OBJECTS;
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: extern declarations
+// *****************************************************************************
+// *****************************************************************************
+
+extern SYSTEM_OBJECTS sysObj;
+
+extern const USB_DEVICE_FUNCTION_REGISTRATION_TABLE funcRegistrationTable[1];
+
+/* The interrupt handlers of system_interrupt.c, by vector */
+extern const SIM_CORE_VECTOR_TABLE sysVectors;
+
+#endif /* _SYS_DEFINITIONS_H */
+/*******************************************************************************
+ End of File
+ */
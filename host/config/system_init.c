@@ -0,0 +1,229 @@
+/*******************************************************************************
+  Host System Initialization File
+
+  File Name:
+    system_init.c
+
+  Summary:
+    Initializes the firmware on the simulated board.
+
+  Description:
+    Follows pic32mx_usb_sk2_int_dyn: the same report descriptor and HID
+    queue, the same interrupt priorities and the same initialization order.
+    The descriptors the simulated host does not read are left out.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "system_config.h"
+#include "system_definitions.h"
+#include "app.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Library/Stack Initialization Data
+// *****************************************************************************
+// *****************************************************************************
+
+/****************************************************
+ * Class specific descriptor - HID Report descriptor
+ ****************************************************/
+const uint8_t hid_rpt0[] =
+{
+    /* Generated from the report schema in mouse.h */
+    MOUSE_REPORT_DESCRIPTOR,
+#if PROFILER_ENABLE
+    PROFILER_REPORT_DESCRIPTOR,
+#endif
+#if TRACE_ENABLE
+    TRACE_REPORT_DESCRIPTOR,
+#endif
+#if APP_STATS_ENABLE
+    APP_STATS_REPORT_DESCRIPTOR,
+#endif
+#if CAPTURE_ENABLE
+    CAPTURE_REPORT_DESCRIPTOR,
+#endif
+};
+
+/**************************************************
+ * USB Device Function Driver Init Data
+ **************************************************/
+const USB_DEVICE_HID_INIT hidInit0 =
+{
+    .hidReportDescriptorSize = sizeof(hid_rpt0),
+    .hidReportDescriptor = &hid_rpt0,
+    .queueSizeReportReceive = 1,
+    .queueSizeReportSend = APP_REPORT_QUEUE_DEPTH
+};
+
+/**************************************************
+ * USB Device Layer Function Driver Registration
+ * Table
+ **************************************************/
+const USB_DEVICE_FUNCTION_REGISTRATION_TABLE funcRegistrationTable[1] =
+{
+    /* Function 1 */
+    {
+        .configurationValue = 1,    /* Configuration value */
+        .funcDriverIndex = 0,       /* Function driver index */
+        .interfaceNumber = 0,       /* First interfaceNumber of this function */
+        .numberOfInterfaces = 1,    /* Number of interfaces */
+        .speed = USB_SPEED_FULL,    /* Function Speed */
+        .driver = (void*)USB_DEVICE_HID_FUNCTION_DRIVER,    /* USB HID function data exposed to device layer */
+        .funcDriverInit = (void*)&hidInit0,    /* Function driver init data*/
+    },
+};
+
+/****************************************************
+ * USB Device Layer Initialization Data
+ ****************************************************/
+const USB_DEVICE_INIT usbDevInitData =
+{
+    /* System module initialization */
+    .moduleInit = {SYS_MODULE_POWER_RUN_FULL},
+
+    /* Identifies peripheral (PLIB-level) ID */
+    .usbID = USB_ID_1,
+
+    /* Interrupt Source for USB module */
+    .interruptSource = INT_SOURCE_USB_1,
+
+    /* Number of function drivers registered to this instance of the
+       USB device layer */
+    .registeredFuncCount = 1,
+
+    /* Function driver table registered to this instance of the USB device layer*/
+    .registeredFunctions = (USB_DEVICE_FUNCTION_REGISTRATION_TABLE*)funcRegistrationTable,
+
+    /* USB Device Speed */
+    .deviceSpeed = USB_SPEED_FULL,
+};
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: System Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* Structure to hold the object handles for the modules in the system. */
+SYSTEM_OBJECTS sysObj;
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Module Initialization Data
+// *****************************************************************************
+// *****************************************************************************
+
+/*** System Device Control Initialization Data ***/
+const SYS_DEVCON_INIT sysDevconInit =
+{
+    .moduleInit = {0},
+};
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: System Initialization
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void SYS_Initialize ( void *data )
+
+  Summary:
+    Initializes the board, services, drivers, application and other modules.
+
+  Remarks:
+    See prototype in system/common/sys_module.h.  The simulated core and
+    peripherals are reset by the caller.
+ */
+
+void SYS_Initialize ( void* data )
+{
+    /* The interrupt vectors, linked in on the device */
+    SIM_CORE_VectorsSet(sysVectors);
+
+    /* Core Processor Initialization */
+    SYS_CLK_Initialize( NULL );
+    sysObj.sysDevcon = SYS_DEVCON_Initialize(SYS_DEVCON_INDEX_0, (SYS_MODULE_INIT*)&sysDevconInit);
+    SYS_DEVCON_PerformanceConfig(SYS_CLK_SystemFrequencyGet());
+
+    /* Board Support Package Initialization */
+    BSP_Initialize();
+
+    /* System Services Initialization */
+    SYS_INT_Initialize();
+    SYS_PORTS_Initialize();
+
+    /* Initialize Drivers */
+    /* Set priority of SPI1 interrupt source */
+    SYS_INT_VectorPrioritySet(INT_VECTOR_SPI1, INT_PRIORITY_LEVEL3);
+    /* Set Sub-priority of SPI1 interrupt source */
+    SYS_INT_VectorSubprioritySet(INT_VECTOR_SPI1, INT_SUBPRIORITY_LEVEL0);
+
+    /* Set priority of the SPI1 receive DMA channel interrupt source */
+    SYS_INT_VectorPrioritySet(INT_VECTOR_DMA1, INT_PRIORITY_LEVEL3);
+    /* Set Sub-priority of the SPI1 receive DMA channel interrupt source */
+    SYS_INT_VectorSubprioritySet(INT_VECTOR_DMA1, INT_SUBPRIORITY_LEVEL0);
+
+    /* Set priority of the accelerometer FIFO watermark interrupt source.
+       Same level as SPI1 and DMA1, since it submits SPI1 transactions. */
+    SYS_INT_VectorPrioritySet(INT_VECTOR_INT2, INT_PRIORITY_LEVEL3);
+    /* Set Sub-priority of the accelerometer FIFO watermark interrupt source */
+    SYS_INT_VectorSubprioritySet(INT_VECTOR_INT2, INT_SUBPRIORITY_LEVEL0);
+
+    /* Route the LSM303D: chip select on RB4, deselected, SDI1 on RPB5,
+       SDO1 on RPB2 and its INT2 pin on RPB13 to INT2, rising edge */
+    LATBbits.LATB4 = 1;
+    TRISBbits.TRISB4 = 0;
+    SDI1Rbits.SDI1R = 0b0001;
+    RPB2Rbits.RPB2R = 0b0011;
+    ANSELBbits.ANSB13 = 0;
+    TRISBbits.TRISB13 = 1;
+    INT2Rbits.INT2R = 0b0011;
+    INTCONbits.INT2EP = 1;
+
+    /* Initialize the SPI1 transaction engine used by the accelerometer */
+    SPI_XFER_Initialize();
+
+    /* Initialize System Services */
+    /* Set priority of the core timer interrupt source. It only keeps the
+       timebase extension up to date, so it runs at the lowest level. */
+    SYS_INT_VectorPrioritySet(INT_VECTOR_CT, INT_PRIORITY_LEVEL1);
+    /* Set Sub-priority of the core timer interrupt source */
+    SYS_INT_VectorSubprioritySet(INT_VECTOR_CT, INT_SUBPRIORITY_LEVEL0);
+
+    /* Initialize the monotonic timebase, the software timers and the run
+       loop's accounting */
+    TIMEBASE_Initialize();
+    TIMER_WHEEL_Initialize();
+    RUN_LOOP_Initialize();
+
+    /* Initialize Middleware */
+    /* Set priority of USB interrupt source */
+    SYS_INT_VectorPrioritySet(INT_VECTOR_USB1, INT_PRIORITY_LEVEL4);
+    /* Set Sub-priority of USB interrupt source */
+    SYS_INT_VectorSubprioritySet(INT_VECTOR_USB1, INT_SUBPRIORITY_LEVEL0);
+
+    /* Initialize the USB device layer */
+    sysObj.usbDevObject0 = USB_DEVICE_Initialize (USB_DEVICE_INDEX_0 , ( SYS_MODULE_INIT* ) & usbDevInitData);
+
+    /* Enable Global Interrupts */
+    SYS_INT_Enable();
+
+    /* Initialize the Application */
+    APP_Initialize();
+}
+
+/*******************************************************************************
+ End of File
+*/
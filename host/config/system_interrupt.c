@@ -0,0 +1,74 @@
+/*******************************************************************************
+  Host System Interrupt Source File
+
+  File Name:
+    system_interrupt.c
+
+  Summary:
+    The interrupt handlers of pic32mx_usb_sk2_int_dyn, for the simulated
+    core.
+
+  Description:
+    The same handlers at the same priority levels (see system_init.c), in
+    a table the simulated core calls them through instead of __ISR vectors.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <xc.h>
+#include <sys/attribs.h>
+#include "app.h"
+#include "system_definitions.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: System Interrupt Vector Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void _IntHandlerUSBInstance0(void)
+{
+    USB_DEVICE_Tasks_ISR(sysObj.usbDevObject0);
+    RUN_LOOP_Post();
+}
+
+static void _IntHandlerSPI1(void)
+{
+    SPI_XFER_Tasks_ISR();
+}
+
+static void _IntHandlerSPI1_DMA(void)
+{
+    /* Completes the accelerometer bursts */
+    SPI_XFER_Tasks_ISR_DMA();
+    RUN_LOOP_Post();
+}
+
+static void _IntHandlerAccelINT2(void)
+{
+    acc_int_isr();
+}
+
+static void _IntHandlerCoreTimer(void)
+{
+    TIMEBASE_Tasks_ISR();
+    RUN_LOOP_Post();
+}
+
+const SIM_CORE_VECTOR_TABLE sysVectors =
+{
+    [INT_VECTOR_USB1] = _IntHandlerUSBInstance0,
+    [INT_VECTOR_SPI1] = _IntHandlerSPI1,
+    [INT_VECTOR_DMA1] = _IntHandlerSPI1_DMA,
+    [INT_VECTOR_INT2] = _IntHandlerAccelINT2,
+    [INT_VECTOR_CT] = _IntHandlerCoreTimer,
+};
+
+/*******************************************************************************
+ End of File
+ */
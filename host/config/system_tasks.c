@@ -0,0 +1,62 @@
+/*******************************************************************************
+  Host System Tasks File
+
+  File Name:
+    system_tasks.c
+
+  Summary:
+    SYS_Tasks of pic32mx_usb_sk2_int_dyn, unchanged, for the host build.
+ *******************************************************************************/
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "system_config.h"
+#include "system_definitions.h"
+#include "app.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: System "Tasks" Routine
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void SYS_Tasks ( void )
+
+  Remarks:
+    See prototype in system/common/sys_module.h.
+*/
+
+void SYS_Tasks ( void )
+{
+    /* Maintain the state machines of all library modules executing polled in
+    the system. */
+
+    /* Each call is timed by the profiler when it is enabled */
+
+    /* Maintain system services */
+    PROFILER_MEASURE(PROFILER_TASK_DEVCON, SYS_DEVCON_Tasks(sysObj.sysDevcon));
+    PROFILER_MEASURE(PROFILER_TASK_TIMER_WHEEL, TIMER_WHEEL_Tasks());
+
+    /* Maintain Device Drivers */
+
+    /* Maintain USB Stack */
+    /* Device layer tasks routine */ 
+    PROFILER_MEASURE(PROFILER_TASK_USB_DEVICE, USB_DEVICE_Tasks(sysObj.usbDevObject0));
+
+    /* Maintain the application's state machine. */
+    PROFILER_MEASURE(PROFILER_TASK_APP, APP_Tasks());
+}
+
+
+/*******************************************************************************
+ End of File
+ */
+
@@ -0,0 +1,39 @@
+/*******************************************************************************
+  Host Stand-in for the Board Support Package Header
+
+  Summary:
+    The starter kit's LEDs and switch.  The simulation holds their state,
+    see SIM_BOARD_SwitchSet().
+*******************************************************************************/
+
+#ifndef _BSP_CONFIG_H
+#define _BSP_CONFIG_H
+
+#include <stdbool.h>
+
+typedef enum
+{
+    BSP_LED_1 = 0,
+    BSP_LED_2,
+    BSP_LED_3
+} BSP_LED;
+
+typedef enum
+{
+    BSP_SWITCH_1 = 0,
+    BSP_SWITCH_2,
+    BSP_SWITCH_3
+} BSP_SWITCH;
+
+typedef enum
+{
+    BSP_SWITCH_STATE_PRESSED = 0,
+    BSP_SWITCH_STATE_RELEASED = 1
+} BSP_SWITCH_STATE;
+
+void BSP_Initialize ( void );
+void BSP_LEDOn ( BSP_LED led );
+void BSP_LEDOff ( BSP_LED led );
+BSP_SWITCH_STATE BSP_SwitchStateGet ( BSP_SWITCH bspSwitch );
+
+#endif /* _BSP_CONFIG_H */
@@ -0,0 +1,22 @@
+/*******************************************************************************
+  Host Stand-in for the Harmony Driver Common Header
+
+  Summary:
+    The open intent flags the firmware passes to the USB device layer.
+*******************************************************************************/
+
+#ifndef _DRIVER_COMMON_H
+#define _DRIVER_COMMON_H
+
+typedef enum
+{
+    DRV_IO_INTENT_READ = 1 << 0,
+    DRV_IO_INTENT_WRITE = 1 << 1,
+    DRV_IO_INTENT_READWRITE = DRV_IO_INTENT_READ | DRV_IO_INTENT_WRITE,
+    DRV_IO_INTENT_BLOCKING = 0,
+    DRV_IO_INTENT_NONBLOCKING = 1 << 2,
+    DRV_IO_INTENT_EXCLUSIVE = 1 << 3,
+    DRV_IO_INTENT_SHARED = 0
+} DRV_IO_INTENT;
+
+#endif /* _DRIVER_COMMON_H */
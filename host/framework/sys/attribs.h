@@ -0,0 +1,18 @@
+/*******************************************************************************
+  Host Stand-in for sys/attribs.h
+
+  Summary:
+    Interrupt handler attributes.
+
+  Description:
+    The host has no vectors.  host/config/system_interrupt.c hands its
+    handlers to the simulated interrupt controller instead, so __ISR() only
+    has to compile away.
+*******************************************************************************/
+
+#ifndef _SYS_ATTRIBS_H
+#define _SYS_ATTRIBS_H
+
+#define __ISR(vector, ...)
+
+#endif /* _SYS_ATTRIBS_H */
@@ -0,0 +1,20 @@
+/*******************************************************************************
+  Host Stand-in for sys/kmem.h
+
+  Summary:
+    Address translation for the DMA registers.
+
+  Description:
+    On the PIC32 the DMA controller takes physical addresses.  The host has
+    none, so the simulated DMA channels take the pointers as they are.
+*******************************************************************************/
+
+#ifndef _SYS_KMEM_H
+#define _SYS_KMEM_H
+
+#include <stdint.h>
+
+#define KVA_TO_PA(v)            ((uintptr_t)(v))
+#define PA_TO_KVA1(pa)          ((void *)(pa))
+
+#endif /* _SYS_KMEM_H */
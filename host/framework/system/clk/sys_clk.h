@@ -0,0 +1,17 @@
+/*******************************************************************************
+  Host Stand-in for the Harmony Clock System Service Header
+
+  Summary:
+    The clock service calls made by SYS_Initialize().  The simulated
+    system clock is SYS_CLK_FREQ of the system configuration.
+*******************************************************************************/
+
+#ifndef _SYS_CLK_H
+#define _SYS_CLK_H
+
+#include "system/common/sys_module.h"
+
+void SYS_CLK_Initialize ( const void * clkInit );
+uint32_t SYS_CLK_SystemFrequencyGet ( void );
+
+#endif /* _SYS_CLK_H */
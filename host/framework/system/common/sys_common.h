@@ -0,0 +1,16 @@
+/*******************************************************************************
+  Host Stand-in for the Harmony Common System Services Header
+
+  Summary:
+    Standard types every Harmony module builds on.
+*******************************************************************************/
+
+#ifndef _SYS_COMMON_H
+#define _SYS_COMMON_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#endif /* _SYS_COMMON_H */
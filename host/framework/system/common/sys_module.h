@@ -0,0 +1,37 @@
+/*******************************************************************************
+  Host Stand-in for the Harmony Module Interface Header
+
+  Summary:
+    Module objects and the system initialize and tasks routines.
+*******************************************************************************/
+
+#ifndef _SYS_MODULE_H
+#define _SYS_MODULE_H
+
+#include "system/common/sys_common.h"
+
+typedef uintptr_t SYS_MODULE_OBJ;
+typedef unsigned short int SYS_MODULE_INDEX;
+
+#define SYS_MODULE_OBJ_INVALID      ((SYS_MODULE_OBJ)-1)
+
+#define SYS_MODULE_POWER_OFF        0
+#define SYS_MODULE_POWER_SLEEP      1
+#define SYS_MODULE_POWER_IDLE_STOP  2
+#define SYS_MODULE_POWER_IDLE_RUN   3
+#define SYS_MODULE_POWER_RUN_FULL   4
+
+typedef union
+{
+    uint8_t value;
+    struct
+    {
+        uint8_t powerState : 4;
+        uint8_t reserved : 4;
+    } sys;
+} SYS_MODULE_INIT;
+
+void SYS_Initialize ( void * data );
+void SYS_Tasks ( void );
+
+#endif /* _SYS_MODULE_H */
@@ -0,0 +1,25 @@
+/*******************************************************************************
+  Host Stand-in for the Harmony Device Control System Service Header
+
+  Summary:
+    The device control service has nothing to do on the host.
+*******************************************************************************/
+
+#ifndef _SYS_DEVCON_H
+#define _SYS_DEVCON_H
+
+#include "system/common/sys_module.h"
+
+#define SYS_DEVCON_INDEX_0          0
+
+typedef struct
+{
+    SYS_MODULE_INIT moduleInit;
+} SYS_DEVCON_INIT;
+
+SYS_MODULE_OBJ SYS_DEVCON_Initialize ( const SYS_MODULE_INDEX index,
+                                       const SYS_MODULE_INIT * const init );
+void SYS_DEVCON_PerformanceConfig ( unsigned int sysclk );
+void SYS_DEVCON_Tasks ( SYS_MODULE_OBJ object );
+
+#endif /* _SYS_DEVCON_H */
@@ -0,0 +1,89 @@
+/*******************************************************************************
+  Host Stand-in for the Harmony Interrupt System Service Header
+
+  Summary:
+    Interrupt sources, vectors and priorities of the simulated interrupt
+    controller in sim_core.c.
+
+  Description:
+    The source and vector names are the PIC32MX ones the firmware uses.
+    Each source has its own vector here, and a vector runs while the core
+    is at a lower priority, as on the device.
+*******************************************************************************/
+
+#ifndef _SYS_INT_H
+#define _SYS_INT_H
+
+#include "system/common/sys_module.h"
+
+typedef enum
+{
+    INT_SOURCE_TIMER_CORE = 0,
+    INT_SOURCE_EXTERNAL_1,
+    INT_SOURCE_EXTERNAL_2,
+    INT_SOURCE_SPI_1_ERROR,
+    INT_SOURCE_SPI_1_RECEIVE,
+    INT_SOURCE_SPI_1_TRANSMIT,
+    INT_SOURCE_USB_1,
+    INT_SOURCE_DMA_0,
+    INT_SOURCE_DMA_1,
+
+    /* Number of sources */
+    INT_SOURCES_NUMBER
+
+} INT_SOURCE;
+
+typedef enum
+{
+    INT_VECTOR_CT = 0,
+    INT_VECTOR_INT1,
+    INT_VECTOR_INT2,
+    INT_VECTOR_SPI1,
+    INT_VECTOR_USB1,
+    INT_VECTOR_DMA0,
+    INT_VECTOR_DMA1,
+
+    /* Number of vectors */
+    INT_VECTORS_NUMBER
+
+} INT_VECTOR;
+
+typedef enum
+{
+    INT_DISABLE_INTERRUPT = 0,
+    INT_PRIORITY_LEVEL1,
+    INT_PRIORITY_LEVEL2,
+    INT_PRIORITY_LEVEL3,
+    INT_PRIORITY_LEVEL4,
+    INT_PRIORITY_LEVEL5,
+    INT_PRIORITY_LEVEL6,
+    INT_PRIORITY_LEVEL7
+} INT_PRIORITY_LEVEL;
+
+typedef enum
+{
+    INT_SUBPRIORITY_LEVEL0 = 0,
+    INT_SUBPRIORITY_LEVEL1,
+    INT_SUBPRIORITY_LEVEL2,
+    INT_SUBPRIORITY_LEVEL3
+} INT_SUBPRIORITY_LEVEL;
+
+void SYS_INT_Initialize ( void );
+void SYS_INT_Enable ( void );
+bool SYS_INT_Disable ( void );
+void SYS_INT_Restore ( bool state );
+bool SYS_INT_IsEnabled ( void );
+
+void SYS_INT_SourceEnable ( INT_SOURCE source );
+bool SYS_INT_SourceDisable ( INT_SOURCE source );
+bool SYS_INT_SourceIsEnabled ( INT_SOURCE source );
+bool SYS_INT_SourceStatusGet ( INT_SOURCE source );
+void SYS_INT_SourceStatusSet ( INT_SOURCE source );
+void SYS_INT_SourceStatusClear ( INT_SOURCE source );
+
+void SYS_INT_VectorPrioritySet ( INT_VECTOR vector, INT_PRIORITY_LEVEL priority );
+INT_PRIORITY_LEVEL SYS_INT_VectorPriorityGet ( INT_VECTOR vector );
+void SYS_INT_VectorSubprioritySet ( INT_VECTOR vector,
+                                    INT_SUBPRIORITY_LEVEL subpriority );
+
+#endif /* _SYS_INT_H */
@@ -0,0 +1,53 @@
+/*******************************************************************************
+  Host Stand-in for the Harmony Ports System Service Header
+
+  Summary:
+    Single pin access.  Port B drives the simulated accelerometer's chip
+    select, see sim_board.c.
+*******************************************************************************/
+
+#ifndef _SYS_PORTS_H
+#define _SYS_PORTS_H
+
+#include "system/common/sys_module.h"
+
+typedef enum
+{
+    PORTS_ID_0 = 0
+} PORTS_MODULE_ID;
+
+typedef enum
+{
+    PORT_CHANNEL_A = 0,
+    PORT_CHANNEL_B
+} PORTS_CHANNEL;
+
+typedef enum
+{
+    PORTS_BIT_POS_0 = 0,
+    PORTS_BIT_POS_1,
+    PORTS_BIT_POS_2,
+    PORTS_BIT_POS_3,
+    PORTS_BIT_POS_4,
+    PORTS_BIT_POS_5,
+    PORTS_BIT_POS_6,
+    PORTS_BIT_POS_7,
+    PORTS_BIT_POS_8,
+    PORTS_BIT_POS_9,
+    PORTS_BIT_POS_10,
+    PORTS_BIT_POS_11,
+    PORTS_BIT_POS_12,
+    PORTS_BIT_POS_13,
+    PORTS_BIT_POS_14,
+    PORTS_BIT_POS_15
+} PORTS_BIT_POS;
+
+void SYS_PORTS_Initialize ( void );
+void SYS_PORTS_PinSet ( PORTS_MODULE_ID index, PORTS_CHANNEL channel,
+                        PORTS_BIT_POS bitPos );
+void SYS_PORTS_PinClear ( PORTS_MODULE_ID index, PORTS_CHANNEL channel,
+                          PORTS_BIT_POS bitPos );
+bool SYS_PORTS_PinRead ( PORTS_MODULE_ID index, PORTS_CHANNEL channel,
+                         PORTS_BIT_POS bitPos );
+
+#endif /* _SYS_PORTS_H */
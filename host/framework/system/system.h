@@ -0,0 +1,14 @@
+/*******************************************************************************
+  Host Stand-in for the Harmony System Header
+
+  Summary:
+    Everything a module gets from including the system services.
+*******************************************************************************/
+
+#ifndef _SYSTEM_H
+#define _SYSTEM_H
+
+#include "system/common/sys_common.h"
+#include "system/common/sys_module.h"
+
+#endif /* _SYSTEM_H */
@@ -0,0 +1,23 @@
+/*******************************************************************************
+  Host Stand-in for the Harmony USB Chapter 9 Header
+
+  Summary:
+    Standard request and descriptor constants.  The simulated host does not
+    enumerate the device, so only what a configuration names is here.
+*******************************************************************************/
+
+#ifndef _USB_CHAPTER_9_H
+#define _USB_CHAPTER_9_H
+
+#include "usb/usb_common.h"
+
+#define USB_DESCRIPTOR_DEVICE           0x01
+#define USB_DESCRIPTOR_CONFIGURATION    0x02
+#define USB_DESCRIPTOR_STRING           0x03
+#define USB_DESCRIPTOR_INTERFACE        0x04
+#define USB_DESCRIPTOR_ENDPOINT         0x05
+
+#define USB_EP_DIRECTION_IN             0x80
+#define USB_TRANSFER_TYPE_INTERRUPT     0x03
+
+#endif /* _USB_CHAPTER_9_H */
@@ -0,0 +1,26 @@
+/*******************************************************************************
+  Host Stand-in for the Harmony USB Common Header
+
+  Summary:
+    Bus speeds and the USB module identifiers.
+*******************************************************************************/
+
+#ifndef _USB_COMMON_H
+#define _USB_COMMON_H
+
+#include "system/common/sys_common.h"
+
+typedef enum
+{
+    USB_SPEED_ERROR = 0,
+    USB_SPEED_HIGH,
+    USB_SPEED_FULL,
+    USB_SPEED_LOW
+} USB_SPEED;
+
+typedef enum
+{
+    USB_ID_1 = 0
+} USB_MODULE_ID;
+
+#endif /* _USB_COMMON_H */
@@ -0,0 +1,144 @@
+/*******************************************************************************
+  Host Stand-in for the Harmony USB Device Layer Header
+
+  Summary:
+    The device layer interface of Harmony v1 that the firmware uses.
+
+  Description:
+    Implemented by host/sim/sim_usb.c over a simulated host controller,
+    which enumerates the device, starts a frame every millisecond and polls
+    the interrupt IN endpoint.  Events reach the firmware's handlers from
+    the USB interrupt, as on the device.
+*******************************************************************************/
+
+#ifndef _USB_DEVICE_H
+#define _USB_DEVICE_H
+
+#include "system/common/sys_module.h"
+#include "system/int/sys_int.h"
+#include "driver/driver_common.h"
+#include "usb/usb_common.h"
+#include "usb/usb_chapter_9.h"
+
+#define USB_DEVICE_INDEX_0          0
+
+typedef uintptr_t USB_DEVICE_HANDLE;
+
+#define USB_DEVICE_HANDLE_INVALID   ((USB_DEVICE_HANDLE)(-1))
+
+typedef enum
+{
+    USB_DEVICE_EVENT_ERROR = 1,
+    USB_DEVICE_EVENT_RESET,
+    USB_DEVICE_EVENT_RESUMED,
+    USB_DEVICE_EVENT_SUSPENDED,
+    USB_DEVICE_EVENT_SOF,
+    USB_DEVICE_EVENT_POWER_DETECTED,
+    USB_DEVICE_EVENT_POWER_REMOVED,
+    USB_DEVICE_EVENT_CONFIGURED,
+    USB_DEVICE_EVENT_DECONFIGURED
+} USB_DEVICE_EVENT;
+
+typedef struct
+{
+    uint8_t configurationValue;
+} USB_DEVICE_EVENT_DATA_CONFIGURED;
+
+typedef struct
+{
+    uint16_t frameNumber;
+} USB_DEVICE_EVENT_DATA_SOF;
+
+typedef void (*USB_DEVICE_EVENT_HANDLER)
+(
+    USB_DEVICE_EVENT event,
+    void * eventData,
+    uintptr_t context
+);
+
+typedef enum
+{
+    USB_DEVICE_CONTROL_STATUS_OK,
+    USB_DEVICE_CONTROL_STATUS_ERROR
+} USB_DEVICE_CONTROL_STATUS;
+
+typedef enum
+{
+    USB_DEVICE_CONTROL_TRANSFER_RESULT_SUCCESS,
+    USB_DEVICE_CONTROL_TRANSFER_RESULT_FAILED
+} USB_DEVICE_CONTROL_TRANSFER_RESULT;
+
+// *****************************************************************************
+/* Function Driver Registration
+
+  Remarks:
+    driver points at the function driver's interface, which the simulation
+    only uses to find the HID instance, and funcDriverInit at its
+    initialization data.
+*/
+
+typedef struct
+{
+    uint8_t configurationValue;
+    uint8_t interfaceNumber;
+    uint8_t numberOfInterfaces;
+    USB_SPEED speed;
+    uint8_t funcDriverIndex;
+    void * driver;
+    void * funcDriverInit;
+} USB_DEVICE_FUNCTION_REGISTRATION_TABLE;
+
+typedef struct
+{
+    SYS_MODULE_INIT moduleInit;
+    USB_MODULE_ID usbID;
+    bool stopInIdle;
+    bool suspendInSleep;
+    INT_SOURCE interruptSource;
+    void * endpointTable;
+    uint16_t registeredFuncCount;
+    USB_DEVICE_FUNCTION_REGISTRATION_TABLE * registeredFunctions;
+    USB_SPEED deviceSpeed;
+} USB_DEVICE_INIT;
+
+SYS_MODULE_OBJ USB_DEVICE_Initialize ( const SYS_MODULE_INDEX index,
+                                       const SYS_MODULE_INIT * const init );
+
+void USB_DEVICE_Tasks ( SYS_MODULE_OBJ object );
+
+void USB_DEVICE_Tasks_ISR ( SYS_MODULE_OBJ object );
+
+USB_DEVICE_HANDLE USB_DEVICE_Open ( const SYS_MODULE_INDEX index,
+                                    const DRV_IO_INTENT intent );
+
+void USB_DEVICE_EventHandlerSet ( USB_DEVICE_HANDLE handle,
+                                  const USB_DEVICE_EVENT_HANDLER callBackFunc,
+                                  uintptr_t context );
+
+void USB_DEVICE_Attach ( USB_DEVICE_HANDLE handle );
+
+void USB_DEVICE_Detach ( USB_DEVICE_HANDLE handle );
+
+USB_SPEED USB_DEVICE_ActiveSpeedGet ( USB_DEVICE_HANDLE handle );
+
+USB_DEVICE_CONTROL_TRANSFER_RESULT USB_DEVICE_ControlSend
+(
+    USB_DEVICE_HANDLE handle,
+    void * data,
+    size_t length
+);
+
+USB_DEVICE_CONTROL_TRANSFER_RESULT USB_DEVICE_ControlReceive
+(
+    USB_DEVICE_HANDLE handle,
+    void * data,
+    size_t length
+);
+
+USB_DEVICE_CONTROL_TRANSFER_RESULT USB_DEVICE_ControlStatus
+(
+    USB_DEVICE_HANDLE handle,
+    USB_DEVICE_CONTROL_STATUS status
+);
+
+#endif /* _USB_DEVICE_H */
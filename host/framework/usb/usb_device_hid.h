@@ -0,0 +1,123 @@
+/*******************************************************************************
+  Host Stand-in for the Harmony USB HID Function Driver Header
+
+  Summary:
+    The HID function driver interface of Harmony v1 that the firmware uses.
+
+  Description:
+    Implemented by host/sim/sim_usb.c.  As in Harmony, a transfer handle
+    is the address of the queue slot that holds the report, so the same
+    handle comes back once its slot is free again.
+*******************************************************************************/
+
+#ifndef _USB_DEVICE_HID_H
+#define _USB_DEVICE_HID_H
+
+#include "usb/usb_device.h"
+
+#define USB_HID_CLASS_CODE                              0x03
+#define USB_HID_SUBCLASS_CODE_BOOT_INTERFACE_SUBCLASS   0x01
+#define USB_HID_PROTOCOL_CODE_MOUSE                     0x02
+#define USB_HID_DESCRIPTOR_TYPES_HID                    0x21
+#define USB_HID_DESCRIPTOR_TYPES_REPORT                 0x22
+
+typedef uint8_t USB_HID_PROTOCOL_CODE;
+
+typedef enum
+{
+    USB_HID_REPORT_TYPE_INPUT = 1,
+    USB_HID_REPORT_TYPE_OUTPUT,
+    USB_HID_REPORT_TYPE_FEATURE
+} USB_HID_REPORT_TYPE;
+
+typedef uintptr_t USB_DEVICE_HID_INDEX;
+
+typedef uintptr_t USB_DEVICE_HID_TRANSFER_HANDLE;
+
+#define USB_DEVICE_HID_TRANSFER_HANDLE_INVALID  ((USB_DEVICE_HID_TRANSFER_HANDLE)(-1))
+
+typedef enum
+{
+    USB_DEVICE_HID_RESULT_OK,
+    USB_DEVICE_HID_RESULT_ERROR_TRANSFER_QUEUE_FULL,
+    USB_DEVICE_HID_RESULT_ERROR_INSTANCE_INVALID,
+    USB_DEVICE_HID_RESULT_ERROR_PARAMETER_INVALID,
+    USB_DEVICE_HID_RESULT_ERROR_INSTANCE_NOT_CONFIGURED,
+    USB_DEVICE_HID_RESULT_ERROR
+} USB_DEVICE_HID_RESULT;
+
+typedef enum
+{
+    USB_DEVICE_HID_EVENT_GET_REPORT,
+    USB_DEVICE_HID_EVENT_GET_IDLE,
+    USB_DEVICE_HID_EVENT_GET_PROTOCOL,
+    USB_DEVICE_HID_EVENT_SET_REPORT,
+    USB_DEVICE_HID_EVENT_SET_IDLE,
+    USB_DEVICE_HID_EVENT_SET_PROTOCOL,
+    USB_DEVICE_HID_EVENT_REPORT_SENT,
+    USB_DEVICE_HID_EVENT_REPORT_RECEIVED,
+    USB_DEVICE_HID_EVENT_CONTROL_TRANSFER_DATA_RECEIVED,
+    USB_DEVICE_HID_EVENT_CONTROL_TRANSFER_DATA_SENT
+} USB_DEVICE_HID_EVENT;
+
+typedef struct
+{
+    USB_DEVICE_HID_TRANSFER_HANDLE handle;
+    size_t length;
+} USB_DEVICE_HID_EVENT_DATA_REPORT_SENT;
+
+typedef struct
+{
+    uint8_t duration;
+    uint8_t reportID;
+} USB_DEVICE_HID_EVENT_DATA_SET_IDLE;
+
+typedef struct
+{
+    uint8_t reportID;
+} USB_DEVICE_HID_EVENT_DATA_GET_IDLE;
+
+typedef struct
+{
+    uint8_t reportType;
+    uint8_t reportID;
+    uint16_t reportLength;
+} USB_DEVICE_HID_EVENT_DATA_GET_REPORT;
+
+typedef void (*USB_DEVICE_HID_EVENT_HANDLER)
+(
+    USB_DEVICE_HID_INDEX instanceIndex,
+    USB_DEVICE_HID_EVENT event,
+    void * eventData,
+    uintptr_t userData
+);
+
+typedef struct
+{
+    size_t hidReportDescriptorSize;
+    const void * hidReportDescriptor;
+    size_t queueSizeReportReceive;
+    size_t queueSizeReportSend;
+} USB_DEVICE_HID_INIT;
+
+/* Only compared against in the registration table */
+extern const int usbDeviceHIDFunctionDriver;
+
+#define USB_DEVICE_HID_FUNCTION_DRIVER  (&usbDeviceHIDFunctionDriver)
+
+USB_DEVICE_HID_RESULT USB_DEVICE_HID_EventHandlerSet
+(
+    USB_DEVICE_HID_INDEX instanceIndex,
+    USB_DEVICE_HID_EVENT_HANDLER eventHandler,
+    uintptr_t context
+);
+
+USB_DEVICE_HID_RESULT USB_DEVICE_HID_ReportSend
+(
+    USB_DEVICE_HID_INDEX instanceIndex,
+    USB_DEVICE_HID_TRANSFER_HANDLE * transferHandle,
+    uint8_t * buffer,
+    size_t size
+);
+
+#endif /* _USB_DEVICE_HID_H */
@@ -0,0 +1,294 @@
+/*******************************************************************************
+  Host Stand-in for the XC32 Device Header
+
+  File Name:
+    xc.h
+
+  Summary:
+    The PIC32MX250F128B special function registers the firmware touches.
+
+  Description:
+    Each register is a plain variable, and its "bits" view is a bit field
+    union laid over the same word, with the fields where the data sheet
+    puts them.  The simulated peripherals in host/sim watch the variables
+    (sim_spi.c for SPI1 and the DMA channels, sim_board.c for the ports)
+    and the core timer coprocessor registers go to the simulated core.
+
+    Only what the firmware uses is declared.  A register it starts using
+    has to be added here before the host build compiles again.
+*******************************************************************************/
+
+#ifndef _XC_H
+#define _XC_H
+
+#include <stdint.h>
+#include "sim_core.h"
+
+#define __HOST_SFR(name)        extern volatile uint32_t name
+#define __HOST_SFR_BITS(name)   (*(volatile __##name##bits_t *)&name)
+
+/* Core timer, coprocessor 0 Count and Compare */
+#define _CP0_GET_COUNT()        SIM_CORE_CountGet()
+#define _CP0_SET_COMPARE(value) SIM_CORE_CompareSet(value)
+
+/* Interrupt request numbers used as DMA start events */
+#define _SPI1_RX_IRQ            36
+#define _SPI1_TX_IRQ            37
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: SPI1
+// *****************************************************************************
+// *****************************************************************************
+
+typedef union
+{
+    struct
+    {
+        unsigned SRXISEL:2;
+        unsigned STXISEL:2;
+        unsigned DISSDI:1;
+        unsigned MSTEN:1;
+        unsigned CKP:1;
+        unsigned SSEN:1;
+        unsigned CKE:1;
+        unsigned SMP:1;
+        unsigned MODE16:1;
+        unsigned MODE32:1;
+        unsigned DISSDO:1;
+        unsigned SIDL:1;
+        unsigned :1;
+        unsigned ON:1;
+        unsigned ENHBUF:1;
+        unsigned SPIFE:1;
+        unsigned :5;
+        unsigned MCLKSEL:1;
+        unsigned FRMCNT:3;
+        unsigned FRMSYPW:1;
+        unsigned MSSEN:1;
+        unsigned FRMPOL:1;
+        unsigned FRMSYNC:1;
+        unsigned FRMEN:1;
+    };
+    uint32_t w;
+} __SPI1CONbits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned SPIRBF:1;
+        unsigned SPITBF:1;
+        unsigned :1;
+        unsigned SPITBE:1;
+        unsigned :1;
+        unsigned SPIRBE:1;
+        unsigned SPIROV:1;
+        unsigned SRMT:1;
+        unsigned SPITUR:1;
+        unsigned :2;
+        unsigned SPIBUSY:1;
+        unsigned FRMERR:1;
+        unsigned :3;
+        unsigned TXBUFELM:5;
+        unsigned :3;
+        unsigned RXBUFELM:5;
+    };
+    uint32_t w;
+} __SPI1STATbits_t;
+
+__HOST_SFR(SPI1CON);
+__HOST_SFR(SPI1STAT);
+__HOST_SFR(SPI1BRG);
+__HOST_SFR(SPI1CON2);
+
+/* Reads return the last byte received.  sim_spi.c leaves bit 8 set behind
+   every byte it delivers, so that it can tell the firmware's next write,
+   always a byte, from it. */
+__HOST_SFR(SPI1BUF);
+
+#define SPI1CONbits             __HOST_SFR_BITS(SPI1CON)
+#define SPI1STATbits            __HOST_SFR_BITS(SPI1STAT)
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: DMA Controller, Channels 0 and 1
+// *****************************************************************************
+// *****************************************************************************
+
+typedef union
+{
+    struct
+    {
+        unsigned :11;
+        unsigned DMABUSY:1;
+        unsigned SUSPEND:1;
+        unsigned :2;
+        unsigned ON:1;
+    };
+    uint32_t w;
+} __DMACONbits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned CHPRI:2;
+        unsigned CHEDET:1;
+        unsigned :1;
+        unsigned CHAEN:1;
+        unsigned CHCHN:1;
+        unsigned CHAED:1;
+        unsigned CHEN:1;
+        unsigned CHCHNS:1;
+        unsigned :6;
+        unsigned CHBUSY:1;
+    };
+    uint32_t w;
+} __DCHxCONbits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned :3;
+        unsigned AIRQEN:1;
+        unsigned SIRQEN:1;
+        unsigned PATEN:1;
+        unsigned CABORT:1;
+        unsigned CFORCE:1;
+        unsigned CHSIRQ:8;
+        unsigned CHAIRQ:8;
+    };
+    uint32_t w;
+} __DCHxECONbits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned CHERIF:1;
+        unsigned CHTAIF:1;
+        unsigned CHCCIF:1;
+        unsigned CHBCIF:1;
+        unsigned CHDHIF:1;
+        unsigned CHDDIF:1;
+        unsigned CHSHIF:1;
+        unsigned CHSDIF:1;
+        unsigned :8;
+        unsigned CHERIE:1;
+        unsigned CHTAIE:1;
+        unsigned CHCCIE:1;
+        unsigned CHBCIE:1;
+        unsigned CHDHIE:1;
+        unsigned CHDDIE:1;
+        unsigned CHSHIE:1;
+        unsigned CHSDIE:1;
+    };
+    uint32_t w;
+} __DCHxINTbits_t;
+
+typedef __DCHxCONbits_t __DCH0CONbits_t;
+typedef __DCHxCONbits_t __DCH1CONbits_t;
+typedef __DCHxECONbits_t __DCH0ECONbits_t;
+typedef __DCHxECONbits_t __DCH1ECONbits_t;
+typedef __DCHxINTbits_t __DCH0INTbits_t;
+typedef __DCHxINTbits_t __DCH1INTbits_t;
+
+__HOST_SFR(DMACON);
+
+/* The address registers hold host pointers, see sys/kmem.h */
+#define __HOST_DMA_CHANNEL(n)                                                 \
+    __HOST_SFR(DCH##n##CON);                                                  \
+    __HOST_SFR(DCH##n##ECON);                                                 \
+    __HOST_SFR(DCH##n##INT);                                                  \
+    __HOST_SFR(DCH##n##INTCLR);                                               \
+    extern volatile uintptr_t DCH##n##SSA;                                    \
+    extern volatile uintptr_t DCH##n##DSA;                                    \
+    __HOST_SFR(DCH##n##SSIZ);                                                 \
+    __HOST_SFR(DCH##n##DSIZ);                                                 \
+    __HOST_SFR(DCH##n##CSIZ)
+
+__HOST_DMA_CHANNEL(0);
+__HOST_DMA_CHANNEL(1);
+
+#define DMACONbits              __HOST_SFR_BITS(DMACON)
+#define DCH0CONbits             __HOST_SFR_BITS(DCH0CON)
+#define DCH0ECONbits            __HOST_SFR_BITS(DCH0ECON)
+#define DCH0INTbits             __HOST_SFR_BITS(DCH0INT)
+#define DCH1CONbits             __HOST_SFR_BITS(DCH1CON)
+#define DCH1ECONbits            __HOST_SFR_BITS(DCH1ECON)
+#define DCH1INTbits             __HOST_SFR_BITS(DCH1INT)
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Port B, Peripheral Pin Select and External Interrupts
+// *****************************************************************************
+// *****************************************************************************
+
+#define __HOST_PORT_BITS(prefix)                                              \
+    struct                                                                    \
+    {                                                                         \
+        unsigned prefix##0:1;  unsigned prefix##1:1;                          \
+        unsigned prefix##2:1;  unsigned prefix##3:1;                          \
+        unsigned prefix##4:1;  unsigned prefix##5:1;                          \
+        unsigned prefix##6:1;  unsigned prefix##7:1;                          \
+        unsigned prefix##8:1;  unsigned prefix##9:1;                          \
+        unsigned prefix##10:1; unsigned prefix##11:1;                         \
+        unsigned prefix##12:1; unsigned prefix##13:1;                         \
+        unsigned prefix##14:1; unsigned prefix##15:1;                         \
+    }
+
+typedef union { __HOST_PORT_BITS(LATB); uint32_t w; } __LATBbits_t;
+typedef union { __HOST_PORT_BITS(TRISB); uint32_t w; } __TRISBbits_t;
+typedef union { __HOST_PORT_BITS(RB); uint32_t w; } __PORTBbits_t;
+typedef union { __HOST_PORT_BITS(ANSB); uint32_t w; } __ANSELBbits_t;
+
+typedef union { struct { unsigned SDI1R:4; }; uint32_t w; } __SDI1Rbits_t;
+typedef union { struct { unsigned RPB2R:4; }; uint32_t w; } __RPB2Rbits_t;
+typedef union { struct { unsigned INT2R:4; }; uint32_t w; } __INT2Rbits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned INT0EP:1;
+        unsigned INT1EP:1;
+        unsigned INT2EP:1;
+        unsigned INT3EP:1;
+        unsigned INT4EP:1;
+        unsigned :3;
+        unsigned TPC:3;
+        unsigned :1;
+        unsigned MVEC:1;
+        unsigned :3;
+        unsigned SS0:1;
+    };
+    uint32_t w;
+} __INTCONbits_t;
+
+__HOST_SFR(LATB);
+__HOST_SFR(TRISB);
+__HOST_SFR(PORTB);
+__HOST_SFR(ANSELB);
+__HOST_SFR(SDI1R);
+__HOST_SFR(RPB2R);
+__HOST_SFR(INT2R);
+__HOST_SFR(INTCON);
+
+#define LATBbits                __HOST_SFR_BITS(LATB)
+#define TRISBbits               __HOST_SFR_BITS(TRISB)
+#define PORTBbits               __HOST_SFR_BITS(PORTB)
+#define ANSELBbits              __HOST_SFR_BITS(ANSELB)
+#define SDI1Rbits               __HOST_SFR_BITS(SDI1R)
+#define RPB2Rbits               __HOST_SFR_BITS(RPB2R)
+#define INT2Rbits               __HOST_SFR_BITS(INT2R)
+#define INTCONbits              __HOST_SFR_BITS(INTCON)
+
+#endif /* _XC_H */
+/*******************************************************************************
+ End of File
+ */
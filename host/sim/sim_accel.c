@@ -0,0 +1,405 @@
+/*******************************************************************************
+  Simulated LSM303D Accelerometer
+
+  File Name:
+    sim_accel.c
+
+  Summary:
+    The accelerometer half of an LSM303D on SPI1, chip select on RB4 and
+    INT2 on RB13.
+
+  Description:
+    See sim_accel.h.  The register map is the data sheet's, kept apart from
+    the firmware's accel.h so that a wrong constant there is not agreed
+    with here.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <xc.h>
+#include <stddef.h>
+#include "system_config.h"
+#include "sim_core.h"
+#include "sim_spi.h"
+#include "sim_accel.h"
+
+#define LSM303D_WHO_AM_I        0x0F
+#define LSM303D_CTRL0           0x1F
+#define LSM303D_CTRL1           0x20
+#define LSM303D_CTRL4           0x23
+#define LSM303D_OUT_X_L_A       0x28
+#define LSM303D_OUT_Z_H_A       0x2D
+#define LSM303D_FIFO_CTRL       0x2E
+#define LSM303D_FIFO_SRC        0x2F
+
+#define LSM303D_ID              0x49
+#define LSM303D_READ            0x80
+#define LSM303D_AUTOINC         0x40
+#define LSM303D_ADDRESS         0x3F
+
+#define LSM303D_CTRL0_FIFO_EN   0x40
+#define LSM303D_CTRL0_FTH_EN    0x20
+#define LSM303D_CTRL4_INT2_FTH  0x01
+#define LSM303D_FIFO_MODE_MASK  0xE0
+#define LSM303D_FIFO_STREAM     0x40
+#define LSM303D_FIFO_FTH_MASK   0x1F
+#define LSM303D_FIFO_DEPTH      32
+
+#define LSM303D_SRC_FTH         0x80
+#define LSM303D_SRC_OVRN        0x40
+#define LSM303D_SRC_EMPTY       0x20
+
+/* Chip select and INT2 */
+#define SIM_ACCEL_CS_BIT        (1u << 4)
+#define SIM_ACCEL_INT2_BIT      (1u << 13)
+
+static struct
+{
+    SIM_ACCEL_SOURCE source;
+    uintptr_t context;
+    SIM_EVENT sampleEvent;
+
+    uint8_t registers[0x40];
+
+    /* FIFO, oldest at head */
+    SIM_ACCEL_SAMPLE fifo[LSM303D_FIFO_DEPTH];
+    SIM_TIME fifoTime[LSM303D_FIFO_DEPTH];
+    unsigned int head;
+    unsigned int count;
+    bool overrun;
+
+    /* Output registers with the FIFO off */
+    SIM_ACCEL_SAMPLE latest;
+    SIM_TIME latestTime;
+
+    /* SPI transaction in progress */
+    bool selected;
+    bool haveCommand;
+    bool read;
+    bool autoIncrement;
+    uint8_t address;
+
+    bool int2;
+
+    SIM_ACCEL_STATS stats;
+
+} simAccel;
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static bool _SIM_ACCEL_FifoEnabled ( void )
+{
+    return (simAccel.registers[LSM303D_CTRL0] & LSM303D_CTRL0_FIFO_EN) != 0;
+}
+
+static unsigned int _SIM_ACCEL_Threshold ( void )
+{
+    return simAccel.registers[LSM303D_FIFO_CTRL] & LSM303D_FIFO_FTH_MASK;
+}
+
+static unsigned int _SIM_ACCEL_Depth ( void )
+{
+    unsigned int threshold = _SIM_ACCEL_Threshold();
+
+    if((simAccel.registers[LSM303D_CTRL0] & LSM303D_CTRL0_FTH_EN) && (threshold > 0))
+    {
+        return threshold;
+    }
+    return LSM303D_FIFO_DEPTH;
+}
+
+static void _SIM_ACCEL_Int2Update ( void )
+{
+    unsigned int threshold = _SIM_ACCEL_Threshold();
+    bool level = (simAccel.registers[LSM303D_CTRL4] & LSM303D_CTRL4_INT2_FTH) &&
+                 _SIM_ACCEL_FifoEnabled() && (threshold > 0) &&
+                 (simAccel.count >= threshold);
+
+    if(level)
+    {
+        PORTB |= SIM_ACCEL_INT2_BIT;
+    }
+    else
+    {
+        PORTB &= ~SIM_ACCEL_INT2_BIT;
+    }
+
+    /* External interrupt 2 on the edge INTCON selects */
+    if((level != simAccel.int2) && (level == (INTCONbits.INT2EP != 0)))
+    {
+        SIM_CORE_InterruptRequest(INT_SOURCE_EXTERNAL_2);
+    }
+    simAccel.int2 = level;
+}
+
+static SIM_TIME _SIM_ACCEL_Period ( void )
+{
+    /* AODR in CTRL1: 1 is 3.125 Hz, each step doubles it up to 10, 1600 Hz */
+    unsigned int odr = simAccel.registers[LSM303D_CTRL1] >> 4;
+
+    if((odr == 0) || (odr > 10))
+    {
+        return 0;
+    }
+    return (SIM_TICKS_PER_SECOND * 8) / (25u << (odr - 1));
+}
+
+static void _SIM_ACCEL_Sample ( uintptr_t context )
+{
+    SIM_ACCEL_SAMPLE sample;
+    SIM_TIME interval = _SIM_ACCEL_Period();
+    SIM_TIME now = SIM_CORE_Now();
+
+    if(interval == 0)
+    {
+        return;
+    }
+    if(simAccel.source == NULL)
+    {
+        /* Lying flat, 1 g on Z at +/-2 g full scale */
+        sample.x = 0;
+        sample.y = 0;
+        sample.z = 16384;
+    }
+    else if(!simAccel.source(simAccel.context, &sample, &interval))
+    {
+        return;
+    }
+    simAccel.stats.produced ++;
+    simAccel.latest = sample;
+    simAccel.latestTime = now;
+
+    if(_SIM_ACCEL_FifoEnabled())
+    {
+        unsigned int depth = _SIM_ACCEL_Depth();
+        unsigned int tail;
+
+        if(simAccel.count >= depth)
+        {
+            /* Only stream mode is modelled: the oldest one goes */
+            simAccel.head = (simAccel.head + 1) % LSM303D_FIFO_DEPTH;
+            simAccel.count --;
+            simAccel.overrun = true;
+            simAccel.stats.overwritten ++;
+        }
+        tail = (simAccel.head + simAccel.count) % LSM303D_FIFO_DEPTH;
+        simAccel.fifo[tail] = sample;
+        simAccel.fifoTime[tail] = now;
+        simAccel.count ++;
+        _SIM_ACCEL_Int2Update();
+    }
+
+    SIM_CORE_EventSchedule(&simAccel.sampleEvent, now + interval,
+            _SIM_ACCEL_Sample, 0);
+}
+
+static uint8_t _SIM_ACCEL_OutputRead ( uint8_t address )
+{
+    const SIM_ACCEL_SAMPLE * sample = &simAccel.latest;
+    SIM_TIME time = simAccel.latestTime;
+    int16_t value;
+    bool fifo = _SIM_ACCEL_FifoEnabled() && (simAccel.count > 0);
+
+    if(fifo)
+    {
+        sample = &simAccel.fifo[simAccel.head];
+        time = simAccel.fifoTime[simAccel.head];
+    }
+
+    switch((address - LSM303D_OUT_X_L_A) / 2)
+    {
+        case 0:
+            value = sample->x;
+            break;
+        case 1:
+            value = sample->y;
+            break;
+        default:
+            value = sample->z;
+            break;
+    }
+
+    if(address == LSM303D_OUT_Z_H_A)
+    {
+        simAccel.stats.read ++;
+        simAccel.stats.readNewestTime = time;
+        if(_SIM_ACCEL_FifoEnabled() && !fifo)
+        {
+            simAccel.stats.readEmpty ++;
+        }
+        if(fifo)
+        {
+            simAccel.head = (simAccel.head + 1) % LSM303D_FIFO_DEPTH;
+            simAccel.count --;
+            simAccel.overrun = false;
+            _SIM_ACCEL_Int2Update();
+        }
+    }
+
+    return (address & 1) ? (uint8_t)((uint16_t)value >> 8) : (uint8_t)value;
+}
+
+static uint8_t _SIM_ACCEL_RegisterRead ( uint8_t address )
+{
+    if((address >= LSM303D_OUT_X_L_A) && (address <= LSM303D_OUT_Z_H_A))
+    {
+        return _SIM_ACCEL_OutputRead(address);
+    }
+
+    switch(address)
+    {
+        case LSM303D_WHO_AM_I:
+            return LSM303D_ID;
+
+        case LSM303D_FIFO_SRC:
+            return ((simAccel.count >= _SIM_ACCEL_Threshold()) ? LSM303D_SRC_FTH : 0) |
+                   (simAccel.overrun ? LSM303D_SRC_OVRN : 0) |
+                   ((simAccel.count == 0) ? LSM303D_SRC_EMPTY : 0) |
+                   (simAccel.count & 0x1F);
+
+        default:
+            return simAccel.registers[address];
+    }
+}
+
+static void _SIM_ACCEL_RegisterWrite ( uint8_t address, uint8_t value )
+{
+    bool wasRunning = (_SIM_ACCEL_Period() != 0);
+
+    if(((address < LSM303D_CTRL0) || (address > LSM303D_OUT_X_L_A - 1)) &&
+       (address != LSM303D_FIFO_CTRL))
+    {
+        /* Read-only or not modelled */
+        return;
+    }
+    simAccel.registers[address] = value;
+
+    if((address == LSM303D_CTRL0) && !_SIM_ACCEL_FifoEnabled())
+    {
+        simAccel.count = 0;
+        simAccel.overrun = false;
+    }
+    if((address == LSM303D_FIFO_CTRL) &&
+       ((value & LSM303D_FIFO_MODE_MASK) != LSM303D_FIFO_STREAM))
+    {
+        /* Bypass mode empties the FIFO; the other modes are not modelled */
+        simAccel.count = 0;
+        simAccel.overrun = false;
+    }
+    if((address == LSM303D_CTRL1) && !wasRunning && (_SIM_ACCEL_Period() != 0))
+    {
+        SIM_CORE_EventSchedule(&simAccel.sampleEvent,
+                SIM_CORE_Now() + _SIM_ACCEL_Period(), _SIM_ACCEL_Sample, 0);
+    }
+    _SIM_ACCEL_Int2Update();
+}
+
+static uint8_t _SIM_ACCEL_AddressNext ( uint8_t address )
+{
+    if(_SIM_ACCEL_FifoEnabled() && (address == LSM303D_OUT_Z_H_A))
+    {
+        return LSM303D_OUT_X_L_A;
+    }
+    return (address + 1) & LSM303D_ADDRESS;
+}
+
+static uint8_t _SIM_ACCEL_Exchange ( uint8_t mosi )
+{
+    uint8_t miso = 0;
+
+    if(!simAccel.selected)
+    {
+        /* SDO is high impedance, the pull-up wins */
+        return 0xFF;
+    }
+
+    if(!simAccel.haveCommand)
+    {
+        simAccel.haveCommand = true;
+        simAccel.read = (mosi & LSM303D_READ) != 0;
+        simAccel.autoIncrement = (mosi & LSM303D_AUTOINC) != 0;
+        simAccel.address = mosi & LSM303D_ADDRESS;
+        return 0;
+    }
+
+    if(simAccel.read)
+    {
+        miso = _SIM_ACCEL_RegisterRead(simAccel.address);
+    }
+    else
+    {
+        _SIM_ACCEL_RegisterWrite(simAccel.address, mosi);
+    }
+    if(simAccel.autoIncrement)
+    {
+        simAccel.address = _SIM_ACCEL_AddressNext(simAccel.address);
+    }
+    return miso;
+}
+
+static void _SIM_ACCEL_Sync ( void )
+{
+    bool selected = !(LATB & SIM_ACCEL_CS_BIT);
+
+    if(selected && !simAccel.selected)
+    {
+        simAccel.haveCommand = false;
+    }
+    simAccel.selected = selected;
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Simulation Control
+// *****************************************************************************
+// *****************************************************************************
+
+void SIM_ACCEL_Reset ( SIM_ACCEL_SOURCE source, uintptr_t context )
+{
+    unsigned int index;
+
+    simAccel.source = source;
+    simAccel.context = context;
+    simAccel.sampleEvent.slot = -1;
+    for(index = 0; index < sizeof(simAccel.registers); index ++)
+    {
+        simAccel.registers[index] = 0;
+    }
+    /* CTRL1: power down, all axes on */
+    simAccel.registers[LSM303D_CTRL1] = 0x07;
+    simAccel.head = 0;
+    simAccel.count = 0;
+    simAccel.overrun = false;
+    simAccel.latest.x = simAccel.latest.y = simAccel.latest.z = 0;
+    simAccel.latestTime = 0;
+    simAccel.selected = false;
+    simAccel.haveCommand = false;
+    simAccel.int2 = false;
+    simAccel.stats.produced = 0;
+    simAccel.stats.read = 0;
+    simAccel.stats.overwritten = 0;
+    simAccel.stats.readEmpty = 0;
+    simAccel.stats.readNewestTime = 0;
+
+    SIM_SPI_SlaveSet(_SIM_ACCEL_Exchange);
+    SIM_CORE_PeripheralAdd(_SIM_ACCEL_Sync);
+}
+
+const SIM_ACCEL_STATS * SIM_ACCEL_StatsGet ( void )
+{
+    return &simAccel.stats;
+}
+
+/*******************************************************************************
+ End of File
+ */
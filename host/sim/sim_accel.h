@@ -0,0 +1,69 @@
+/*******************************************************************************
+  Simulated LSM303D Accelerometer Header
+
+  File Name:
+    sim_accel.h
+
+  Summary:
+    The accelerometer half of an LSM303D on SPI1, chip select on RB4 and
+    INT2 on RB13.
+
+  Description:
+    Samples come from a source routine at the output data rate set in CTRL1,
+    or at the intervals the source asks for.  They go through the FIFO the
+    way FIFO_CTRL and CTRL0 set it up: stream mode overwrites the oldest
+    sample when it is full and flags OVRN, and CTRL0_FTH_EN limits its depth
+    to the watermark level.  Reading OUT_Z_H_A pops the oldest sample, and
+    with the FIFO on the register address wraps from there back to
+    OUT_X_L_A.  INT2 follows FIFO_SRC_FTH when CTRL4 routes it there, and
+    its rising edge requests external interrupt 2.
+
+    The magnetometer and temperature registers read as zero.
+*******************************************************************************/
+
+#ifndef _SIM_ACCEL_H
+#define _SIM_ACCEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sim_core.h"
+
+typedef struct
+{
+    int16_t x;
+    int16_t y;
+    int16_t z;
+
+} SIM_ACCEL_SAMPLE;
+
+/* Supplies the sample taken now.  interval is preset to one period of the
+   data rate, and the source may change it to move the next sample.  Returns
+   false when the source has run out, which stops the sensor. */
+typedef bool (*SIM_ACCEL_SOURCE)(uintptr_t context, SIM_ACCEL_SAMPLE * sample,
+                                 SIM_TIME * interval);
+
+typedef struct
+{
+    /* Samples taken, read out of the FIFO and overwritten in it */
+    uint32_t produced;
+    uint32_t read;
+    uint32_t overwritten;
+
+    /* Samples read while the FIFO was empty, which repeat the newest one */
+    uint32_t readEmpty;
+
+    /* When the newest sample read out had been taken */
+    SIM_TIME readNewestTime;
+
+} SIM_ACCEL_STATS;
+
+/* Powers the sensor down, empties it and connects it to SPI1.  Without a
+   source it lies flat. */
+void SIM_ACCEL_Reset ( SIM_ACCEL_SOURCE source, uintptr_t context );
+
+const SIM_ACCEL_STATS * SIM_ACCEL_StatsGet ( void );
+
+#endif /* _SIM_ACCEL_H */
+/*******************************************************************************
+ End of File
+ */
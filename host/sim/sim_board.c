@@ -0,0 +1,188 @@
+/*******************************************************************************
+  Simulated Board
+
+  File Name:
+    sim_board.c
+
+  Summary:
+    Port B, the starter kit's LEDs and switch, and the clock and device
+    control services for the host build of the firmware.
+
+  Description:
+    The port registers are the ones of xc.h.  A pin driven through the
+    ports service syncs the peripherals before and after the change, so
+    that the simulated accelerometer sees its chip select move between the
+    SPI1 bytes around it.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <xc.h>
+#include "system_config.h"
+#include "system/clk/sys_clk.h"
+#include "system/devcon/sys_devcon.h"
+#include "system/ports/sys_ports.h"
+#include "sim_core.h"
+#include "sim_board.h"
+
+volatile uint32_t LATB;
+volatile uint32_t TRISB;
+volatile uint32_t PORTB;
+volatile uint32_t ANSELB;
+volatile uint32_t SDI1R;
+volatile uint32_t RPB2R;
+volatile uint32_t INT2R;
+volatile uint32_t INTCON;
+
+static struct
+{
+    bool led[3];
+    bool switchPressed;
+    uint32_t latA;
+} simBoard;
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Simulation Control
+// *****************************************************************************
+// *****************************************************************************
+
+void SIM_BOARD_Reset ( void )
+{
+    int index;
+
+    LATB = 0;
+    TRISB = 0xFFFF;
+    PORTB = 0;
+    ANSELB = 0xFFFF;
+    SDI1R = 0;
+    RPB2R = 0;
+    INT2R = 0;
+    INTCON = 0;
+    for(index = 0; index < 3; index ++)
+    {
+        simBoard.led[index] = false;
+    }
+    simBoard.switchPressed = false;
+    simBoard.latA = 0;
+}
+
+void SIM_BOARD_SwitchSet ( bool pressed )
+{
+    simBoard.switchPressed = pressed;
+}
+
+bool SIM_BOARD_LEDGet ( BSP_LED led )
+{
+    return simBoard.led[led];
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Ports System Service
+// *****************************************************************************
+// *****************************************************************************
+
+static volatile uint32_t * _SIM_BOARD_Latch ( PORTS_CHANNEL channel )
+{
+    return (channel == PORT_CHANNEL_B) ? &LATB : (volatile uint32_t *)&simBoard.latA;
+}
+
+void SYS_PORTS_Initialize ( void )
+{
+}
+
+void SYS_PORTS_PinSet ( PORTS_MODULE_ID index, PORTS_CHANNEL channel,
+                        PORTS_BIT_POS bitPos )
+{
+    SIM_CORE_Sync();
+    *_SIM_BOARD_Latch(channel) |= 1u << bitPos;
+    SIM_CORE_Sync();
+}
+
+void SYS_PORTS_PinClear ( PORTS_MODULE_ID index, PORTS_CHANNEL channel,
+                          PORTS_BIT_POS bitPos )
+{
+    SIM_CORE_Sync();
+    *_SIM_BOARD_Latch(channel) &= ~(1u << bitPos);
+    SIM_CORE_Sync();
+}
+
+bool SYS_PORTS_PinRead ( PORTS_MODULE_ID index, PORTS_CHANNEL channel,
+                         PORTS_BIT_POS bitPos )
+{
+    SIM_CORE_Sync();
+    if(channel == PORT_CHANNEL_B)
+    {
+        return (PORTB >> bitPos) & 1;
+    }
+    return (simBoard.latA >> bitPos) & 1;
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Board Support Package
+// *****************************************************************************
+// *****************************************************************************
+
+void BSP_Initialize ( void )
+{
+}
+
+void BSP_LEDOn ( BSP_LED led )
+{
+    simBoard.led[led] = true;
+}
+
+void BSP_LEDOff ( BSP_LED led )
+{
+    simBoard.led[led] = false;
+}
+
+BSP_SWITCH_STATE BSP_SwitchStateGet ( BSP_SWITCH bspSwitch )
+{
+    return ((bspSwitch == BSP_SWITCH_1) && simBoard.switchPressed) ?
+            BSP_SWITCH_STATE_PRESSED : BSP_SWITCH_STATE_RELEASED;
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Clock and Device Control System Services
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_CLK_Initialize ( const void * clkInit )
+{
+}
+
+uint32_t SYS_CLK_SystemFrequencyGet ( void )
+{
+    return SYS_CLK_FREQ;
+}
+
+SYS_MODULE_OBJ SYS_DEVCON_Initialize ( const SYS_MODULE_INDEX index,
+                                       const SYS_MODULE_INIT * const init )
+{
+    return (SYS_MODULE_OBJ)index;
+}
+
+void SYS_DEVCON_PerformanceConfig ( unsigned int sysclk )
+{
+}
+
+void SYS_DEVCON_Tasks ( SYS_MODULE_OBJ object )
+{
+    SIM_CORE_Charge(SIM_CORE_CostGet()->harmonyTasks);
+}
+
+/*******************************************************************************
+ End of File
+ */
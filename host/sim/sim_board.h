@@ -0,0 +1,28 @@
+/*******************************************************************************
+  Simulated Board Header
+
+  File Name:
+    sim_board.h
+
+  Summary:
+    Port B, the starter kit's LEDs and switch, and the clock and device
+    control services for the host build of the firmware.
+*******************************************************************************/
+
+#ifndef _SIM_BOARD_H
+#define _SIM_BOARD_H
+
+#include <stdbool.h>
+#include "bsp_config.h"
+
+/* Releases the switch and turns the LEDs off */
+void SIM_BOARD_Reset ( void );
+
+void SIM_BOARD_SwitchSet ( bool pressed );
+
+bool SIM_BOARD_LEDGet ( BSP_LED led );
+
+#endif /* _SIM_BOARD_H */
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,611 @@
+/*******************************************************************************
+  Simulated Core
+
+  File Name:
+    sim_core.c
+
+  Summary:
+    Virtual time, the core timer, the interrupt controller and the CPU's
+    own time for the host build of the firmware.
+
+  Description:
+    See sim_core.h.  Also implements the interrupt system service, which on
+    the device is a thin layer over the interrupt controller registers.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "system_config.h"
+#include "sim_core.h"
+
+#define SIM_EVENTS_MAX          64
+#define SIM_PERIPHERALS_MAX     8
+
+/* CPU cycles per core timer tick */
+#define SIM_CYCLES_PER_TICK     2
+
+static const SIM_COST simCostDefault =
+{
+    .call = 30,
+    .isr = 70,
+    .usbEvent = 450,
+    .usbReportSend = 350,
+    .usbControlPacket = 400,
+    .harmonyTasks = 120,
+};
+
+static struct
+{
+    SIM_TIME now;
+
+    /* Pending events, a binary heap on (time, order) */
+    SIM_EVENT * events[SIM_EVENTS_MAX];
+    int eventCount;
+    uint64_t eventOrder;
+
+    void (*sync[SIM_PERIPHERALS_MAX])(void);
+    int peripheralCount;
+    bool syncing;
+
+    /* Core timer */
+    uint32_t compare;
+    SIM_EVENT compareEvent;
+
+    /* Interrupt controller: flags, enables, vector priorities */
+    uint32_t ifs;
+    uint32_t iec;
+    INT_PRIORITY_LEVEL priority[INT_VECTORS_NUMBER];
+    SIM_CORE_ISR vectors[INT_VECTORS_NUMBER];
+    uint32_t vectorCount[INT_VECTORS_NUMBER];
+    bool interruptsEnabled;
+    INT_PRIORITY_LEVEL ipl;
+
+    /* Cost model */
+    SIM_COST cost;
+    bool costEnabled;
+    uint32_t cycleRemainder;
+
+    /* Time spent waiting */
+    SIM_TIME idleTicks;
+
+} simCore;
+
+/* Vector of each source */
+static const INT_VECTOR simVectorOfSource[INT_SOURCES_NUMBER] =
+{
+    [INT_SOURCE_TIMER_CORE] = INT_VECTOR_CT,
+    [INT_SOURCE_EXTERNAL_1] = INT_VECTOR_INT1,
+    [INT_SOURCE_EXTERNAL_2] = INT_VECTOR_INT2,
+    [INT_SOURCE_SPI_1_ERROR] = INT_VECTOR_SPI1,
+    [INT_SOURCE_SPI_1_RECEIVE] = INT_VECTOR_SPI1,
+    [INT_SOURCE_SPI_1_TRANSMIT] = INT_VECTOR_SPI1,
+    [INT_SOURCE_USB_1] = INT_VECTOR_USB1,
+    [INT_SOURCE_DMA_0] = INT_VECTOR_DMA0,
+    [INT_SOURCE_DMA_1] = INT_VECTOR_DMA1,
+};
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Event Queue
+// *****************************************************************************
+// *****************************************************************************
+
+static bool _SIM_CORE_EventBefore ( const SIM_EVENT * a, const SIM_EVENT * b )
+{
+    return (a->time < b->time) || ((a->time == b->time) && (a->order < b->order));
+}
+
+static void _SIM_CORE_EventPlace ( SIM_EVENT * event, int slot )
+{
+    simCore.events[slot] = event;
+    event->slot = slot;
+}
+
+static void _SIM_CORE_EventUp ( int slot )
+{
+    SIM_EVENT * event = simCore.events[slot];
+
+    while(slot > 0)
+    {
+        int parent = (slot - 1) / 2;
+
+        if(!_SIM_CORE_EventBefore(event, simCore.events[parent]))
+        {
+            break;
+        }
+        _SIM_CORE_EventPlace(simCore.events[parent], slot);
+        slot = parent;
+    }
+    _SIM_CORE_EventPlace(event, slot);
+}
+
+static void _SIM_CORE_EventDown ( int slot )
+{
+    SIM_EVENT * event = simCore.events[slot];
+
+    for(;;)
+    {
+        int child = 2 * slot + 1;
+
+        if(child >= simCore.eventCount)
+        {
+            break;
+        }
+        if((child + 1 < simCore.eventCount) &&
+           _SIM_CORE_EventBefore(simCore.events[child + 1], simCore.events[child]))
+        {
+            child ++;
+        }
+        if(!_SIM_CORE_EventBefore(simCore.events[child], event))
+        {
+            break;
+        }
+        _SIM_CORE_EventPlace(simCore.events[child], slot);
+        slot = child;
+    }
+    _SIM_CORE_EventPlace(event, slot);
+}
+
+static void _SIM_CORE_EventRemove ( SIM_EVENT * event )
+{
+    int slot = event->slot;
+    SIM_EVENT * moved;
+
+    event->slot = -1;
+    simCore.eventCount --;
+    if(slot == simCore.eventCount)
+    {
+        return;
+    }
+    moved = simCore.events[simCore.eventCount];
+    _SIM_CORE_EventPlace(moved, slot);
+    _SIM_CORE_EventUp(slot);
+    _SIM_CORE_EventDown(moved->slot);
+}
+
+/* Runs the first event if it is due by limit */
+static bool _SIM_CORE_EventRun ( SIM_TIME limit )
+{
+    SIM_EVENT * event;
+
+    if((simCore.eventCount == 0) || (simCore.events[0]->time > limit))
+    {
+        return false;
+    }
+
+    event = simCore.events[0];
+    _SIM_CORE_EventRemove(event);
+    if(event->time > simCore.now)
+    {
+        simCore.now = event->time;
+    }
+    event->handler(event->context);
+    return true;
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interrupt Controller
+// *****************************************************************************
+// *****************************************************************************
+
+/* Highest priority source that would be taken now, or -1 */
+static int _SIM_CORE_SourcePending ( bool ignoreEnable )
+{
+    INT_PRIORITY_LEVEL best = simCore.ipl;
+    int found = -1;
+    int source;
+
+    if(!simCore.interruptsEnabled && !ignoreEnable)
+    {
+        return -1;
+    }
+
+    for(source = 0; source < INT_SOURCES_NUMBER; source ++)
+    {
+        uint32_t mask = 1u << source;
+        INT_PRIORITY_LEVEL level = simCore.priority[simVectorOfSource[source]];
+
+        if((simCore.ifs & simCore.iec & mask) && (level > best))
+        {
+            best = level;
+            found = source;
+        }
+    }
+    return found;
+}
+
+/* Takes every pending interrupt that outranks the current level */
+static void _SIM_CORE_Dispatch ( void )
+{
+    int source;
+
+    SIM_CORE_Sync();
+    while((source = _SIM_CORE_SourcePending(false)) >= 0)
+    {
+        INT_VECTOR vector = simVectorOfSource[source];
+        INT_PRIORITY_LEVEL saved = simCore.ipl;
+
+        if(simCore.vectors[vector] == NULL)
+        {
+            fprintf(stderr, "sim: interrupt source %d has no handler\n", source);
+            abort();
+        }
+
+        simCore.ipl = simCore.priority[vector];
+        simCore.vectorCount[vector] ++;
+        SIM_CORE_Charge(simCore.cost.isr);
+        simCore.vectors[vector]();
+        simCore.ipl = saved;
+        SIM_CORE_Sync();
+    }
+}
+
+static void _SIM_CORE_CompareMatch ( uintptr_t context )
+{
+    SIM_CORE_InterruptRequest(INT_SOURCE_TIMER_CORE);
+}
+
+static void _SIM_CORE_CompareSchedule ( void )
+{
+    /* The next tick at which Count equals Compare */
+    uint32_t delta = simCore.compare - (uint32_t)simCore.now;
+    SIM_TIME time = simCore.now + (delta ? delta : ((SIM_TIME)1 << 32));
+
+    SIM_CORE_EventSchedule(&simCore.compareEvent, time, _SIM_CORE_CompareMatch, 0);
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Time and Events
+// *****************************************************************************
+// *****************************************************************************
+
+void SIM_CORE_Reset ( void )
+{
+    int vector;
+
+    simCore.now = 0;
+    simCore.eventCount = 0;
+    simCore.eventOrder = 0;
+    simCore.peripheralCount = 0;
+    simCore.syncing = false;
+    simCore.ifs = 0;
+    simCore.iec = 0;
+    simCore.interruptsEnabled = false;
+    simCore.ipl = INT_DISABLE_INTERRUPT;
+    for(vector = 0; vector < INT_VECTORS_NUMBER; vector ++)
+    {
+        simCore.priority[vector] = INT_DISABLE_INTERRUPT;
+        simCore.vectors[vector] = NULL;
+        simCore.vectorCount[vector] = 0;
+    }
+    simCore.cost = simCostDefault;
+    simCore.costEnabled = false;
+    simCore.cycleRemainder = 0;
+    simCore.idleTicks = 0;
+
+    simCore.compareEvent.slot = -1;
+    simCore.compare = 0;
+    _SIM_CORE_CompareSchedule();
+}
+
+SIM_TIME SIM_CORE_Now ( void )
+{
+    return simCore.now;
+}
+
+void SIM_CORE_EventSchedule ( SIM_EVENT * event, SIM_TIME time,
+                              SIM_EVENT_HANDLER handler, uintptr_t context )
+{
+    if(SIM_CORE_EventIsScheduled(event))
+    {
+        _SIM_CORE_EventRemove(event);
+    }
+    if(simCore.eventCount == SIM_EVENTS_MAX)
+    {
+        fprintf(stderr, "sim: more than %d events scheduled\n", SIM_EVENTS_MAX);
+        abort();
+    }
+
+    event->time = time;
+    event->handler = handler;
+    event->context = context;
+    event->order = simCore.eventOrder ++;
+    _SIM_CORE_EventPlace(event, simCore.eventCount ++);
+    _SIM_CORE_EventUp(event->slot);
+}
+
+void SIM_CORE_EventCancel ( SIM_EVENT * event )
+{
+    if(SIM_CORE_EventIsScheduled(event))
+    {
+        _SIM_CORE_EventRemove(event);
+    }
+}
+
+bool SIM_CORE_EventIsScheduled ( const SIM_EVENT * event )
+{
+    return (event->slot >= 0) && (event->slot < simCore.eventCount) &&
+           (simCore.events[event->slot] == event);
+}
+
+void SIM_CORE_PeripheralAdd ( void (*sync)(void) )
+{
+    if(simCore.peripheralCount == SIM_PERIPHERALS_MAX)
+    {
+        fprintf(stderr, "sim: more than %d peripherals\n", SIM_PERIPHERALS_MAX);
+        abort();
+    }
+    simCore.sync[simCore.peripheralCount ++] = sync;
+}
+
+void SIM_CORE_Sync ( void )
+{
+    int index;
+
+    /* A sync routine may raise requests, which must not sync again */
+    if(simCore.syncing)
+    {
+        return;
+    }
+    simCore.syncing = true;
+    for(index = 0; index < simCore.peripheralCount; index ++)
+    {
+        simCore.sync[index]();
+    }
+    simCore.syncing = false;
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: CPU
+// *****************************************************************************
+// *****************************************************************************
+
+void SIM_CORE_Spend ( uint32_t cycles )
+{
+    SIM_TIME end;
+
+    cycles += simCore.cycleRemainder;
+    simCore.cycleRemainder = cycles % SIM_CYCLES_PER_TICK;
+    end = simCore.now + cycles / SIM_CYCLES_PER_TICK;
+
+    for(;;)
+    {
+        SIM_TIME start = simCore.now;
+
+        /* Interrupts taken here delay the end by their own time */
+        _SIM_CORE_Dispatch();
+        end += simCore.now - start;
+
+        if(!_SIM_CORE_EventRun(end))
+        {
+            break;
+        }
+    }
+    simCore.now = end;
+}
+
+void SIM_CORE_Wait ( void )
+{
+    SIM_TIME start = simCore.now;
+
+    SIM_CORE_Sync();
+    while(_SIM_CORE_SourcePending(true) < 0)
+    {
+        if(!_SIM_CORE_EventRun(UINT64_MAX))
+        {
+            fprintf(stderr, "sim: WAIT with nothing scheduled to end it\n");
+            abort();
+        }
+        SIM_CORE_Sync();
+    }
+    simCore.idleTicks += simCore.now - start;
+
+    _SIM_CORE_Dispatch();
+}
+
+void SIM_CORE_RunUntil ( SIM_TIME time )
+{
+    while(simCore.now < time)
+    {
+        SIM_TIME start = simCore.now;
+
+        _SIM_CORE_Dispatch();
+        if(!_SIM_CORE_EventRun(time))
+        {
+            simCore.idleTicks += time - simCore.now;
+            simCore.now = time;
+        }
+        else
+        {
+            simCore.idleTicks += simCore.now - start;
+        }
+    }
+    _SIM_CORE_Dispatch();
+}
+
+void SIM_CORE_CostSet ( const SIM_COST * cost )
+{
+    simCore.cost = *cost;
+}
+
+void SIM_CORE_CostEnable ( bool enable )
+{
+    simCore.costEnabled = enable;
+}
+
+const SIM_COST * SIM_CORE_CostGet ( void )
+{
+    return &simCore.cost;
+}
+
+void SIM_CORE_Charge ( uint32_t cycles )
+{
+    if(simCore.costEnabled)
+    {
+        SIM_CORE_Spend(cycles);
+    }
+}
+
+SIM_TIME SIM_CORE_BusyTicksGet ( void )
+{
+    return simCore.now - simCore.idleTicks;
+}
+
+/* Every firmware function entry, see -finstrument-functions */
+void __attribute__((no_instrument_function))
+__cyg_profile_func_enter ( void * function, void * caller )
+{
+    SIM_CORE_Charge(simCore.cost.call);
+}
+
+void __attribute__((no_instrument_function))
+__cyg_profile_func_exit ( void * function, void * caller )
+{
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Core Timer and Interrupt Controller
+// *****************************************************************************
+// *****************************************************************************
+
+uint32_t SIM_CORE_CountGet ( void )
+{
+    return (uint32_t)simCore.now;
+}
+
+void SIM_CORE_CompareSet ( uint32_t compare )
+{
+    simCore.compare = compare;
+    _SIM_CORE_CompareSchedule();
+}
+
+void SIM_CORE_VectorsSet ( const SIM_CORE_VECTOR_TABLE vectors )
+{
+    int vector;
+
+    for(vector = 0; vector < INT_VECTORS_NUMBER; vector ++)
+    {
+        simCore.vectors[vector] = vectors[vector];
+    }
+}
+
+void SIM_CORE_InterruptRequest ( INT_SOURCE source )
+{
+    simCore.ifs |= 1u << source;
+}
+
+uint32_t SIM_CORE_VectorCountGet ( INT_VECTOR vector )
+{
+    return simCore.vectorCount[vector];
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interrupt System Service
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_INT_Initialize ( void )
+{
+    simCore.interruptsEnabled = false;
+}
+
+void SYS_INT_Enable ( void )
+{
+    simCore.interruptsEnabled = true;
+    _SIM_CORE_Dispatch();
+}
+
+bool SYS_INT_Disable ( void )
+{
+    bool state = simCore.interruptsEnabled;
+
+    SIM_CORE_Sync();
+    simCore.interruptsEnabled = false;
+    return state;
+}
+
+void SYS_INT_Restore ( bool state )
+{
+    simCore.interruptsEnabled = state;
+    _SIM_CORE_Dispatch();
+}
+
+bool SYS_INT_IsEnabled ( void )
+{
+    return simCore.interruptsEnabled;
+}
+
+void SYS_INT_SourceEnable ( INT_SOURCE source )
+{
+    simCore.iec |= 1u << source;
+    _SIM_CORE_Dispatch();
+}
+
+bool SYS_INT_SourceDisable ( INT_SOURCE source )
+{
+    bool enabled = (simCore.iec & (1u << source)) != 0;
+
+    SIM_CORE_Sync();
+    simCore.iec &= ~(1u << source);
+    return enabled;
+}
+
+bool SYS_INT_SourceIsEnabled ( INT_SOURCE source )
+{
+    return (simCore.iec & (1u << source)) != 0;
+}
+
+bool SYS_INT_SourceStatusGet ( INT_SOURCE source )
+{
+    SIM_CORE_Sync();
+    return (simCore.ifs & (1u << source)) != 0;
+}
+
+void SYS_INT_SourceStatusSet ( INT_SOURCE source )
+{
+    simCore.ifs |= 1u << source;
+    _SIM_CORE_Dispatch();
+}
+
+void SYS_INT_SourceStatusClear ( INT_SOURCE source )
+{
+    SIM_CORE_Sync();
+    simCore.ifs &= ~(1u << source);
+}
+
+void SYS_INT_VectorPrioritySet ( INT_VECTOR vector, INT_PRIORITY_LEVEL priority )
+{
+    simCore.priority[vector] = priority;
+}
+
+INT_PRIORITY_LEVEL SYS_INT_VectorPriorityGet ( INT_VECTOR vector )
+{
+    return simCore.priority[vector];
+}
+
+void SYS_INT_VectorSubprioritySet ( INT_VECTOR vector,
+                                    INT_SUBPRIORITY_LEVEL subpriority )
+{
+    /* Sources of the same level are taken in source order */
+}
+
+/*******************************************************************************
+ End of File
+ */
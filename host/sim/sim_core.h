@@ -0,0 +1,256 @@
+/*******************************************************************************
+  Simulated Core Header
+
+  File Name:
+    sim_core.h
+
+  Summary:
+    Virtual time, the core timer, the interrupt controller and the CPU's
+    own time for the host build of the firmware.
+
+  Description:
+    Time is counted in core timer ticks, SYS_CLK_FREQ / 2 per second as on
+    the device, from the start of the run.  It only moves forward when the
+    CPU spends cycles (SIM_CORE_Spend()) or waits for an interrupt
+    (SIM_CORE_Wait()).  On the way, the scheduled events of the simulated
+    peripherals run at their times and raise interrupt requests, and every
+    request that is enabled and outranks the current priority level calls
+    its vector, as the PIC32 interrupt controller does.
+
+    With the cost model on, every call into the firmware (built with
+    -finstrument-functions) spends SIM_COST.call cycles, so that code takes
+    time in proportion to the work it does and interrupts can arrive in the
+    middle of it.  Off, which is the default for unit tests, the firmware
+    runs in no time at all and time only moves when a test spends it.
+
+    The peripherals register a sync routine each.  It runs before time
+    moves and on every call into the interrupt or ports services, and picks
+    up what the firmware wrote to the registers since the last one.
+*******************************************************************************/
+
+#ifndef _SIM_CORE_H
+#define _SIM_CORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "system_config.h"
+#include "system/int/sys_int.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Core timer ticks since the start of the run */
+typedef uint64_t SIM_TIME;
+
+typedef void (*SIM_EVENT_HANDLER)(uintptr_t context);
+
+// *****************************************************************************
+/* Scheduled Event
+
+  Remarks:
+    Owned by the peripheral that schedules it.  Events due at the same time
+    run in the order they were scheduled.
+*/
+
+typedef struct
+{
+    SIM_TIME time;
+    SIM_EVENT_HANDLER handler;
+    uintptr_t context;
+
+    /* Private: ordering among equal times and position in the queue */
+    uint64_t order;
+    int slot;
+
+} SIM_EVENT;
+
+typedef void (*SIM_CORE_ISR)(void);
+
+/* Interrupt handlers indexed by INT_VECTOR, see SIM_CORE_VectorsSet() */
+typedef SIM_CORE_ISR SIM_CORE_VECTOR_TABLE[INT_VECTORS_NUMBER];
+
+// *****************************************************************************
+/* CPU Cost Model
+
+  Summary:
+    CPU cycles (SYS_CLK_FREQ) charged for what runs on the simulated core.
+
+  Remarks:
+    Rough figures for a PIC32MX at 80 MHz with -O1.  Compare them with the
+    histograms of the profiler feature report of a real board before
+    trusting an absolute number; comparisons between configurations need
+    them less.
+*/
+
+typedef struct
+{
+    /* Each firmware function call */
+    uint32_t call;
+
+    /* Interrupt prologue and epilogue, context save included */
+    uint32_t isr;
+
+    /* One event handled by the USB device layer in its interrupt */
+    uint32_t usbEvent;
+
+    /* USB_DEVICE_HID_ReportSend() and the IRP it queues */
+    uint32_t usbReportSend;
+
+    /* One packet of a control transfer data stage */
+    uint32_t usbControlPacket;
+
+    /* One USB_DEVICE_Tasks() or SYS_DEVCON_Tasks() call */
+    uint32_t harmonyTasks;
+
+} SIM_COST;
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Time and Events
+// *****************************************************************************
+// *****************************************************************************
+
+/* Core timer ticks per second */
+#define SIM_TICKS_PER_SECOND    (SYS_CLK_FREQ / 2)
+#define SIM_US_TO_TICKS(us)     ((SIM_TIME)(us) * (SIM_TICKS_PER_SECOND / 1000000))
+
+/*******************************************************************************
+  Function:
+    void SIM_CORE_Reset ( void )
+
+  Summary:
+    Starts a new run at time 0, with nothing scheduled, every interrupt
+    source disabled and the cost model off.
+
+  Remarks:
+    The peripherals are reset by their own routines.
+*/
+
+void SIM_CORE_Reset ( void );
+
+SIM_TIME SIM_CORE_Now ( void );
+
+/*******************************************************************************
+  Function:
+    void SIM_CORE_EventSchedule ( SIM_EVENT * event, SIM_TIME time,
+                                  SIM_EVENT_HANDLER handler, uintptr_t context )
+
+  Summary:
+    Runs handler at time, or as soon as time moves if that has passed.
+
+  Remarks:
+    Reschedules the event if it is already scheduled.  The handler runs as
+    hardware: it may raise interrupt requests but does not call firmware.
+*/
+
+void SIM_CORE_EventSchedule ( SIM_EVENT * event, SIM_TIME time,
+                              SIM_EVENT_HANDLER handler, uintptr_t context );
+
+void SIM_CORE_EventCancel ( SIM_EVENT * event );
+
+bool SIM_CORE_EventIsScheduled ( const SIM_EVENT * event );
+
+/*******************************************************************************
+  Function:
+    void SIM_CORE_PeripheralAdd ( void (*sync)(void) )
+
+  Summary:
+    Registers a peripheral's register sync routine.
+*/
+
+void SIM_CORE_PeripheralAdd ( void (*sync)(void) );
+
+/* Runs every sync routine */
+void SIM_CORE_Sync ( void );
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: CPU
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void SIM_CORE_Spend ( uint32_t cycles )
+
+  Summary:
+    Moves time on by what the CPU takes to run cycles instructions.
+
+  Description:
+    Interrupts taken on the way add their own time, the way they delay the
+    code they preempt.
+*/
+
+void SIM_CORE_Spend ( uint32_t cycles );
+
+/*******************************************************************************
+  Function:
+    void SIM_CORE_Wait ( void )
+
+  Summary:
+    The WAIT instruction.
+
+  Description:
+    Returns once an enabled interrupt request outranks the current priority
+    level.  If interrupts are enabled, it has been taken by then.
+
+  Remarks:
+    Aborts the run if nothing is scheduled that could end the wait.
+*/
+
+void SIM_CORE_Wait ( void );
+
+/*******************************************************************************
+  Function:
+    void SIM_CORE_RunUntil ( SIM_TIME time )
+
+  Summary:
+    Idles until time, taking interrupts.  For tests without a firmware
+    main loop.
+*/
+
+void SIM_CORE_RunUntil ( SIM_TIME time );
+
+void SIM_CORE_CostSet ( const SIM_COST * cost );
+
+/* Turns the charges of the cost model on or off */
+void SIM_CORE_CostEnable ( bool enable );
+
+const SIM_COST * SIM_CORE_CostGet ( void );
+
+/* Spends the cycles when the cost model is on */
+void SIM_CORE_Charge ( uint32_t cycles );
+
+/* Time spent out of SIM_CORE_Wait() since the reset */
+SIM_TIME SIM_CORE_BusyTicksGet ( void );
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Core Timer and Interrupt Controller
+// *****************************************************************************
+// *****************************************************************************
+
+uint32_t SIM_CORE_CountGet ( void );
+
+void SIM_CORE_CompareSet ( uint32_t compare );
+
+/* Installs the system configuration's interrupt handlers */
+void SIM_CORE_VectorsSet ( const SIM_CORE_VECTOR_TABLE vectors );
+
+/* Raises an interrupt request from a peripheral */
+void SIM_CORE_InterruptRequest ( INT_SOURCE source );
+
+/* Number of times each vector has been taken since the reset */
+uint32_t SIM_CORE_VectorCountGet ( INT_VECTOR vector );
+
+#endif /* _SIM_CORE_H */
+/*******************************************************************************
+ End of File
+ */
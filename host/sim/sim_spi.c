@@ -0,0 +1,329 @@
+/*******************************************************************************
+  Simulated SPI1 and DMA Controller
+
+  File Name:
+    sim_spi.c
+
+  Summary:
+    SPI1 in 8-bit master mode and DMA channels 0 and 1 for the host build
+    of the firmware.
+
+  Description:
+    See sim_spi.h.  The sync routine picks up what the firmware has written
+    since the last one: a byte in SPI1BUF (bit 8 clear, see xc.h), the
+    CHEN edges that rewind a channel's pointers, DCHxINTCLR and CFORCE.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <xc.h>
+#include <stddef.h>
+#include "system_config.h"
+#include "sim_core.h"
+#include "sim_spi.h"
+
+#define SIM_SPI_BUF_DELIVERED   0x100u
+
+volatile uint32_t SPI1CON;
+volatile uint32_t SPI1STAT;
+volatile uint32_t SPI1BRG;
+volatile uint32_t SPI1CON2;
+volatile uint32_t SPI1BUF;
+volatile uint32_t DMACON;
+
+#define SIM_SPI_DMA_CHANNEL(n)                                                \
+    volatile uint32_t DCH##n##CON;                                            \
+    volatile uint32_t DCH##n##ECON;                                           \
+    volatile uint32_t DCH##n##INT;                                            \
+    volatile uint32_t DCH##n##INTCLR;                                         \
+    volatile uintptr_t DCH##n##SSA;                                           \
+    volatile uintptr_t DCH##n##DSA;                                           \
+    volatile uint32_t DCH##n##SSIZ;                                           \
+    volatile uint32_t DCH##n##DSIZ;                                           \
+    volatile uint32_t DCH##n##CSIZ
+
+SIM_SPI_DMA_CHANNEL(0);
+SIM_SPI_DMA_CHANNEL(1);
+
+/* Register set of one channel */
+typedef struct
+{
+    volatile __DCHxCONbits_t * con;
+    volatile __DCHxECONbits_t * econ;
+    volatile __DCHxINTbits_t * interrupt;
+    volatile uint32_t * interruptClear;
+    volatile uintptr_t * ssa;
+    volatile uintptr_t * dsa;
+    volatile uint32_t * ssiz;
+    volatile uint32_t * dsiz;
+    INT_SOURCE source;
+
+} SIM_SPI_DMA_REGISTERS;
+
+static const SIM_SPI_DMA_REGISTERS simDma[2] =
+{
+    {
+        (volatile __DCHxCONbits_t *)&DCH0CON, (volatile __DCHxECONbits_t *)&DCH0ECON,
+        (volatile __DCHxINTbits_t *)&DCH0INT, &DCH0INTCLR, &DCH0SSA, &DCH0DSA,
+        &DCH0SSIZ, &DCH0DSIZ, INT_SOURCE_DMA_0
+    },
+    {
+        (volatile __DCHxCONbits_t *)&DCH1CON, (volatile __DCHxECONbits_t *)&DCH1ECON,
+        (volatile __DCHxINTbits_t *)&DCH1INT, &DCH1INTCLR, &DCH1SSA, &DCH1DSA,
+        &DCH1SSIZ, &DCH1DSIZ, INT_SOURCE_DMA_1
+    },
+};
+
+static struct
+{
+    SIM_SPI_SLAVE slave;
+
+    /* Byte on the wire, and the one written behind it */
+    SIM_EVENT byteEvent;
+    uint8_t shifting;
+    bool busy;
+    bool txFull;
+    uint8_t txNext;
+    uint8_t rx;
+
+    /* Channel pointers and the CHEN state they were rewound for */
+    uint32_t sourcePointer[2];
+    uint32_t destinationPointer[2];
+    uint32_t moved[2];
+    bool enabled[2];
+
+    uint32_t bytes;
+    uint32_t dmaBytes;
+
+} simSpi;
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void _SIM_SPI_ByteDone ( uintptr_t context );
+
+static void _SIM_SPI_Transmit ( uint8_t byte )
+{
+    SIM_TIME ticks;
+
+    if(!SPI1CONbits.ON)
+    {
+        return;
+    }
+    if(simSpi.busy)
+    {
+        simSpi.txFull = true;
+        simSpi.txNext = byte;
+        return;
+    }
+
+    /* 8 bits of 2 * (SPI1BRG + 1) peripheral clocks, the peripheral clock
+       being the system clock and a core timer tick two of those */
+    ticks = 8 * (SPI1BRG + 1);
+    simSpi.shifting = byte;
+    simSpi.busy = true;
+    SIM_CORE_EventSchedule(&simSpi.byteEvent, SIM_CORE_Now() + ticks,
+            _SIM_SPI_ByteDone, 0);
+}
+
+/* One cell transfer of a channel */
+static void _SIM_SPI_DmaCell ( int channel )
+{
+    const SIM_SPI_DMA_REGISTERS * dma = &simDma[channel];
+    uint32_t block;
+    uint8_t byte;
+
+    if(!DMACONbits.ON || !dma->con->CHEN)
+    {
+        return;
+    }
+
+    if(*dma->ssa == (uintptr_t)&SPI1BUF)
+    {
+        byte = simSpi.rx;
+        SPI1STATbits.SPIRBF = 0;
+    }
+    else
+    {
+        byte = ((const uint8_t *)*dma->ssa)[simSpi.sourcePointer[channel]];
+    }
+    if(*dma->dsa == (uintptr_t)&SPI1BUF)
+    {
+        _SIM_SPI_Transmit(byte);
+    }
+    else
+    {
+        ((uint8_t *)*dma->dsa)[simSpi.destinationPointer[channel]] = byte;
+    }
+    simSpi.dmaBytes ++;
+
+    if(++ simSpi.sourcePointer[channel] >= *dma->ssiz)
+    {
+        simSpi.sourcePointer[channel] = 0;
+    }
+    if(++ simSpi.destinationPointer[channel] >= *dma->dsiz)
+    {
+        simSpi.destinationPointer[channel] = 0;
+    }
+
+    /* The block is the larger of the source and the destination */
+    block = (*dma->ssiz > *dma->dsiz) ? *dma->ssiz : *dma->dsiz;
+    if(++ simSpi.moved[channel] >= block)
+    {
+        dma->con->CHEN = 0;
+        simSpi.enabled[channel] = false;
+        dma->interrupt->CHBCIF = 1;
+        if(dma->interrupt->CHBCIE)
+        {
+            SIM_CORE_InterruptRequest(dma->source);
+        }
+    }
+}
+
+static void _SIM_SPI_DmaEvent ( unsigned int irq )
+{
+    int order[2];
+    int index;
+
+    /* The higher CHPRI goes first, channel 1 on a tie */
+    if(simDma[0].con->CHPRI > simDma[1].con->CHPRI)
+    {
+        order[0] = 0;
+        order[1] = 1;
+    }
+    else
+    {
+        order[0] = 1;
+        order[1] = 0;
+    }
+
+    for(index = 0; index < 2; index ++)
+    {
+        const SIM_SPI_DMA_REGISTERS * dma = &simDma[order[index]];
+
+        if(dma->econ->SIRQEN && (dma->econ->CHSIRQ == irq))
+        {
+            _SIM_SPI_DmaCell(order[index]);
+        }
+    }
+}
+
+static void _SIM_SPI_ByteDone ( uintptr_t context )
+{
+    uint8_t miso = (simSpi.slave != NULL) ? simSpi.slave(simSpi.shifting) : 0xFF;
+
+    simSpi.bytes ++;
+    simSpi.busy = false;
+    simSpi.rx = miso;
+    SPI1BUF = SIM_SPI_BUF_DELIVERED | miso;
+    SPI1STATbits.SPIRBF = 1;
+
+    /* Anything already written goes out next, before DMA writes more */
+    if(simSpi.txFull)
+    {
+        simSpi.txFull = false;
+        _SIM_SPI_Transmit(simSpi.txNext);
+    }
+
+    SIM_CORE_InterruptRequest(INT_SOURCE_SPI_1_RECEIVE);
+    _SIM_SPI_DmaEvent(_SPI1_RX_IRQ);
+}
+
+static void _SIM_SPI_Sync ( void )
+{
+    int channel;
+
+    if(!(SPI1BUF & SIM_SPI_BUF_DELIVERED))
+    {
+        uint8_t byte = (uint8_t)SPI1BUF;
+
+        SPI1BUF = SIM_SPI_BUF_DELIVERED | simSpi.rx;
+        _SIM_SPI_Transmit(byte);
+    }
+
+    for(channel = 0; channel < 2; channel ++)
+    {
+        const SIM_SPI_DMA_REGISTERS * dma = &simDma[channel];
+
+        if(*dma->interruptClear)
+        {
+            dma->interrupt->w &= ~*dma->interruptClear;
+            *dma->interruptClear = 0;
+        }
+
+        /* Enabling a channel rewinds its pointers */
+        if(dma->con->CHEN && !simSpi.enabled[channel])
+        {
+            simSpi.sourcePointer[channel] = 0;
+            simSpi.destinationPointer[channel] = 0;
+            simSpi.moved[channel] = 0;
+        }
+        simSpi.enabled[channel] = dma->con->CHEN;
+
+        if(dma->econ->CFORCE)
+        {
+            dma->econ->CFORCE = 0;
+            _SIM_SPI_DmaCell(channel);
+        }
+    }
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Simulation Control
+// *****************************************************************************
+// *****************************************************************************
+
+void SIM_SPI_Reset ( void )
+{
+    SPI1CON = 0;
+    SPI1STAT = 0;
+    SPI1BRG = 0;
+    SPI1CON2 = 0;
+    SPI1BUF = SIM_SPI_BUF_DELIVERED;
+    DMACON = 0;
+    DCH0CON = DCH0ECON = DCH0INT = DCH0INTCLR = 0;
+    DCH1CON = DCH1ECON = DCH1INT = DCH1INTCLR = 0;
+    DCH0SSA = DCH0DSA = DCH1SSA = DCH1DSA = 0;
+    DCH0SSIZ = DCH0DSIZ = DCH0CSIZ = 0;
+    DCH1SSIZ = DCH1DSIZ = DCH1CSIZ = 0;
+
+    simSpi.slave = NULL;
+    simSpi.byteEvent.slot = -1;
+    simSpi.busy = false;
+    simSpi.txFull = false;
+    simSpi.rx = 0;
+    simSpi.enabled[0] = simSpi.enabled[1] = false;
+    simSpi.bytes = 0;
+    simSpi.dmaBytes = 0;
+
+    SIM_CORE_PeripheralAdd(_SIM_SPI_Sync);
+}
+
+void SIM_SPI_SlaveSet ( SIM_SPI_SLAVE slave )
+{
+    simSpi.slave = slave;
+}
+
+uint32_t SIM_SPI_BytesGet ( void )
+{
+    return simSpi.bytes;
+}
+
+uint32_t SIM_SPI_DmaBytesGet ( void )
+{
+    return simSpi.dmaBytes;
+}
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,44 @@
+/*******************************************************************************
+  Simulated SPI1 and DMA Controller Header
+
+  File Name:
+    sim_spi.h
+
+  Summary:
+    SPI1 in 8-bit master mode and DMA channels 0 and 1 for the host build
+    of the firmware.
+
+  Description:
+    A byte written to SPI1BUF, by the CPU or by a DMA channel, is shifted
+    out in 8 SCK periods at the rate SPI1BRG sets.  The slave answers it
+    with a byte of its own, which lands in SPI1BUF and raises the SPI1
+    receive event: it sets the interrupt request, and starts a cell
+    transfer on every enabled DMA channel whose start IRQ it is, the
+    higher CHPRI first.  A channel that has moved its whole block clears
+    CHEN, sets CHBCIF and, if CHBCIE is set, requests its interrupt.
+
+    As on the device, the DMA channels never clear the SPI1 receive
+    interrupt request.  Only one cell size of one byte is supported.
+*******************************************************************************/
+
+#ifndef _SIM_SPI_H
+#define _SIM_SPI_H
+
+#include <stdint.h>
+
+/* Exchanges one byte with the slave on the bus, at the end of the byte */
+typedef uint8_t (*SIM_SPI_SLAVE)(uint8_t mosi);
+
+/* Resets SPI1 and the DMA controller and registers them with the core */
+void SIM_SPI_Reset ( void );
+
+void SIM_SPI_SlaveSet ( SIM_SPI_SLAVE slave );
+
+/* Bytes shifted since the reset, and those moved by DMA */
+uint32_t SIM_SPI_BytesGet ( void );
+uint32_t SIM_SPI_DmaBytesGet ( void );
+
+#endif /* _SIM_SPI_H */
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,67 @@
+/*******************************************************************************
+  Simulated System
+
+  File Name:
+    sim_system.c
+
+  Summary:
+    The whole firmware on the simulated board.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stddef.h>
+#include "system/common/sys_module.h"
+#include "run_loop.h"
+#include "sim_core.h"
+#include "sim_board.h"
+#include "sim_spi.h"
+#include "sim_system.h"
+
+/* Cycles of a main loop pass on top of what it calls */
+#define SIM_SYSTEM_PASS_CYCLES  2
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Simulation Control
+// *****************************************************************************
+// *****************************************************************************
+
+void SIM_SYSTEM_ConfigDefault ( SIM_SYSTEM_CONFIG * config )
+{
+    config->source = NULL;
+    config->sourceContext = 0;
+    SIM_USB_ConfigDefault(&config->usb);
+    config->costs = false;
+}
+
+void SIM_SYSTEM_Start ( const SIM_SYSTEM_CONFIG * config )
+{
+    SIM_CORE_Reset();
+    SIM_BOARD_Reset();
+    SIM_SPI_Reset();
+    SIM_ACCEL_Reset(config->source, config->sourceContext);
+    SIM_USB_Reset(&config->usb);
+    SIM_CORE_CostEnable(config->costs);
+
+    SYS_Initialize(NULL);
+}
+
+void SIM_SYSTEM_RunUntil ( SIM_TIME time )
+{
+    while(SIM_CORE_Now() < time)
+    {
+        SYS_Tasks();
+        SIM_CORE_Spend(SIM_SYSTEM_PASS_CYCLES);
+        RUN_LOOP_Idle();
+    }
+}
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,68 @@
+/*******************************************************************************
+  Simulated System Header
+
+  File Name:
+    sim_system.h
+
+  Summary:
+    The whole firmware on the simulated board: reset, SYS_Initialize() and
+    the main loop of src/main.c.
+*******************************************************************************/
+
+#ifndef _SIM_SYSTEM_H
+#define _SIM_SYSTEM_H
+
+#include <stdbool.h>
+#include "sim_core.h"
+#include "sim_accel.h"
+#include "sim_usb.h"
+
+typedef struct
+{
+    /* Samples of the accelerometer */
+    SIM_ACCEL_SOURCE source;
+    uintptr_t sourceContext;
+
+    SIM_USB_CONFIG usb;
+
+    /* Whether the firmware's code takes time, see SIM_COST */
+    bool costs;
+
+} SIM_SYSTEM_CONFIG;
+
+/* Default USB host, cost model off, no source */
+void SIM_SYSTEM_ConfigDefault ( SIM_SYSTEM_CONFIG * config );
+
+/*******************************************************************************
+  Function:
+    void SIM_SYSTEM_Start ( const SIM_SYSTEM_CONFIG * config )
+
+  Summary:
+    Resets the simulation and runs SYS_Initialize().
+
+  Remarks:
+    Once per process.  The firmware's static data starts out cleared only
+    the first time, as the device's RAM does after a reset, and the modules
+    do not clear it again.
+*/
+
+void SIM_SYSTEM_Start ( const SIM_SYSTEM_CONFIG * config );
+
+/*******************************************************************************
+  Function:
+    void SIM_SYSTEM_RunUntil ( SIM_TIME time )
+
+  Summary:
+    Runs passes of the main loop until time.
+
+  Remarks:
+    Each pass takes at least one core timer tick, so that a polling run
+    loop moves time on without the cost model as well.
+*/
+
+void SIM_SYSTEM_RunUntil ( SIM_TIME time );
+
+#endif /* _SIM_SYSTEM_H */
+/*******************************************************************************
+ End of File
+ */
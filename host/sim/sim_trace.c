@@ -0,0 +1,249 @@
+/*******************************************************************************
+  Sensor Trace
+
+  File Name:
+    sim_trace.c
+
+  Summary:
+    "ACCT" sensor trace reader, writer and replay source.
+
+  Description:
+    See sim_trace.h.  The coding follows TraceWriter and read_trace() of
+    tools/sensor_capture.py step for step.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "sim_trace.h"
+
+#define SIM_TRACE_MAGIC         "ACCT"
+#define SIM_TRACE_VERSION       1
+#define SIM_TRACE_HEADER_BYTES  16
+
+/* Sequence number the first record is coded against */
+#define SIM_TRACE_SEQUENCE_START 0xFFFF
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t _SIM_TRACE_Zigzag ( int32_t value )
+{
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int32_t _SIM_TRACE_Unzigzag ( uint32_t value )
+{
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+static void _SIM_TRACE_VarintPut ( FILE * file, uint32_t value )
+{
+    while(value >= 0x80)
+    {
+        fputc((int)((value & 0x7F) | 0x80), file);
+        value >>= 7;
+    }
+    fputc((int)value, file);
+}
+
+static bool _SIM_TRACE_VarintGet ( FILE * file, uint32_t * value )
+{
+    unsigned int shift = 0;
+    int byte;
+
+    *value = 0;
+    do
+    {
+        byte = fgetc(file);
+        if((byte == EOF) || (shift > 28))
+        {
+            return false;
+        }
+        *value |= (uint32_t)(byte & 0x7F) << shift;
+        shift += 7;
+    } while(byte & 0x80);
+    return true;
+}
+
+static uint32_t _SIM_TRACE_Get32 ( const uint8_t * data )
+{
+    return data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+static void _SIM_TRACE_Put32 ( uint8_t * data, uint32_t value )
+{
+    data[0] = (uint8_t)value;
+    data[1] = (uint8_t)(value >> 8);
+    data[2] = (uint8_t)(value >> 16);
+    data[3] = (uint8_t)(value >> 24);
+}
+
+/* Core timer ticks of one sample period */
+static uint32_t _SIM_TRACE_Period ( const SIM_TRACE * trace )
+{
+    return trace->tickHz / trace->odrHz;
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Trace Functions
+// *****************************************************************************
+// *****************************************************************************
+
+bool SIM_TRACE_Open ( SIM_TRACE * trace, const char * path )
+{
+    uint8_t header[SIM_TRACE_HEADER_BYTES];
+
+    memset(trace, 0, sizeof(*trace));
+    trace->file = fopen(path, "rb");
+    if(trace->file == NULL)
+    {
+        return false;
+    }
+    if((fread(header, 1, sizeof(header), trace->file) != sizeof(header)) ||
+       (memcmp(header, SIM_TRACE_MAGIC, 4) != 0) ||
+       (header[4] != SIM_TRACE_VERSION))
+    {
+        SIM_TRACE_Close(trace);
+        return false;
+    }
+    trace->tickHz = _SIM_TRACE_Get32(&header[8]);
+    trace->odrHz = header[12] | (header[13] << 8);
+    if((trace->odrHz == 0) || (trace->tickHz < trace->odrHz))
+    {
+        SIM_TRACE_Close(trace);
+        return false;
+    }
+
+    /* The extended sequence number before the first record is -1 */
+    trace->record.sequence = UINT32_MAX;
+    return true;
+}
+
+bool SIM_TRACE_Read ( SIM_TRACE * trace, SIM_TRACE_RECORD * record )
+{
+    uint32_t step;
+    uint32_t jitter;
+    uint32_t change[3];
+
+    if(!_SIM_TRACE_VarintGet(trace->file, &step) ||
+       !_SIM_TRACE_VarintGet(trace->file, &jitter) ||
+       !_SIM_TRACE_VarintGet(trace->file, &change[0]) ||
+       !_SIM_TRACE_VarintGet(trace->file, &change[1]) ||
+       !_SIM_TRACE_VarintGet(trace->file, &change[2]))
+    {
+        return false;
+    }
+    step ++;
+
+    trace->record.sequence += step;
+    if(trace->started)
+    {
+        trace->record.ticks += (int64_t)step * _SIM_TRACE_Period(trace) +
+                               _SIM_TRACE_Unzigzag(jitter);
+    }
+    trace->started = true;
+    trace->record.sample.x += _SIM_TRACE_Unzigzag(change[0]);
+    trace->record.sample.y += _SIM_TRACE_Unzigzag(change[1]);
+    trace->record.sample.z += _SIM_TRACE_Unzigzag(change[2]);
+
+    *record = trace->record;
+    return true;
+}
+
+bool SIM_TRACE_Create ( SIM_TRACE * trace, const char * path,
+                        uint32_t tickHz, uint16_t odrHz )
+{
+    uint8_t header[SIM_TRACE_HEADER_BYTES] = { 0 };
+
+    memset(trace, 0, sizeof(*trace));
+    trace->file = fopen(path, "wb");
+    if(trace->file == NULL)
+    {
+        return false;
+    }
+    trace->tickHz = tickHz;
+    trace->odrHz = odrHz;
+    trace->sequence = SIM_TRACE_SEQUENCE_START;
+
+    memcpy(header, SIM_TRACE_MAGIC, 4);
+    header[4] = SIM_TRACE_VERSION;
+    _SIM_TRACE_Put32(&header[8], tickHz);
+    header[12] = (uint8_t)odrHz;
+    header[13] = (uint8_t)(odrHz >> 8);
+    return (fwrite(header, 1, sizeof(header), trace->file) == sizeof(header));
+}
+
+void SIM_TRACE_Write ( SIM_TRACE * trace, uint16_t sequence, uint32_t time,
+                       const SIM_ACCEL_SAMPLE * sample )
+{
+    uint32_t step = (uint16_t)(sequence - trace->sequence);
+
+    if(step == 0)
+    {
+        step = 0x10000;
+    }
+    _SIM_TRACE_VarintPut(trace->file, step - 1);
+    _SIM_TRACE_VarintPut(trace->file, _SIM_TRACE_Zigzag(
+            (int32_t)(time - trace->time - step * _SIM_TRACE_Period(trace))));
+    _SIM_TRACE_VarintPut(trace->file, _SIM_TRACE_Zigzag(sample->x - trace->sample.x));
+    _SIM_TRACE_VarintPut(trace->file, _SIM_TRACE_Zigzag(sample->y - trace->sample.y));
+    _SIM_TRACE_VarintPut(trace->file, _SIM_TRACE_Zigzag(sample->z - trace->sample.z));
+
+    trace->sequence = sequence;
+    trace->time = time;
+    trace->sample = *sample;
+}
+
+void SIM_TRACE_Close ( SIM_TRACE * trace )
+{
+    if(trace->file != NULL)
+    {
+        fclose(trace->file);
+        trace->file = NULL;
+    }
+}
+
+bool SIM_TRACE_ReplayStart ( SIM_TRACE * trace )
+{
+    trace->nextValid = SIM_TRACE_Read(trace, &trace->next);
+    trace->position = trace->next.sequence;
+    trace->held = trace->next.sample;
+    return trace->nextValid;
+}
+
+bool SIM_TRACE_Source ( uintptr_t context, SIM_ACCEL_SAMPLE * sample,
+                        SIM_TIME * interval )
+{
+    SIM_TRACE * trace = (SIM_TRACE *)context;
+
+    if(trace->nextValid && (trace->next.sequence == trace->position))
+    {
+        trace->held = trace->next.sample;
+        trace->nextValid = SIM_TRACE_Read(trace, &trace->next);
+    }
+    else if(!trace->nextValid)
+    {
+        /* The last record has been produced */
+        return false;
+    }
+
+    *sample = trace->held;
+    trace->position ++;
+    return true;
+}
+
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,119 @@
+/*******************************************************************************
+  Sensor Trace Header
+
+  File Name:
+    sim_trace.h
+
+  Summary:
+    Reads and writes the "ACCT" sensor traces of tools/sensor_capture.py,
+    and replays one as the samples of the simulated LSM303D.
+
+  Description:
+    The file format is described in tools/sensor_capture.py.  A trace
+    holds the samples the firmware took from its sample queue, with their
+    sequence numbers, as CAPTURE_ENABLE streams them.
+
+    The replay is paced by the simulated sensor, one record per sample
+    period in sequence order, not by the recorded timestamps: those are the
+    firmware's, taken when it drained the FIFO.  A sequence number the
+    trace skips, a sample the device dropped or decimated away, repeats the
+    sample before it.  The firmware then reads the samples in the order and
+    at the rate it did on the board, only as fast as the simulation runs.
+*******************************************************************************/
+
+#ifndef _SIM_TRACE_H
+#define _SIM_TRACE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "sim_accel.h"
+
+typedef struct
+{
+    /* Sequence number, extended so that it never wraps */
+    uint32_t sequence;
+
+    /* Core timer ticks since the first record's timestamp */
+    uint64_t ticks;
+
+    SIM_ACCEL_SAMPLE sample;
+
+} SIM_TRACE_RECORD;
+
+typedef struct
+{
+    FILE * file;
+
+    /* From the header */
+    uint32_t tickHz;
+    uint16_t odrHz;
+
+    /* The previous record, which the next one is coded against */
+    uint16_t sequence;
+    uint32_t time;
+    SIM_ACCEL_SAMPLE sample;
+
+    /* Reading: the previous record as returned, and whether there is one */
+    SIM_TRACE_RECORD record;
+    bool started;
+
+    /* Replay: the record due next, the sample produced last and the
+       sequence number of the sample produced next */
+    SIM_TRACE_RECORD next;
+    bool nextValid;
+    SIM_ACCEL_SAMPLE held;
+    uint32_t position;
+
+} SIM_TRACE;
+
+/* Opens a trace for reading. False if it is not a version 1 trace. */
+bool SIM_TRACE_Open ( SIM_TRACE * trace, const char * path );
+
+/* Reads the next record. False at the end of the trace. */
+bool SIM_TRACE_Read ( SIM_TRACE * trace, SIM_TRACE_RECORD * record );
+
+/* Creates a trace for writing and writes its header */
+bool SIM_TRACE_Create ( SIM_TRACE * trace, const char * path,
+                        uint32_t tickHz, uint16_t odrHz );
+
+/* Appends a sample as the capture feature report delivers it */
+void SIM_TRACE_Write ( SIM_TRACE * trace, uint16_t sequence, uint32_t time,
+                       const SIM_ACCEL_SAMPLE * sample );
+
+void SIM_TRACE_Close ( SIM_TRACE * trace );
+
+/*******************************************************************************
+  Function:
+    bool SIM_TRACE_ReplayStart ( SIM_TRACE * trace )
+
+  Summary:
+    Reads the first record of a trace just opened for SIM_TRACE_Source().
+
+  Remarks:
+    False if the trace is empty.  held is the first sample from then on
+    until the replay moves past it.
+*/
+
+bool SIM_TRACE_ReplayStart ( SIM_TRACE * trace );
+
+/*******************************************************************************
+  Function:
+    bool SIM_TRACE_Source ( uintptr_t context, SIM_ACCEL_SAMPLE * sample,
+                            SIM_TIME * interval )
+
+  Summary:
+    SIM_ACCEL_SOURCE that replays the trace at (SIM_TRACE *)context, from
+    SIM_TRACE_ReplayStart() on.
+
+  Remarks:
+    Stops the sensor after the last record.
+*/
+
+bool SIM_TRACE_Source ( uintptr_t context, SIM_ACCEL_SAMPLE * sample,
+                        SIM_TIME * interval );
+
+#endif /* _SIM_TRACE_H */
+/*******************************************************************************
+ End of File
+ */
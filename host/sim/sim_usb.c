@@ -0,0 +1,776 @@
+/*******************************************************************************
+  Simulated USB Host and Device Layer
+
+  File Name:
+    sim_usb.c
+
+  Summary:
+    A full or high speed host polling the mouse, and the Harmony device
+    layer and HID function driver the firmware talks to.
+
+  Description:
+    See sim_usb.h.  The host side runs as scheduled events, which queue
+    what the device layer has to tell the firmware and raise the USB
+    interrupt.  USB_DEVICE_Tasks_ISR() then calls the firmware's handlers
+    for everything queued, in order.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "system_config.h"
+#include "usb/usb_device.h"
+#include "usb/usb_device_hid.h"
+#include "sim_core.h"
+#include "sim_usb.h"
+
+#define SIM_USB_ITEMS_MAX       32
+#define SIM_USB_SEND_QUEUE_MAX  8
+
+/* Bus reset and SET_CONFIGURATION after the attach */
+#define SIM_USB_RESET_DELAY     SIM_USB_FRAME_TICKS
+#define SIM_USB_CONFIGURE_DELAY (2 * SIM_USB_FRAME_TICKS)
+
+#define SIM_USB_OBJECT          ((SYS_MODULE_OBJ)1)
+#define SIM_USB_HANDLE          ((USB_DEVICE_HANDLE)1)
+
+const int usbDeviceHIDFunctionDriver = 0;
+
+/* What the device layer has to tell the firmware from the USB interrupt */
+typedef enum
+{
+    SIM_USB_ITEM_POWER_DETECTED,
+    SIM_USB_ITEM_RESET,
+    SIM_USB_ITEM_CONFIGURED,
+    SIM_USB_ITEM_SOF,
+    SIM_USB_ITEM_REPORT_SENT,
+    SIM_USB_ITEM_SETUP,
+    SIM_USB_ITEM_CONTROL_PACKET,
+    SIM_USB_ITEM_CONTROL_STATUS
+
+} SIM_USB_ITEM_TYPE;
+
+typedef struct
+{
+    SIM_USB_ITEM_TYPE type;
+    uint32_t value;
+
+} SIM_USB_ITEM;
+
+typedef enum
+{
+    SIM_USB_CONTROL_IDLE,
+
+    /* Waiting for the firmware to answer the setup packet */
+    SIM_USB_CONTROL_SETUP,
+
+    /* Data stage of a control read, then the host's status packet */
+    SIM_USB_CONTROL_DATA_IN,
+    SIM_USB_CONTROL_STATUS_OUT,
+
+    /* Status stage of a control write without data */
+    SIM_USB_CONTROL_STATUS_IN
+
+} SIM_USB_CONTROL_STATE;
+
+/* Report queued with USB_DEVICE_HID_ReportSend(), an IRP in Harmony */
+typedef struct
+{
+    bool inUse;
+    uint8_t * data;
+    size_t length;
+    SIM_TIME stamp;
+
+} SIM_USB_IRP;
+
+static struct
+{
+    SIM_USB_CONFIG config;
+    SIM_USB_STATS stats;
+
+    /* Device layer */
+    bool initialized;
+    bool powered;
+    bool attached;
+    bool configured;
+    USB_DEVICE_EVENT_HANDLER eventHandler;
+    uintptr_t eventContext;
+    const USB_DEVICE_HID_INIT * hidInit;
+    USB_DEVICE_HID_EVENT_HANDLER hidHandler;
+    uintptr_t hidContext;
+
+    /* Events for the USB interrupt */
+    SIM_USB_ITEM items[SIM_USB_ITEMS_MAX];
+    unsigned int itemHead;
+    unsigned int itemCount;
+
+    /* Bus */
+    SIM_EVENT busEvent;
+    SIM_EVENT frameEvent;
+    SIM_EVENT pollEvent;
+    SIM_TIME frameTicks;
+    SIM_TIME frameStart;
+    uint16_t frameNumber;
+
+    /* IN tokens the host had scheduled, pollSkip counts them */
+    uint32_t pollsDue;
+
+    /* Interrupt IN endpoint: the IRPs, and the order they were queued in */
+    SIM_USB_IRP irp[SIM_USB_SEND_QUEUE_MAX];
+    unsigned int sendOrder[SIM_USB_SEND_QUEUE_MAX];
+    unsigned int sendHead;
+    unsigned int sendCount;
+
+    /* Endpoint 0 */
+    SIM_USB_CONTROL_STATE controlState;
+    SIM_EVENT controlEvent;
+    uint8_t setupType;
+    union
+    {
+        USB_DEVICE_HID_EVENT_DATA_GET_REPORT getReport;
+        USB_DEVICE_HID_EVENT_DATA_SET_IDLE setIdle;
+        USB_DEVICE_HID_EVENT_DATA_GET_IDLE getIdle;
+        USB_HID_PROTOCOL_CODE protocol;
+    } setup;
+    uint8_t * hostBuffer;
+    size_t requested;
+    const uint8_t * deviceData;
+    size_t deviceLength;
+    size_t moved;
+    bool packetLoaded;
+    bool lastPacketShort;
+    bool stalled;
+    bool controlDone;
+
+} simUsb;
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Queues an event for the firmware and raises the USB interrupt */
+static void _SIM_USB_ItemPut ( SIM_USB_ITEM_TYPE type, uint32_t value )
+{
+    SIM_USB_ITEM * item;
+
+    if(simUsb.itemCount == SIM_USB_ITEMS_MAX)
+    {
+        fprintf(stderr, "sim: more than %d USB events pending\n", SIM_USB_ITEMS_MAX);
+        abort();
+    }
+    item = &simUsb.items[(simUsb.itemHead + simUsb.itemCount) % SIM_USB_ITEMS_MAX];
+    item->type = type;
+    item->value = value;
+    simUsb.itemCount ++;
+    SIM_CORE_InterruptRequest(INT_SOURCE_USB_1);
+}
+
+static void _SIM_USB_DeviceEvent ( USB_DEVICE_EVENT event, void * data )
+{
+    if(simUsb.eventHandler != NULL)
+    {
+        simUsb.eventHandler(event, data, simUsb.eventContext);
+    }
+}
+
+static void _SIM_USB_HidEvent ( USB_DEVICE_HID_EVENT event, void * data )
+{
+    if(simUsb.hidHandler != NULL)
+    {
+        simUsb.hidHandler(0, event, data, simUsb.hidContext);
+    }
+}
+
+/* Forgets the queued reports, as a bus reset aborts them */
+static void _SIM_USB_SendQueueFlush ( void )
+{
+    unsigned int index;
+
+    for(index = 0; index < SIM_USB_SEND_QUEUE_MAX; index ++)
+    {
+        simUsb.irp[index].inUse = false;
+    }
+    simUsb.sendHead = 0;
+    simUsb.sendCount = 0;
+}
+
+static void _SIM_USB_ControlEnd ( bool stalled )
+{
+    SIM_CORE_EventCancel(&simUsb.controlEvent);
+    simUsb.controlState = SIM_USB_CONTROL_IDLE;
+    simUsb.stalled = stalled;
+    simUsb.controlDone = true;
+}
+
+static void _SIM_USB_Poll ( uintptr_t context )
+{
+    SIM_USB_IRP * irp;
+    unsigned int slot;
+
+    simUsb.stats.polls ++;
+    if(simUsb.sendCount == 0)
+    {
+        simUsb.stats.naks ++;
+        return;
+    }
+
+    /* The controller reads the buffer as the packet goes out */
+    slot = simUsb.sendOrder[simUsb.sendHead];
+    simUsb.sendHead = (simUsb.sendHead + 1) % SIM_USB_SEND_QUEUE_MAX;
+    simUsb.sendCount --;
+    irp = &simUsb.irp[slot];
+    simUsb.stats.reports ++;
+    if(simUsb.config.reportHandler != NULL)
+    {
+        simUsb.config.reportHandler(simUsb.config.reportContext, irp->data,
+                irp->length, irp->stamp, SIM_CORE_Now());
+    }
+    _SIM_USB_ItemPut(SIM_USB_ITEM_REPORT_SENT, slot);
+}
+
+static void _SIM_USB_Frame ( uintptr_t context )
+{
+    simUsb.frameStart = SIM_CORE_Now();
+    simUsb.frameNumber = (simUsb.frameNumber + 1) & 0x7FF;
+    simUsb.stats.frames ++;
+#ifdef USB_DEVICE_SOF_EVENT_ENABLE
+    _SIM_USB_ItemPut(SIM_USB_ITEM_SOF, simUsb.frameNumber);
+#endif
+
+    if(simUsb.configured && ((simUsb.frameNumber % simUsb.config.interval) == 0))
+    {
+        simUsb.pollsDue ++;
+        if((simUsb.config.pollSkip != 0) && ((simUsb.pollsDue % simUsb.config.pollSkip) == 0))
+        {
+            simUsb.stats.skipped ++;
+        }
+        else
+        {
+            SIM_CORE_EventSchedule(&simUsb.pollEvent,
+                    simUsb.frameStart + simUsb.config.pollOffset, _SIM_USB_Poll, 0);
+        }
+    }
+    SIM_CORE_EventSchedule(&simUsb.frameEvent,
+            simUsb.frameStart + simUsb.frameTicks, _SIM_USB_Frame, 0);
+}
+
+static void _SIM_USB_Configure ( uintptr_t context )
+{
+    _SIM_USB_ItemPut(SIM_USB_ITEM_CONFIGURED, 1);
+}
+
+static void _SIM_USB_BusReset ( uintptr_t context )
+{
+    _SIM_USB_ItemPut(SIM_USB_ITEM_RESET, 0);
+
+    /* Frames start with the end of the reset */
+    simUsb.frameNumber = 0x7FF;
+    SIM_CORE_EventSchedule(&simUsb.frameEvent, SIM_CORE_Now() + simUsb.frameTicks,
+            _SIM_USB_Frame, 0);
+    SIM_CORE_EventSchedule(&simUsb.busEvent, SIM_CORE_Now() + SIM_USB_CONFIGURE_DELAY,
+            _SIM_USB_Configure, 0);
+}
+
+/* Host side of each control transfer stage */
+static void _SIM_USB_ControlStep ( uintptr_t context )
+{
+    size_t total;
+    size_t size;
+
+    switch(simUsb.controlState)
+    {
+        case SIM_USB_CONTROL_DATA_IN:
+
+            if(!simUsb.packetLoaded)
+            {
+                /* NAK, the interrupt has not loaded the next packet yet */
+                break;
+            }
+            total = (simUsb.deviceLength < simUsb.requested) ?
+                    simUsb.deviceLength : simUsb.requested;
+            size = total - simUsb.moved;
+            if(size > USB_DEVICE_EP0_BUFFER_SIZE)
+            {
+                size = USB_DEVICE_EP0_BUFFER_SIZE;
+            }
+            memcpy(&simUsb.hostBuffer[simUsb.moved], &simUsb.deviceData[simUsb.moved], size);
+            simUsb.moved += size;
+            simUsb.lastPacketShort = (size < USB_DEVICE_EP0_BUFFER_SIZE);
+            simUsb.packetLoaded = false;
+            simUsb.stats.controlPackets ++;
+            _SIM_USB_ItemPut(SIM_USB_ITEM_CONTROL_PACKET, 0);
+            break;
+
+        case SIM_USB_CONTROL_STATUS_OUT:
+        case SIM_USB_CONTROL_STATUS_IN:
+
+            simUsb.stats.controlPackets ++;
+            _SIM_USB_ItemPut(SIM_USB_ITEM_CONTROL_STATUS, 0);
+            break;
+
+        default:
+            return;
+    }
+    SIM_CORE_EventSchedule(&simUsb.controlEvent,
+            SIM_CORE_Now() + simUsb.config.controlPacketSpacing, _SIM_USB_ControlStep, 0);
+}
+
+static bool _SIM_USB_ControlStart ( uint8_t type, uint8_t * buffer, size_t length )
+{
+    if(!simUsb.configured || (simUsb.controlState != SIM_USB_CONTROL_IDLE))
+    {
+        return false;
+    }
+    simUsb.setupType = type;
+    simUsb.hostBuffer = buffer;
+    simUsb.requested = length;
+    simUsb.moved = 0;
+    simUsb.controlDone = false;
+    simUsb.stalled = false;
+    simUsb.controlState = SIM_USB_CONTROL_SETUP;
+    simUsb.stats.controlTransfers ++;
+    simUsb.stats.controlPackets ++;
+    _SIM_USB_ItemPut(SIM_USB_ITEM_SETUP, type);
+    return true;
+}
+
+/* Device side of a control transfer packet, in the USB interrupt */
+static void _SIM_USB_ControlPacketDone ( void )
+{
+    size_t total = (simUsb.deviceLength < simUsb.requested) ?
+                   simUsb.deviceLength : simUsb.requested;
+
+    if((simUsb.moved == total) &&
+       (simUsb.lastPacketShort || (simUsb.moved == simUsb.requested)))
+    {
+        /* Data stage over, the host sends its zero length status packet */
+        simUsb.controlState = SIM_USB_CONTROL_STATUS_OUT;
+    }
+    simUsb.packetLoaded = true;
+}
+
+static void _SIM_USB_ItemHandle ( const SIM_USB_ITEM * item )
+{
+    USB_DEVICE_EVENT_DATA_SOF sof;
+    USB_DEVICE_EVENT_DATA_CONFIGURED configured;
+    USB_DEVICE_HID_EVENT_DATA_REPORT_SENT sent;
+    SIM_USB_IRP * irp;
+
+    switch(item->type)
+    {
+        case SIM_USB_ITEM_POWER_DETECTED:
+            SIM_CORE_Charge(SIM_CORE_CostGet()->usbEvent);
+            _SIM_USB_DeviceEvent(USB_DEVICE_EVENT_POWER_DETECTED, NULL);
+            break;
+
+        case SIM_USB_ITEM_RESET:
+            SIM_CORE_Charge(SIM_CORE_CostGet()->usbEvent);
+            simUsb.configured = false;
+            simUsb.hidHandler = NULL;
+            _SIM_USB_SendQueueFlush();
+            _SIM_USB_DeviceEvent(USB_DEVICE_EVENT_RESET, NULL);
+            break;
+
+        case SIM_USB_ITEM_CONFIGURED:
+            SIM_CORE_Charge(SIM_CORE_CostGet()->usbEvent);
+            simUsb.configured = true;
+            configured.configurationValue = (uint8_t)item->value;
+            _SIM_USB_DeviceEvent(USB_DEVICE_EVENT_CONFIGURED, &configured);
+            break;
+
+        case SIM_USB_ITEM_SOF:
+            SIM_CORE_Charge(SIM_CORE_CostGet()->usbEvent);
+            sof.frameNumber = (uint16_t)item->value;
+            _SIM_USB_DeviceEvent(USB_DEVICE_EVENT_SOF, &sof);
+            break;
+
+        case SIM_USB_ITEM_REPORT_SENT:
+            SIM_CORE_Charge(SIM_CORE_CostGet()->usbEvent);
+
+            /* As in Harmony, the IRP is free again before the callback */
+            irp = &simUsb.irp[item->value];
+            irp->inUse = false;
+            sent.handle = (USB_DEVICE_HID_TRANSFER_HANDLE)irp;
+            sent.length = irp->length;
+            _SIM_USB_HidEvent(USB_DEVICE_HID_EVENT_REPORT_SENT, &sent);
+            break;
+
+        case SIM_USB_ITEM_SETUP:
+            SIM_CORE_Charge(SIM_CORE_CostGet()->usbControlPacket);
+            switch(item->value)
+            {
+                case USB_DEVICE_HID_EVENT_GET_REPORT:
+                    _SIM_USB_HidEvent(USB_DEVICE_HID_EVENT_GET_REPORT, &simUsb.setup.getReport);
+                    break;
+                case USB_DEVICE_HID_EVENT_SET_IDLE:
+                    _SIM_USB_HidEvent(USB_DEVICE_HID_EVENT_SET_IDLE, &simUsb.setup.setIdle);
+                    break;
+                case USB_DEVICE_HID_EVENT_GET_IDLE:
+                    _SIM_USB_HidEvent(USB_DEVICE_HID_EVENT_GET_IDLE, &simUsb.setup.getIdle);
+                    break;
+                case USB_DEVICE_HID_EVENT_SET_PROTOCOL:
+                    _SIM_USB_HidEvent(USB_DEVICE_HID_EVENT_SET_PROTOCOL, &simUsb.setup.protocol);
+                    break;
+                case USB_DEVICE_HID_EVENT_GET_PROTOCOL:
+                    _SIM_USB_HidEvent(USB_DEVICE_HID_EVENT_GET_PROTOCOL, NULL);
+                    break;
+                default:
+                    break;
+            }
+            break;
+
+        case SIM_USB_ITEM_CONTROL_PACKET:
+            SIM_CORE_Charge(SIM_CORE_CostGet()->usbControlPacket);
+            _SIM_USB_ControlPacketDone();
+            break;
+
+        case SIM_USB_ITEM_CONTROL_STATUS:
+            SIM_CORE_Charge(SIM_CORE_CostGet()->usbControlPacket);
+            if(simUsb.controlState == SIM_USB_CONTROL_STATUS_OUT)
+            {
+                _SIM_USB_HidEvent(USB_DEVICE_HID_EVENT_CONTROL_TRANSFER_DATA_SENT, NULL);
+            }
+            _SIM_USB_ControlEnd(false);
+            break;
+    }
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: USB Device Layer
+// *****************************************************************************
+// *****************************************************************************
+
+SYS_MODULE_OBJ USB_DEVICE_Initialize ( const SYS_MODULE_INDEX index,
+                                       const SYS_MODULE_INIT * const init )
+{
+    const USB_DEVICE_INIT * deviceInit = (const USB_DEVICE_INIT *)init;
+    const USB_DEVICE_FUNCTION_REGISTRATION_TABLE * function;
+
+    if((index != USB_DEVICE_INDEX_0) || (deviceInit->registeredFuncCount != 1))
+    {
+        return SYS_MODULE_OBJ_INVALID;
+    }
+    function = &deviceInit->registeredFunctions[0];
+    if(function->driver != (void *)USB_DEVICE_HID_FUNCTION_DRIVER)
+    {
+        return SYS_MODULE_OBJ_INVALID;
+    }
+    simUsb.hidInit = (const USB_DEVICE_HID_INIT *)function->funcDriverInit;
+    if(simUsb.hidInit->queueSizeReportSend > SIM_USB_SEND_QUEUE_MAX)
+    {
+        fprintf(stderr, "sim: more than %d reports queued\n", SIM_USB_SEND_QUEUE_MAX);
+        abort();
+    }
+
+    SYS_INT_SourceStatusClear(deviceInit->interruptSource);
+    SYS_INT_SourceEnable(deviceInit->interruptSource);
+    simUsb.initialized = true;
+    return SIM_USB_OBJECT;
+}
+
+void USB_DEVICE_Tasks ( SYS_MODULE_OBJ object )
+{
+    SIM_CORE_Charge(SIM_CORE_CostGet()->harmonyTasks);
+}
+
+void USB_DEVICE_Tasks_ISR ( SYS_MODULE_OBJ object )
+{
+    SYS_INT_SourceStatusClear(INT_SOURCE_USB_1);
+    while(simUsb.itemCount > 0)
+    {
+        SIM_USB_ITEM item = simUsb.items[simUsb.itemHead];
+
+        simUsb.itemHead = (simUsb.itemHead + 1) % SIM_USB_ITEMS_MAX;
+        simUsb.itemCount --;
+        _SIM_USB_ItemHandle(&item);
+    }
+}
+
+USB_DEVICE_HANDLE USB_DEVICE_Open ( const SYS_MODULE_INDEX index,
+                                    const DRV_IO_INTENT intent )
+{
+    return simUsb.initialized ? SIM_USB_HANDLE : USB_DEVICE_HANDLE_INVALID;
+}
+
+void USB_DEVICE_EventHandlerSet ( USB_DEVICE_HANDLE handle,
+                                  const USB_DEVICE_EVENT_HANDLER callBackFunc,
+                                  uintptr_t context )
+{
+    simUsb.eventHandler = callBackFunc;
+    simUsb.eventContext = context;
+
+    /* VBUS is there from the start */
+    if(!simUsb.powered)
+    {
+        simUsb.powered = true;
+        _SIM_USB_ItemPut(SIM_USB_ITEM_POWER_DETECTED, 0);
+    }
+}
+
+void USB_DEVICE_Attach ( USB_DEVICE_HANDLE handle )
+{
+    if(simUsb.attached)
+    {
+        return;
+    }
+    simUsb.attached = true;
+    SIM_CORE_EventSchedule(&simUsb.busEvent, SIM_CORE_Now() + SIM_USB_RESET_DELAY,
+            _SIM_USB_BusReset, 0);
+}
+
+USB_SPEED USB_DEVICE_ActiveSpeedGet ( USB_DEVICE_HANDLE handle )
+{
+    return simUsb.config.highSpeed ? USB_SPEED_HIGH : USB_SPEED_FULL;
+}
+
+void USB_DEVICE_Detach ( USB_DEVICE_HANDLE handle )
+{
+    simUsb.attached = false;
+    simUsb.configured = false;
+    SIM_CORE_EventCancel(&simUsb.busEvent);
+    SIM_CORE_EventCancel(&simUsb.frameEvent);
+    SIM_CORE_EventCancel(&simUsb.pollEvent);
+    _SIM_USB_SendQueueFlush();
+}
+
+USB_DEVICE_CONTROL_TRANSFER_RESULT USB_DEVICE_ControlSend
+(
+    USB_DEVICE_HANDLE handle,
+    void * data,
+    size_t length
+)
+{
+    if(simUsb.controlState != SIM_USB_CONTROL_SETUP)
+    {
+        return USB_DEVICE_CONTROL_TRANSFER_RESULT_FAILED;
+    }
+    simUsb.deviceData = data;
+    simUsb.deviceLength = length;
+    simUsb.packetLoaded = true;
+    simUsb.lastPacketShort = false;
+    simUsb.controlState = SIM_USB_CONTROL_DATA_IN;
+    SIM_CORE_EventSchedule(&simUsb.controlEvent,
+            SIM_CORE_Now() + simUsb.config.controlPacketSpacing, _SIM_USB_ControlStep, 0);
+    return USB_DEVICE_CONTROL_TRANSFER_RESULT_SUCCESS;
+}
+
+USB_DEVICE_CONTROL_TRANSFER_RESULT USB_DEVICE_ControlReceive
+(
+    USB_DEVICE_HANDLE handle,
+    void * data,
+    size_t length
+)
+{
+    /* The simulated host has no control write with a data stage */
+    return USB_DEVICE_CONTROL_TRANSFER_RESULT_FAILED;
+}
+
+USB_DEVICE_CONTROL_TRANSFER_RESULT USB_DEVICE_ControlStatus
+(
+    USB_DEVICE_HANDLE handle,
+    USB_DEVICE_CONTROL_STATUS status
+)
+{
+    if(simUsb.controlState != SIM_USB_CONTROL_SETUP)
+    {
+        return USB_DEVICE_CONTROL_TRANSFER_RESULT_FAILED;
+    }
+    if(status == USB_DEVICE_CONTROL_STATUS_ERROR)
+    {
+        /* The host sees the STALL on its next token */
+        _SIM_USB_ControlEnd(true);
+    }
+    else
+    {
+        simUsb.controlState = SIM_USB_CONTROL_STATUS_IN;
+        SIM_CORE_EventSchedule(&simUsb.controlEvent,
+                SIM_CORE_Now() + simUsb.config.controlPacketSpacing,
+                _SIM_USB_ControlStep, 0);
+    }
+    return USB_DEVICE_CONTROL_TRANSFER_RESULT_SUCCESS;
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: USB HID Function Driver
+// *****************************************************************************
+// *****************************************************************************
+
+USB_DEVICE_HID_RESULT USB_DEVICE_HID_EventHandlerSet
+(
+    USB_DEVICE_HID_INDEX instanceIndex,
+    USB_DEVICE_HID_EVENT_HANDLER eventHandler,
+    uintptr_t context
+)
+{
+    if(instanceIndex != 0)
+    {
+        return USB_DEVICE_HID_RESULT_ERROR_INSTANCE_INVALID;
+    }
+    simUsb.hidHandler = eventHandler;
+    simUsb.hidContext = context;
+    return USB_DEVICE_HID_RESULT_OK;
+}
+
+USB_DEVICE_HID_RESULT USB_DEVICE_HID_ReportSend
+(
+    USB_DEVICE_HID_INDEX instanceIndex,
+    USB_DEVICE_HID_TRANSFER_HANDLE * transferHandle,
+    uint8_t * buffer,
+    size_t size
+)
+{
+    bool interrupts;
+    unsigned int slot;
+
+    SIM_CORE_Charge(SIM_CORE_CostGet()->usbReportSend);
+    *transferHandle = USB_DEVICE_HID_TRANSFER_HANDLE_INVALID;
+    if(instanceIndex != 0)
+    {
+        return USB_DEVICE_HID_RESULT_ERROR_INSTANCE_INVALID;
+    }
+    if(!simUsb.configured)
+    {
+        return USB_DEVICE_HID_RESULT_ERROR_INSTANCE_NOT_CONFIGURED;
+    }
+
+    /* The first free IRP, with the USB interrupt held off as Harmony does */
+    interrupts = SYS_INT_SourceDisable(INT_SOURCE_USB_1);
+    for(slot = 0; slot < simUsb.hidInit->queueSizeReportSend; slot ++)
+    {
+        if(!simUsb.irp[slot].inUse)
+        {
+            break;
+        }
+    }
+    if(slot == simUsb.hidInit->queueSizeReportSend)
+    {
+        simUsb.stats.refused ++;
+        if(interrupts)
+        {
+            SYS_INT_SourceEnable(INT_SOURCE_USB_1);
+        }
+        return USB_DEVICE_HID_RESULT_ERROR_TRANSFER_QUEUE_FULL;
+    }
+
+    simUsb.irp[slot].inUse = true;
+    simUsb.irp[slot].data = buffer;
+    simUsb.irp[slot].length = size;
+    simUsb.irp[slot].stamp = (simUsb.config.stamp != NULL) ?
+            simUsb.config.stamp() : SIM_CORE_Now();
+    simUsb.sendOrder[(simUsb.sendHead + simUsb.sendCount) % SIM_USB_SEND_QUEUE_MAX] = slot;
+    simUsb.sendCount ++;
+    simUsb.stats.queued ++;
+    *transferHandle = (USB_DEVICE_HID_TRANSFER_HANDLE)&simUsb.irp[slot];
+
+    if(interrupts)
+    {
+        SYS_INT_SourceEnable(INT_SOURCE_USB_1);
+    }
+    return USB_DEVICE_HID_RESULT_OK;
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Simulation Control
+// *****************************************************************************
+// *****************************************************************************
+
+void SIM_USB_ConfigDefault ( SIM_USB_CONFIG * config )
+{
+    config->highSpeed = false;
+    config->interval = 1;
+    config->pollOffset = SIM_US_TO_TICKS(50);
+    config->pollSkip = 0;
+    config->controlPacketSpacing = SIM_US_TO_TICKS(100);
+    config->stamp = NULL;
+    config->reportHandler = NULL;
+    config->reportContext = 0;
+}
+
+void SIM_USB_Reset ( const SIM_USB_CONFIG * config )
+{
+    memset(&simUsb, 0, sizeof(simUsb));
+    simUsb.config = *config;
+    if(simUsb.config.interval == 0)
+    {
+        simUsb.config.interval = 1;
+    }
+    simUsb.frameTicks = simUsb.config.highSpeed ?
+            SIM_USB_MICROFRAME_TICKS : SIM_USB_FRAME_TICKS;
+    simUsb.busEvent.slot = -1;
+    simUsb.frameEvent.slot = -1;
+    simUsb.pollEvent.slot = -1;
+    simUsb.controlEvent.slot = -1;
+    simUsb.controlState = SIM_USB_CONTROL_IDLE;
+    simUsb.controlDone = true;
+}
+
+bool SIM_USB_IsConfigured ( void )
+{
+    return simUsb.configured;
+}
+
+bool SIM_USB_GetReport ( uint8_t type, uint8_t id, uint8_t * buffer,
+                         size_t length )
+{
+    simUsb.setup.getReport.reportType = type;
+    simUsb.setup.getReport.reportID = id;
+    simUsb.setup.getReport.reportLength = (uint16_t)length;
+    return _SIM_USB_ControlStart(USB_DEVICE_HID_EVENT_GET_REPORT, buffer, length);
+}
+
+bool SIM_USB_SetIdle ( uint8_t duration, uint8_t id )
+{
+    simUsb.setup.setIdle.duration = duration;
+    simUsb.setup.setIdle.reportID = id;
+    return _SIM_USB_ControlStart(USB_DEVICE_HID_EVENT_SET_IDLE, NULL, 0);
+}
+
+bool SIM_USB_GetIdle ( uint8_t id, uint8_t * duration )
+{
+    simUsb.setup.getIdle.reportID = id;
+    return _SIM_USB_ControlStart(USB_DEVICE_HID_EVENT_GET_IDLE, duration, 1);
+}
+
+bool SIM_USB_SetProtocol ( uint8_t protocol )
+{
+    simUsb.setup.protocol = protocol;
+    return _SIM_USB_ControlStart(USB_DEVICE_HID_EVENT_SET_PROTOCOL, NULL, 0);
+}
+
+bool SIM_USB_GetProtocol ( uint8_t * protocol )
+{
+    return _SIM_USB_ControlStart(USB_DEVICE_HID_EVENT_GET_PROTOCOL, protocol, 1);
+}
+
+bool SIM_USB_ControlDone ( int * result )
+{
+    if(simUsb.controlDone && (result != NULL))
+    {
+        *result = simUsb.stalled ? -1 : (int)simUsb.moved;
+    }
+    return simUsb.controlDone;
+}
+
+const SIM_USB_STATS * SIM_USB_StatsGet ( void )
+{
+    return &simUsb.stats;
+}
+
+/*******************************************************************************
+ End of File
+ */
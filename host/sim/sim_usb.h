@@ -0,0 +1,150 @@
+/*******************************************************************************
+  Simulated USB Host and Device Layer Header
+
+  File Name:
+    sim_usb.h
+
+  Summary:
+    A full or high speed host polling the mouse, and the Harmony device
+    layer and HID function driver the firmware talks to.
+
+  Description:
+    Once the firmware has opened the device layer and attached, the host
+    resets the bus, sets configuration 1 and starts a frame every
+    millisecond, or a microframe every 125 us at high speed, each with its
+    SOF.  Every interval (micro)frames it sends an IN token to the
+    interrupt endpoint, pollOffset after the start of the frame, and takes
+    the oldest report queued by USB_DEVICE_HID_ReportSend() if there is
+    one.  Control requests are started from the simulation, one at a time;
+    their data stage moves USB_DEVICE_EP0_BUFFER_SIZE bytes per packet,
+    controlPacketSpacing apart.
+
+    Everything the device layer tells the firmware, it tells from the USB
+    interrupt, as the Harmony device layer does in interrupt mode: bus
+    events, start of frame, sent reports and each step of a control
+    transfer.  Its CPU time is charged with the usbEvent and
+    usbControlPacket costs of the simulated core.
+*******************************************************************************/
+
+#ifndef _SIM_USB_H
+#define _SIM_USB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "sim_core.h"
+
+/* One full speed frame and one high speed microframe */
+#define SIM_USB_FRAME_TICKS     SIM_US_TO_TICKS(1000)
+#define SIM_USB_MICROFRAME_TICKS SIM_US_TO_TICKS(125)
+
+/* Receives a report sent on the interrupt endpoint.  stamp is what the
+   stamp routine of the configuration returned when it was queued. */
+typedef void (*SIM_USB_REPORT_HANDLER)(uintptr_t context, const uint8_t * data,
+                                       size_t length, SIM_TIME stamp,
+                                       SIM_TIME time);
+
+typedef struct
+{
+    /* The bus runs at high speed, whatever speed the device asks for */
+    bool highSpeed;
+
+    /* Polling interval of the interrupt endpoint, in frames, or in
+       microframes at high speed */
+    uint8_t interval;
+
+    /* IN token time after the start of frame */
+    SIM_TIME pollOffset;
+
+    /* Every pollSkip-th IN token is left out, as by a host busy with other
+       devices.  0 for none. */
+    uint32_t pollSkip;
+
+    /* Between two packets of a control transfer */
+    SIM_TIME controlPacketSpacing;
+
+    /* Stamps a report when it is queued.  The time it is queued if NULL. */
+    SIM_TIME (*stamp)(void);
+
+    SIM_USB_REPORT_HANDLER reportHandler;
+    uintptr_t reportContext;
+
+} SIM_USB_CONFIG;
+
+typedef struct
+{
+    uint32_t frames;
+
+    /* IN tokens on the interrupt endpoint, those answered with NAK, and
+       those left out by pollSkip */
+    uint32_t polls;
+    uint32_t naks;
+    uint32_t skipped;
+
+    /* Reports queued and delivered, and queue full refusals */
+    uint32_t queued;
+    uint32_t reports;
+    uint32_t refused;
+
+    uint32_t controlTransfers;
+    uint32_t controlPackets;
+
+} SIM_USB_STATS;
+
+/* Full speed, one frame interval, IN token 50 us into the frame, 100 us
+   per EP0 packet */
+void SIM_USB_ConfigDefault ( SIM_USB_CONFIG * config );
+
+/* Detaches the device and forgets the firmware's handlers */
+void SIM_USB_Reset ( const SIM_USB_CONFIG * config );
+
+bool SIM_USB_IsConfigured ( void );
+
+/*******************************************************************************
+  Function:
+    bool SIM_USB_GetReport ( uint8_t type, uint8_t id,
+                             uint8_t * buffer, size_t length )
+
+  Summary:
+    Starts a GET_REPORT control read into buffer.
+
+  Remarks:
+    False if the device is not configured or a control transfer is still
+    going on.  See SIM_USB_ControlDone() for its end.
+*/
+
+bool SIM_USB_GetReport ( uint8_t type, uint8_t id, uint8_t * buffer,
+                         size_t length );
+
+/* Starts a SET_IDLE control write, duration in units of 4 ms */
+bool SIM_USB_SetIdle ( uint8_t duration, uint8_t id );
+
+/* Starts a GET_IDLE control read of the one byte duration */
+bool SIM_USB_GetIdle ( uint8_t id, uint8_t * duration );
+
+/* Starts a SET_PROTOCOL control write, 0 for boot and 1 for report */
+bool SIM_USB_SetProtocol ( uint8_t protocol );
+
+/* Starts a GET_PROTOCOL control read of the one byte protocol */
+bool SIM_USB_GetProtocol ( uint8_t * protocol );
+
+/*******************************************************************************
+  Function:
+    bool SIM_USB_ControlDone ( int * result )
+
+  Summary:
+    Whether the last control transfer is over.
+
+  Remarks:
+    result is then the number of data bytes it moved, or -1 if the device
+    stalled it.
+*/
+
+bool SIM_USB_ControlDone ( int * result );
+
+const SIM_USB_STATS * SIM_USB_StatsGet ( void );
+
+#endif /* _SIM_USB_H */
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,326 @@
+/*******************************************************************************
+  Host Benchmarks
+
+  File Name:
+    benchmark.c
+
+  Summary:
+    Times the firmware's hot paths natively, one line each, in nanoseconds
+    of this machine.
+
+  Description:
+    The code is the firmware's own, compiled for the host, so the figures
+    are for comparing one version or configuration with another, not
+    cycles of a PIC32.  Each path runs iterations times over changing
+    input, after one untimed run to warm the caches.
+
+      pipeline    DECIMATOR_Put() and, for each output, TILT_Process(),
+                  per sensor sample
+      timer start TIMER_WHEEL_Start() of one of BENCHMARK_TIMERS timers
+                  spread over two turns of the wheel, and
+      timer stop  TIMER_WHEEL_Stop() of one of them, per timer
+      timer expiry
+                  TIMER_WHEEL_Tasks() once BENCHMARK_TIMERS timers spread
+                  over BENCHMARK_EXPIRY_SLOTS slots are due, per timer
+      still/moving memcmp
+                  one pass of the report decision as APP_Tasks() made it
+                  before the change flags: take the movement, build the
+                  report and compare it with the last one, with no
+                  movement or with some in every pass
+      still/moving flags
+                  the same pass now: look at the movement pending, the
+                  button flag and the idle timer, and build the report
+                  only if it goes out
+
+    Usage: benchmark [iterations]
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "system_config.h"
+#include "system_definitions.h"
+#include "app.h"
+#include "decimator.h"
+#include "tilt.h"
+#include "motion.h"
+#include "mouse.h"
+#include "hid_idle.h"
+#include "timebase.h"
+#include "timer_wheel.h"
+#include "run_loop.h"
+#include "sim_core.h"
+
+#define BENCHMARK_ITERATIONS        1000000
+#define BENCHMARK_TIMERS            64
+#define BENCHMARK_EXPIRY_SLOTS      8
+
+#define SLOT_TICKS                  ((uint64_t)1 << TIMER_WHEEL_SLOT_SHIFT)
+
+/* Results go here, so that the compiler keeps the work that makes them */
+static volatile int32_t benchmarkSink;
+
+static TIMER_WHEEL_TIMER timers[BENCHMARK_TIMERS];
+static unsigned int timersExpired;
+
+static uint64_t _Nanoseconds ( void )
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+static void _Print ( const char * name, const char * unit, uint64_t elapsed,
+                     unsigned int count )
+{
+    printf("%-14s %8.1f ns per %s\n", name, (double)elapsed / count, unit);
+}
+
+/* A tilt that sweeps the whole gain curve, both signs, on both axes */
+static void _Sample ( unsigned int index, ACC_SAMPLE * sample )
+{
+    sample->x = (int16_t)((index * 37u) & 0xFFFF);
+    sample->y = (int16_t)((index * 91u + 12345u) & 0xFFFF);
+    sample->z = 16384;
+}
+
+static uint64_t _PipelineRun ( unsigned int iterations )
+{
+    DECIMATOR decimator;
+    TILT_PIPELINE tilt;
+    ACC_SAMPLE sample;
+    ACC_SAMPLE filtered;
+    TILT_VELOCITY velocity;
+    int32_t sum = 0;
+    unsigned int index;
+    uint64_t start;
+
+    DECIMATOR_Initialize(&decimator);
+    TILT_Initialize(&tilt, APP_PIPELINE_SAMPLES_NUM, APP_PIPELINE_SAMPLES_DEN);
+
+    start = _Nanoseconds();
+    for(index = 0; index < iterations; index ++)
+    {
+        _Sample(index, &sample);
+#if DECIMATOR_ENABLE
+        if(!DECIMATOR_Put(&decimator, &sample, &filtered))
+        {
+            continue;
+        }
+#else
+        filtered = sample;
+#endif
+        TILT_Process(&tilt, &filtered, &velocity);
+        sum += velocity.x + velocity.y;
+    }
+    benchmarkSink = sum;
+    return _Nanoseconds() - start;
+}
+
+static void _Expired ( TIMER_WHEEL_TIMER * timer, uintptr_t context )
+{
+    timersExpired ++;
+}
+
+/* The wheel on the simulated core timer, as test_timer_wheel has it */
+static void _TimerWheelSetup ( void )
+{
+    SIM_CORE_Reset();
+    SIM_CORE_VectorsSet(sysVectors);
+
+    SYS_INT_Initialize();
+    SYS_INT_VectorPrioritySet(INT_VECTOR_CT, INT_PRIORITY_LEVEL1);
+    TIMEBASE_Initialize();
+    TIMER_WHEEL_Initialize();
+    RUN_LOOP_Initialize();
+    SYS_INT_Enable();
+}
+
+/* Deadlines of timer index in round, spread over span ticks */
+static uint64_t _TimerDelay ( unsigned int round, unsigned int index, uint64_t span )
+{
+    return 1 + ((round * 7919u + index * 104729u) % span);
+}
+
+static void _TimerStartStopRun ( unsigned int rounds, uint64_t * start, uint64_t * stop )
+{
+    unsigned int round;
+    unsigned int index;
+    uint64_t time;
+
+    *start = 0;
+    *stop = 0;
+    for(round = 0; round < rounds; round ++)
+    {
+        time = _Nanoseconds();
+        for(index = 0; index < BENCHMARK_TIMERS; index ++)
+        {
+            TIMER_WHEEL_Start(&timers[index],
+                    _TimerDelay(round, index, 2 * TIMER_WHEEL_SLOTS * SLOT_TICKS),
+                    _Expired, index);
+        }
+        *start += _Nanoseconds() - time;
+
+        time = _Nanoseconds();
+        for(index = 0; index < BENCHMARK_TIMERS; index ++)
+        {
+            TIMER_WHEEL_Stop(&timers[index]);
+        }
+        *stop += _Nanoseconds() - time;
+    }
+}
+
+static uint64_t _TimerExpiryRun ( unsigned int rounds )
+{
+    unsigned int round;
+    unsigned int index;
+    uint64_t elapsed = 0;
+    uint64_t time;
+
+    for(round = 0; round < rounds; round ++)
+    {
+        for(index = 0; index < BENCHMARK_TIMERS; index ++)
+        {
+            TIMER_WHEEL_Start(&timers[index],
+                    _TimerDelay(round, index, BENCHMARK_EXPIRY_SLOTS * SLOT_TICKS),
+                    _Expired, index);
+        }
+        SIM_CORE_RunUntil(TIMEBASE_TicksGet() + (BENCHMARK_EXPIRY_SLOTS + 1) * SLOT_TICKS);
+
+        time = _Nanoseconds();
+        TIMER_WHEEL_Tasks();
+        elapsed += _Nanoseconds() - time;
+    }
+    return elapsed;
+}
+
+/* The movement put into the accumulator every pass, Q8.8 */
+static int32_t _DecisionMovement ( bool moving, unsigned int pass )
+{
+    return moving ? (int32_t)(pass & 0x3FF) : 0;
+}
+
+static uint64_t _DecisionMemcmpRun ( unsigned int iterations, bool moving )
+{
+    MOTION_ACCUMULATOR motion;
+    MOUSE_BUTTON_STATE buttons[MOUSE_BUTTON_NUMBERS] = { 0 };
+    MOUSE_REPORT report;
+    MOUSE_REPORT previous;
+    MOUSE_COORDINATE x;
+    MOUSE_COORDINATE y;
+    uint8_t idleRate = 0;
+    uint64_t lastReportTime = 0;
+    bool isReportSend;
+    unsigned int sent = 0;
+    unsigned int pass;
+    uint64_t start;
+
+    MOTION_Initialize(&motion);
+    memset(&previous, 0, sizeof(previous));
+
+    start = _Nanoseconds();
+    for(pass = 0; pass < iterations; pass ++)
+    {
+        MOTION_Add(&motion, _DecisionMovement(moving, pass), 0);
+
+        MOTION_Take(&motion, &x, &y);
+        MOUSE_ReportCreate(x, y, buttons, &report);
+        isReportSend = true;
+        if((memcmp(&previous, &report, sizeof(MOUSE_REPORT)) == 0) &&
+           (x == 0) && (y == 0))
+        {
+            isReportSend = (idleRate != 0) &&
+                ((TIMEBASE_TicksGet() - lastReportTime) >=
+                 TIMEBASE_MS_TO_TICKS(idleRate * 4));
+        }
+        if(isReportSend)
+        {
+            previous = report;
+            lastReportTime = TIMEBASE_TicksGet();
+            sent ++;
+        }
+    }
+    benchmarkSink = sent;
+    return _Nanoseconds() - start;
+}
+
+static uint64_t _DecisionFlagsRun ( unsigned int iterations, bool moving )
+{
+    MOTION_ACCUMULATOR motion;
+    MOUSE_BUTTON_STATE buttons[MOUSE_BUTTON_NUMBERS] = { 0 };
+    MOUSE_REPORT report;
+    MOUSE_COORDINATE x;
+    MOUSE_COORDINATE y;
+    HID_IDLE idle = { 0 };
+    int mouseIdle;
+    bool isButtonChanged = false;
+    unsigned int sent = 0;
+    unsigned int pass;
+    uint64_t start;
+
+    MOTION_Initialize(&motion);
+    HID_IDLE_Initialize(&idle);
+    mouseIdle = HID_IDLE_Register(&idle, MOUSE_REPORT_ID);
+
+    start = _Nanoseconds();
+    for(pass = 0; pass < iterations; pass ++)
+    {
+        MOTION_Add(&motion, _DecisionMovement(moving, pass), 0);
+
+        if(MOTION_IsPending(&motion) || isButtonChanged ||
+           HID_IDLE_IsDue(&idle, mouseIdle))
+        {
+            MOTION_Take(&motion, &x, &y);
+            MOUSE_ReportCreate(x, y, buttons, &report);
+            isButtonChanged = false;
+            sent ++;
+        }
+    }
+    benchmarkSink = sent;
+    return _Nanoseconds() - start;
+}
+
+int main ( int argc, char ** argv )
+{
+    unsigned int iterations = (argc > 1) ? atoi(argv[1]) : 0;
+    unsigned int rounds;
+    uint64_t start;
+    uint64_t stop;
+
+    if(iterations == 0)
+    {
+        iterations = BENCHMARK_ITERATIONS;
+    }
+
+    _PipelineRun(iterations);
+    _Print("pipeline", "sample", _PipelineRun(iterations), iterations);
+
+    rounds = (iterations + BENCHMARK_TIMERS - 1) / BENCHMARK_TIMERS;
+    _TimerWheelSetup();
+    _TimerStartStopRun(rounds, &start, &stop);
+    _TimerStartStopRun(rounds, &start, &stop);
+    _Print("timer start", "timer", start, rounds * BENCHMARK_TIMERS);
+    _Print("timer stop", "timer", stop, rounds * BENCHMARK_TIMERS);
+    _TimerExpiryRun(rounds);
+    timersExpired = 0;
+    _Print("timer expiry", "timer", _TimerExpiryRun(rounds), rounds * BENCHMARK_TIMERS);
+    if(timersExpired != rounds * BENCHMARK_TIMERS)
+    {
+        printf("timer expiry: %u of %u timers expired\n", timersExpired,
+               rounds * BENCHMARK_TIMERS);
+        return 1;
+    }
+
+    _DecisionMemcmpRun(iterations, false);
+    _Print("still memcmp", "pass", _DecisionMemcmpRun(iterations, false), iterations);
+    _DecisionFlagsRun(iterations, false);
+    _Print("still flags", "pass", _DecisionFlagsRun(iterations, false), iterations);
+    _DecisionMemcmpRun(iterations, true);
+    _Print("moving memcmp", "pass", _DecisionMemcmpRun(iterations, true), iterations);
+    _DecisionFlagsRun(iterations, true);
+    _Print("moving flags", "pass", _DecisionFlagsRun(iterations, true), iterations);
+
+    return 0;
+}
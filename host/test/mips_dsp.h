@@ -0,0 +1,108 @@
+/*******************************************************************************
+  MIPS DSP ASE Emulation
+
+  File Name:
+    mips_dsp.h
+
+  Summary:
+    The DSP ASE builtins dsp.c uses, in plain C, so that its DSP ASE
+    kernels run on the host.
+
+  Description:
+    Forced into the build of dsp.c for test_dsp, with __mips_dsp defined.
+    Each builtin follows the instruction's description in the MIPS32
+    Architecture for Programmers Volume IV-e, saturation included.  The
+    condition code bits CMP.LT.PH sets in DSPControl, and PICK.PH reads,
+    are a global here.
+*******************************************************************************/
+
+#ifndef _MIPS_DSP_H
+#define _MIPS_DSP_H
+
+#include <stdint.h>
+
+typedef short v2q15 __attribute__ ((vector_size(4)));
+typedef long long a64;
+
+/* DSPControl ccond, bit n for lane n */
+static unsigned int mipsDspCondition;
+
+static inline int32_t _MIPS_DSP_Saturate16 ( int32_t value )
+{
+    return (value > INT16_MAX) ? INT16_MAX : (value < INT16_MIN) ? INT16_MIN : value;
+}
+
+static inline int32_t _MIPS_DSP_Saturate32 ( int64_t value )
+{
+    return (value > INT32_MAX) ? INT32_MAX : (value < INT32_MIN) ? INT32_MIN : (int32_t)value;
+}
+
+/* Q15 * Q15 to Q31; only -1.0 * -1.0 saturates */
+static inline int32_t _MIPS_DSP_MulQ31 ( int16_t a, int16_t b )
+{
+    if((a == INT16_MIN) && (b == INT16_MIN))
+    {
+        return INT32_MAX;
+    }
+    return ((int32_t)a * b) * 2;
+}
+
+/* DPAQ_S.W.PH */
+static inline a64 __builtin_mips_dpaq_s_w_ph ( a64 acc, v2q15 a, v2q15 b )
+{
+    return acc + _MIPS_DSP_MulQ31(a[0], b[0]) + _MIPS_DSP_MulQ31(a[1], b[1]);
+}
+
+/* MADD */
+static inline a64 __builtin_mips_madd ( a64 acc, int32_t a, int32_t b )
+{
+    return acc + (int64_t)a * b;
+}
+
+/* EXTR_R.W: rounds at bit shift - 1 and keeps the low word */
+static inline int32_t __builtin_mips_extr_r_w ( a64 acc, int shift )
+{
+    if(shift == 0)
+    {
+        return (int32_t)acc;
+    }
+    return (int32_t)(uint32_t)(((acc >> (shift - 1)) + 1) >> 1);
+}
+
+/* SHLL_S.W */
+static inline int32_t __builtin_mips_shll_s_w ( int32_t a, int shift )
+{
+    return _MIPS_DSP_Saturate32((int64_t)a << shift);
+}
+
+/* SUBQ_S.PH */
+static inline v2q15 __builtin_mips_subq_s_ph ( v2q15 a, v2q15 b )
+{
+    return (v2q15){ _MIPS_DSP_Saturate16(a[0] - b[0]),
+                    _MIPS_DSP_Saturate16(a[1] - b[1]) };
+}
+
+/* ABSQ_S.PH */
+static inline v2q15 __builtin_mips_absq_s_ph ( v2q15 a )
+{
+    return (v2q15){ _MIPS_DSP_Saturate16((a[0] < 0) ? -a[0] : a[0]),
+                    _MIPS_DSP_Saturate16((a[1] < 0) ? -a[1] : a[1]) };
+}
+
+/* CMP.LT.PH */
+static inline void __builtin_mips_cmp_lt_ph ( v2q15 a, v2q15 b )
+{
+    mipsDspCondition = ((a[0] < b[0]) ? 1 : 0) | ((a[1] < b[1]) ? 2 : 0);
+}
+
+/* PICK.PH */
+static inline v2q15 __builtin_mips_pick_ph ( v2q15 a, v2q15 b )
+{
+    return (v2q15){ (mipsDspCondition & 1) ? a[0] : b[0],
+                    (mipsDspCondition & 2) ? a[1] : b[1] };
+}
+
+#endif /* _MIPS_DSP_H */
+/*******************************************************************************
+ End of File
+ */
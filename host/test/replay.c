@@ -0,0 +1,143 @@
+/*******************************************************************************
+  Sensor Trace Replay
+
+  File Name:
+    replay.c
+
+  Summary:
+    Feeds an "ACCT" trace of tools/sensor_capture.py through the whole
+    firmware on the simulated board and prints the mouse reports it sends.
+
+  Description:
+    The sensor rests at the trace's first sample while the simulated host
+    enumerates the device, then replays the trace (see sim_trace.h).  The
+    cost model is off, so a replay takes a small fraction of the trace's
+    duration, and it is deterministic: the same trace and firmware print
+    the same reports, which makes the output something to diff across
+    changes to the motion pipeline.
+
+    stdout is CSV, one line per mouse report: host time in microseconds
+    from the start of the replay, buttons, x and y.  A summary goes to
+    stderr.
+
+    Usage: replay <trace> [bInterval]
+*******************************************************************************/
+
+#include <stdlib.h>
+#include "system_config.h"
+#include "accel.h"
+#include "mouse.h"
+#include "sim_system.h"
+#include "sim_trace.h"
+
+/* Enumeration and the sensor's start-up, at rest */
+#define REPLAY_SETTLE_US            300000
+
+/* Polls for the end of the trace, and lets the last reports out after it */
+#define REPLAY_STEP_US              10000
+
+static struct
+{
+    SIM_TRACE trace;
+    bool replaying;
+    bool ended;
+    SIM_TIME start;
+    uint32_t first;
+
+    uint32_t reports;
+    int64_t x;
+    int64_t y;
+
+} replay;
+
+static bool _Source ( uintptr_t context, SIM_ACCEL_SAMPLE * sample, SIM_TIME * interval )
+{
+    if(!replay.replaying)
+    {
+        *sample = replay.trace.held;
+        return true;
+    }
+    if(!SIM_TRACE_Source((uintptr_t)&replay.trace, sample, interval))
+    {
+        replay.ended = true;
+        return false;
+    }
+    return true;
+}
+
+static void _Report ( uintptr_t context, const uint8_t * data, size_t length,
+                      SIM_TIME stamp, SIM_TIME time )
+{
+    int16_t x;
+    int16_t y;
+
+    if(!replay.replaying || (length != MOUSE_REPORT_SIZE) || (data[0] != MOUSE_REPORT_ID))
+    {
+        return;
+    }
+    x = (int16_t)(data[2] | (data[3] << 8));
+    y = (int16_t)(data[4] | (data[5] << 8));
+    printf("%.0f,%u,%d,%d\n",
+           (double)(time - replay.start) * 1e6 / SIM_TICKS_PER_SECOND,
+           data[1], x, y);
+    replay.reports ++;
+    replay.x += x;
+    replay.y += y;
+}
+
+int main ( int argc, char ** argv )
+{
+    SIM_SYSTEM_CONFIG config;
+    SIM_TIME now;
+
+    if(argc < 2)
+    {
+        fprintf(stderr, "usage: %s <trace> [bInterval]\n", argv[0]);
+        return 2;
+    }
+    if(!SIM_TRACE_Open(&replay.trace, argv[1]) ||
+       !SIM_TRACE_ReplayStart(&replay.trace))
+    {
+        fprintf(stderr, "%s: not a sensor trace, or empty\n", argv[1]);
+        return 1;
+    }
+    replay.first = replay.trace.position;
+    if(replay.trace.odrHz != ACC_ODR_HZ)
+    {
+        fprintf(stderr, "%s: recorded at %u Hz, replayed at %u Hz\n",
+                argv[1], replay.trace.odrHz, ACC_ODR_HZ);
+    }
+
+    SIM_SYSTEM_ConfigDefault(&config);
+    config.source = _Source;
+    config.usb.reportHandler = _Report;
+    if(argc > 2)
+    {
+        config.usb.interval = (uint8_t)atoi(argv[2]);
+    }
+    SIM_SYSTEM_Start(&config);
+
+    SIM_SYSTEM_RunUntil(SIM_US_TO_TICKS(REPLAY_SETTLE_US));
+    if(!SIM_USB_IsConfigured())
+    {
+        fprintf(stderr, "the device did not enumerate\n");
+        return 1;
+    }
+
+    printf("time_us,buttons,x,y\n");
+    replay.start = SIM_CORE_Now();
+    replay.replaying = true;
+    do
+    {
+        now = SIM_CORE_Now();
+        SIM_SYSTEM_RunUntil(now + SIM_US_TO_TICKS(REPLAY_STEP_US));
+    } while(!replay.ended);
+    SIM_SYSTEM_RunUntil(SIM_CORE_Now() + SIM_US_TO_TICKS(REPLAY_STEP_US));
+
+    fprintf(stderr, "%u samples over %.3f s, %u reports, x %lld, y %lld\n",
+            replay.trace.position - replay.first,
+            (double)(now - replay.start) / SIM_TICKS_PER_SECOND,
+            replay.reports, (long long)replay.x, (long long)replay.y);
+    SIM_TRACE_Close(&replay.trace);
+    return 0;
+}
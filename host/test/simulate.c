@@ -0,0 +1,183 @@
+/*******************************************************************************
+  Full System Simulator
+
+  File Name:
+    simulate.c
+
+  Summary:
+    Runs the unmodified firmware against a virtual USB host, a virtual
+    LSM303D with scripted motion and the virtual core timer, and reports how
+    one configuration delivers that motion.
+
+  Description:
+    The firmware is the one of the library this program is linked with, one
+    per configuration (see CMakeLists.txt), with the cost model on so that
+    its code takes time.  The sensor is tilted round a circle, so that it
+    moves the pointer on both axes all the time.  After a warm-up that
+    covers enumeration, the host reads the statistics feature report of the
+    firmware once a second, as tools/stats_read.py does on a board.
+
+    One line per run:
+
+      reports/s   reports the host collected
+      missed      frames that ended with movement pending but no report,
+                  from the firmware's statistics
+      saturated   movement lost to saturation, from the same
+      lost        sensor samples overwritten in the FIFO or dropped from
+                  the sample queue
+      latency     from the sensor taking the newest sample a report was
+                  built from to the host collecting it, mean and worst, us
+      cpu         share of time the core was not in WAIT
+
+    Usage: simulate [seconds [bInterval [pollSkip]]]
+
+    pollSkip leaves out every pollSkip-th IN token of the host, see
+    SIM_USB_CONFIG.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <math.h>
+#include "system_config.h"
+#include "system_definitions.h"
+#include "app.h"
+#include "mouse.h"
+#include "sim_system.h"
+#include "test.h"
+
+/* Compiled in by CMakeLists.txt */
+#ifndef SIMULATE_CONFIG
+#define SIMULATE_CONFIG             "hid_mouse"
+#endif
+
+#define SIMULATE_WARMUP_US          500000
+
+/* Tilt of the circle, about 30 degrees, and its period */
+#define SIMULATE_TILT               8192.0
+#define SIMULATE_PERIOD_S           2.0
+
+static struct
+{
+    bool measuring;
+    uint32_t reports;
+    SIM_TIME latencySum;
+    SIM_TIME latencyMax;
+
+} simulate;
+
+static bool _Circle ( uintptr_t context, SIM_ACCEL_SAMPLE * sample, SIM_TIME * interval )
+{
+    double phase = 2.0 * M_PI * (double)SIM_CORE_Now() /
+                   (SIMULATE_PERIOD_S * SIM_TICKS_PER_SECOND);
+
+    sample->x = (int16_t)lrint(SIMULATE_TILT * sin(phase));
+    sample->y = (int16_t)lrint(SIMULATE_TILT * cos(phase));
+    sample->z = (int16_t)lrint(sqrt(16384.0 * 16384.0 - SIMULATE_TILT * SIMULATE_TILT));
+    return true;
+}
+
+/* A report carries the newest sample read out of the sensor when it is
+   queued */
+static SIM_TIME _Stamp ( void )
+{
+    return SIM_ACCEL_StatsGet()->readNewestTime;
+}
+
+static void _Report ( uintptr_t context, const uint8_t * data, size_t length,
+                      SIM_TIME stamp, SIM_TIME time )
+{
+    if(simulate.measuring && (data[0] == MOUSE_REPORT_ID))
+    {
+        simulate.reports ++;
+        simulate.latencySum += time - stamp;
+        if(time - stamp > simulate.latencyMax)
+        {
+            simulate.latencyMax = time - stamp;
+        }
+    }
+}
+
+static uint32_t _StatsValue ( const uint8_t * report, unsigned int index )
+{
+    const uint8_t * value = &report[4 + 4 * index];
+
+    return value[0] | (value[1] << 8) | (value[2] << 16) | ((uint32_t)value[3] << 24);
+}
+
+/* Reads the firmware's statistics of the last complete second */
+static bool _StatsRead ( uint8_t * report )
+{
+    int result;
+
+    if(!SIM_USB_GetReport(USB_HID_REPORT_TYPE_FEATURE, APP_STATS_REPORT_ID,
+                          report, APP_STATS_REPORT_SIZE))
+    {
+        return false;
+    }
+    while(!SIM_USB_ControlDone(&result))
+    {
+        SIM_SYSTEM_RunUntil(SIM_CORE_Now() + SIM_US_TO_TICKS(1000));
+    }
+    return (result == APP_STATS_REPORT_SIZE);
+}
+
+int main ( int argc, char ** argv )
+{
+    SIM_SYSTEM_CONFIG config;
+    uint8_t report[APP_STATS_REPORT_SIZE];
+    unsigned int seconds = (argc > 1) ? atoi(argv[1]) : 10;
+    unsigned int second;
+    uint32_t missed = 0;
+    uint32_t saturated = 0;
+    uint32_t overflows;
+    uint32_t overwritten;
+    SIM_TIME start;
+    SIM_TIME busy;
+
+    SIM_SYSTEM_ConfigDefault(&config);
+    config.source = _Circle;
+    config.usb.reportHandler = _Report;
+    config.usb.stamp = _Stamp;
+    config.costs = true;
+    if(argc > 2)
+    {
+        config.usb.interval = (uint8_t)atoi(argv[2]);
+    }
+    if(argc > 3)
+    {
+        config.usb.pollSkip = (uint32_t)atoi(argv[3]);
+    }
+    SIM_SYSTEM_Start(&config);
+
+    SIM_SYSTEM_RunUntil(SIM_US_TO_TICKS(SIMULATE_WARMUP_US));
+    TEST_CHECK(SIM_USB_IsConfigured());
+
+    TEST_CHECK(_StatsRead(report));
+    overflows = _StatsValue(report, 5);
+    start = SIM_CORE_Now();
+    busy = SIM_CORE_BusyTicksGet();
+    overwritten = SIM_ACCEL_StatsGet()->overwritten;
+    simulate.measuring = true;
+
+    for(second = 1; second <= seconds; second ++)
+    {
+        SIM_SYSTEM_RunUntil(start + second * SIM_TICKS_PER_SECOND);
+        TEST_CHECK(_StatsRead(report));
+        missed += _StatsValue(report, 2);
+        saturated += _StatsValue(report, 4);
+    }
+    overflows = _StatsValue(report, 5) - overflows;
+    simulate.measuring = false;
+
+    printf("%-24s bInterval %u  skip %3u  reports/s %7.1f  missed %5u  saturated %5u  "
+           "lost %5u  latency %6.1f %6.1f us  cpu %5.1f%%\n",
+           SIMULATE_CONFIG, config.usb.interval, config.usb.pollSkip,
+           (double)simulate.reports / seconds, missed, saturated,
+           (SIM_ACCEL_StatsGet()->overwritten - overwritten) + overflows,
+           simulate.reports ?
+                (double)simulate.latencySum / simulate.reports * 1e6 / SIM_TICKS_PER_SECOND : 0.0,
+           (double)simulate.latencyMax * 1e6 / SIM_TICKS_PER_SECOND,
+           100.0 * (SIM_CORE_BusyTicksGet() - busy) / (SIM_CORE_Now() - start));
+
+    TEST_CHECK(simulate.reports > 0);
+    return TEST_RESULT();
+}
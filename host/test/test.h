@@ -0,0 +1,66 @@
+/*******************************************************************************
+  Host Unit Test Support
+
+  File Name:
+    test.h
+
+  Summary:
+    Checks and the test runner of the host unit tests.
+
+  Description:
+    Each test program is one executable with its own copy of the firmware's
+    state.  A failed check prints where it is and the test goes on; main()
+    returns non-zero if any check failed, which is what ctest looks at.
+*******************************************************************************/
+
+#ifndef _TEST_H
+#define _TEST_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+static unsigned int testFailures;
+
+#define TEST_CHECK(condition)                                                 \
+    do                                                                        \
+    {                                                                         \
+        if(!(condition))                                                      \
+        {                                                                     \
+            fprintf(stderr, "%s:%d: check failed: %s\n",                      \
+                    __FILE__, __LINE__, #condition);                          \
+            testFailures ++;                                                  \
+        }                                                                     \
+    } while(0)
+
+#define TEST_CHECK_EQUAL(expected, actual)                                    \
+    do                                                                        \
+    {                                                                         \
+        int64_t _testExpected = (int64_t)(expected);                          \
+        int64_t _testActual = (int64_t)(actual);                              \
+                                                                              \
+        if(_testExpected != _testActual)                                      \
+        {                                                                     \
+            fprintf(stderr, "%s:%d: %s is %" PRId64 ", expected %" PRId64 "\n", \
+                    __FILE__, __LINE__, #actual, _testActual, _testExpected); \
+            testFailures ++;                                                  \
+        }                                                                     \
+    } while(0)
+
+#define TEST_RUN(test)                                                        \
+    do                                                                        \
+    {                                                                         \
+        unsigned int _testBefore = testFailures;                              \
+                                                                              \
+        test();                                                               \
+        printf("%s %s\n", (testFailures == _testBefore) ? "pass" : "FAIL",    \
+               #test);                                                        \
+    } while(0)
+
+#define TEST_RESULT()               ((testFailures == 0) ? 0 : 1)
+
+#endif /* _TEST_H */
+/*******************************************************************************
+ End of File
+ */
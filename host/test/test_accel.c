@@ -0,0 +1,56 @@
+/*******************************************************************************
+  Accelerometer Driver Tests
+
+  File Name:
+    test_accel.c
+
+  Summary:
+    After the FIFO has overrun, the driver reads all 32 samples the FIFO
+    holds and no more.
+*******************************************************************************/
+
+#include "system_config.h"
+#include "accel.h"
+#include "sim_system.h"
+#include "sim_accel.h"
+#include "test.h"
+
+static void OverrunReadsWhatIsStored ( void )
+{
+    SIM_SYSTEM_CONFIG config;
+    const SIM_ACCEL_STATS * stats = SIM_ACCEL_StatsGet();
+    bool interrupts;
+    int pause;
+
+    SIM_SYSTEM_ConfigDefault(&config);
+    SIM_SYSTEM_Start(&config);
+    SIM_SYSTEM_RunUntil(SIM_US_TO_TICKS(50000));
+    TEST_CHECK(stats->read > 0);
+    TEST_CHECK_EQUAL(0, acc_fifo_overruns);
+
+    /* Keep the drain from running for longer than the FIFO lasts, 25 ms,
+       a few times */
+    for(pause = 0; pause < 5; pause ++)
+    {
+        interrupts = SYS_INT_Disable();
+        SIM_CORE_Spend(SYS_CLK_FREQ / 40);
+        SYS_INT_Restore(interrupts);
+        SIM_SYSTEM_RunUntil(SIM_CORE_Now() + SIM_US_TO_TICKS(5000));
+    }
+
+    TEST_CHECK(stats->overwritten > 0);
+    TEST_CHECK(acc_fifo_overruns > 0);
+
+    /* Every sample read was in the FIFO: none was read twice */
+    TEST_CHECK_EQUAL(0, stats->readEmpty);
+    TEST_CHECK(stats->produced - stats->overwritten - stats->read <= ACC_FIFO_WATERMARK);
+}
+
+int main ( void )
+{
+    TEST_RUN(OverrunReadsWhatIsStored);
+    return TEST_RESULT();
+}
+/*******************************************************************************
+ End of File
+ */
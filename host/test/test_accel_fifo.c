@@ -0,0 +1,145 @@
+/*******************************************************************************
+  Accelerometer FIFO Tests
+
+  File Name:
+    test_accel_fifo.c
+
+  Summary:
+    While the drain or the application is held up for many sample periods,
+    the samples wait in the LSM303D FIFO or in the sample queue, and every
+    one of them reaches the application, in order.
+*******************************************************************************/
+
+#include "system_config.h"
+#include "accel.h"
+#include "capture.h"
+#include "sim_system.h"
+#include "sim_accel.h"
+#include "test.h"
+
+#define SETTLE_US           50000
+#define RUN_US              5000
+#define PAUSES              5
+
+/* 16 sample periods at 1600 Hz, far past the watermark and well within
+   the 32 the FIFO holds */
+#define PAUSE_US            10000
+
+static uint16_t produced;
+
+static struct
+{
+    bool started;
+    uint16_t sequence;
+    int16_t offset;
+    unsigned int count;
+    unsigned int gaps;
+    unsigned int mismatches;
+    uint32_t dropped;
+
+} consumed;
+
+/* A ramp that ties every sample to its place in the stream */
+static bool _Ramp ( uintptr_t context, SIM_ACCEL_SAMPLE * sample, SIM_TIME * interval )
+{
+    sample->x = (int16_t)produced;
+    sample->y = 0;
+    sample->z = 16384;
+    produced ++;
+    return true;
+}
+
+static uint32_t _Get32 ( const uint8_t * data )
+{
+    return data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+static uint16_t _Get16 ( const uint8_t * data )
+{
+    return (uint16_t)(data[0] | (data[1] << 8));
+}
+
+/* Checks what the application has taken since the last call against the
+   ramp, through the capture ring it copies every sample to */
+static void _ConsumedCheck ( void )
+{
+    uint8_t report[CAPTURE_REPORT_SIZE];
+    const uint8_t * slot;
+    unsigned int index;
+
+    do
+    {
+        CAPTURE_ReportGet(report);
+        for(index = 0; index < report[2]; index ++)
+        {
+            slot = &report[CAPTURE_REPORT_HEADER_BYTES + index * CAPTURE_SAMPLE_BYTES];
+            if(!consumed.started)
+            {
+                consumed.started = true;
+                consumed.offset = (int16_t)(_Get16(&slot[0]) - _Get16(&slot[6]));
+            }
+            else if(_Get16(&slot[6]) != (uint16_t)(consumed.sequence + 1))
+            {
+                consumed.gaps ++;
+            }
+            if((int16_t)(_Get16(&slot[0]) - _Get16(&slot[6])) != consumed.offset)
+            {
+                consumed.mismatches ++;
+            }
+            consumed.sequence = _Get16(&slot[6]);
+            consumed.count ++;
+        }
+        consumed.dropped = _Get32(&report[4]);
+    } while(report[2] != 0);
+}
+
+static void PausesLoseNoSample ( void )
+{
+    SIM_SYSTEM_CONFIG config;
+    const SIM_ACCEL_STATS * stats = SIM_ACCEL_StatsGet();
+    uint32_t producedBefore;
+    bool interrupts;
+    int pause;
+
+    SIM_SYSTEM_ConfigDefault(&config);
+    config.source = _Ramp;
+    SIM_SYSTEM_Start(&config);
+    SIM_SYSTEM_RunUntil(SIM_US_TO_TICKS(SETTLE_US));
+    _ConsumedCheck();
+    consumed.count = 0;
+    producedBefore = stats->produced;
+
+    for(pause = 0; pause < PAUSES; pause ++)
+    {
+        /* The drain, with the interrupts off */
+        interrupts = SYS_INT_Disable();
+        SIM_CORE_Spend(SYS_CLK_FREQ / 1000000 * PAUSE_US);
+        SYS_INT_Restore(interrupts);
+        SIM_SYSTEM_RunUntil(SIM_CORE_Now() + SIM_US_TO_TICKS(RUN_US));
+        _ConsumedCheck();
+
+        /* The application, with the interrupts running but not the loop */
+        SIM_CORE_RunUntil(SIM_CORE_Now() + SIM_US_TO_TICKS(PAUSE_US));
+        SIM_SYSTEM_RunUntil(SIM_CORE_Now() + SIM_US_TO_TICKS(RUN_US));
+        _ConsumedCheck();
+    }
+
+    TEST_CHECK_EQUAL(0, stats->overwritten);
+    TEST_CHECK_EQUAL(0, stats->readEmpty);
+    TEST_CHECK_EQUAL(0, acc_fifo_overruns);
+    TEST_CHECK_EQUAL(0, acc_sample_overflows());
+
+    /* All but the few still short of the watermark, each once and in
+       order */
+    TEST_CHECK(stats->produced - producedBefore - consumed.count <= ACC_FIFO_WATERMARK);
+    TEST_CHECK(consumed.count > PAUSES * 2 * (PAUSE_US + RUN_US) * ACC_ODR_HZ / 1000000 - 2);
+    TEST_CHECK_EQUAL(0, consumed.gaps);
+    TEST_CHECK_EQUAL(0, consumed.mismatches);
+    TEST_CHECK_EQUAL(0, consumed.dropped);
+}
+
+int main ( void )
+{
+    TEST_RUN(PausesLoseNoSample);
+    return TEST_RESULT();
+}
@@ -0,0 +1,137 @@
+/*******************************************************************************
+  Boot Protocol Tests
+
+  File Name:
+    test_boot_protocol.c
+
+  Summary:
+    After SET_PROTOCOL(0) the mouse sends the 3 byte boot report, without
+    report ID, and after SET_PROTOCOL(1) the report protocol report again;
+    GET_PROTOCOL answers which one is on.
+*******************************************************************************/
+
+#include "system_config.h"
+#include "mouse.h"
+#include "app.h"
+#include "sim_system.h"
+#include "test.h"
+
+#define SETTLE_US           200000
+#define SWITCH_US           10000
+#define WATCH_US            300000
+
+static struct
+{
+    uint32_t boot;
+    uint32_t report;
+    uint32_t other;
+    int32_t x;
+    int32_t y;
+
+} received;
+
+/* Tilted 45 degrees to the right, enough to move every frame */
+static bool _Tilted ( uintptr_t context, SIM_ACCEL_SAMPLE * sample, SIM_TIME * interval )
+{
+    sample->x = 11585;
+    sample->y = 0;
+    sample->z = 11585;
+    return true;
+}
+
+static void _Report ( uintptr_t context, const uint8_t * data, size_t length,
+                      SIM_TIME stamp, SIM_TIME time )
+{
+    if(length == MOUSE_BOOT_REPORT_SIZE)
+    {
+        received.boot ++;
+        received.x += (int8_t)data[1];
+        received.y += (int8_t)data[2];
+    }
+    else if((length == MOUSE_REPORT_SIZE) && (data[0] == MOUSE_REPORT_ID))
+    {
+        received.report ++;
+        received.x += (int16_t)(data[2] | (data[3] << 8));
+        received.y += (int16_t)(data[4] | (data[5] << 8));
+    }
+    else
+    {
+        received.other ++;
+    }
+}
+
+/* The number of data bytes the transfer moved, or -1 if it was stalled */
+static int _ControlWait ( bool started )
+{
+    int result = -2;
+
+    TEST_CHECK(started);
+    while(started && !SIM_USB_ControlDone(&result))
+    {
+        SIM_SYSTEM_RunUntil(SIM_CORE_Now() + SIM_US_TO_TICKS(100));
+    }
+    return result;
+}
+
+static uint8_t _ProtocolGet ( void )
+{
+    uint8_t protocol = 0xFF;
+
+    TEST_CHECK_EQUAL(1, _ControlWait(SIM_USB_GetProtocol(&protocol)));
+    return protocol;
+}
+
+/* Lets the reports still in the old format go, then counts */
+static void _Watch ( void )
+{
+    SIM_SYSTEM_RunUntil(SIM_CORE_Now() + SIM_US_TO_TICKS(SWITCH_US));
+    received.boot = 0;
+    received.report = 0;
+    received.other = 0;
+    received.x = 0;
+    received.y = 0;
+    SIM_SYSTEM_RunUntil(SIM_CORE_Now() + SIM_US_TO_TICKS(WATCH_US));
+}
+
+static void SwitchesProtocols ( void )
+{
+    SIM_SYSTEM_CONFIG config;
+
+    SIM_SYSTEM_ConfigDefault(&config);
+    config.source = _Tilted;
+    config.usb.reportHandler = _Report;
+    SIM_SYSTEM_Start(&config);
+    SIM_SYSTEM_RunUntil(SIM_US_TO_TICKS(SETTLE_US));
+    TEST_CHECK(SIM_USB_IsConfigured());
+    TEST_CHECK_EQUAL(APP_HID_PROTOCOL_REPORT, _ProtocolGet());
+
+    /* Boot protocol */
+    TEST_CHECK_EQUAL(0, _ControlWait(SIM_USB_SetProtocol(APP_HID_PROTOCOL_BOOT)));
+    TEST_CHECK_EQUAL(APP_HID_PROTOCOL_BOOT, _ProtocolGet());
+    _Watch();
+    TEST_CHECK(received.boot > 100);
+    TEST_CHECK_EQUAL(0, received.report);
+    TEST_CHECK_EQUAL(0, received.other);
+    TEST_CHECK(received.x > 0);
+    TEST_CHECK_EQUAL(0, received.y);
+
+    /* No such protocol; the boot protocol stays on */
+    TEST_CHECK_EQUAL(-1, _ControlWait(SIM_USB_SetProtocol(APP_HID_PROTOCOL_REPORT + 1)));
+    TEST_CHECK_EQUAL(APP_HID_PROTOCOL_BOOT, _ProtocolGet());
+
+    /* And back to the report protocol */
+    TEST_CHECK_EQUAL(0, _ControlWait(SIM_USB_SetProtocol(APP_HID_PROTOCOL_REPORT)));
+    TEST_CHECK_EQUAL(APP_HID_PROTOCOL_REPORT, _ProtocolGet());
+    _Watch();
+    TEST_CHECK(received.report > 100);
+    TEST_CHECK_EQUAL(0, received.boot);
+    TEST_CHECK_EQUAL(0, received.other);
+    TEST_CHECK(received.x > 0);
+    TEST_CHECK_EQUAL(0, received.y);
+}
+
+int main ( void )
+{
+    TEST_RUN(SwitchesProtocols);
+    return TEST_RESULT();
+}
@@ -0,0 +1,173 @@
+/*******************************************************************************
+  Capture Tests
+
+  File Name:
+    test_capture.c
+
+  Summary:
+    Samples the firmware streams through the capture feature report survive
+    the trip into an "ACCT" trace and back unchanged, and a host that reads
+    a report every 5 ms keeps up with the sensor.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <unistd.h>
+#include "system_config.h"
+#include "accel.h"
+#include "capture.h"
+#include "sim_system.h"
+#include "sim_trace.h"
+#include "test.h"
+
+#define SETTLE_US           300000
+#define CAPTURE_US          500000
+#define READ_PERIOD_US      5000
+
+#define RECORDS_MAX         (2 * ACC_ODR_HZ)
+
+/* x steps by this much per sample */
+#define RAMP_STEP           7
+
+static uint16_t produced;
+
+static struct
+{
+    uint16_t sequence;
+    uint32_t time;
+    SIM_ACCEL_SAMPLE sample;
+
+} written[RECORDS_MAX];
+
+static unsigned int writtenCount;
+
+/* A ramp that ties every sample to its place in the stream */
+static bool _Ramp ( uintptr_t context, SIM_ACCEL_SAMPLE * sample, SIM_TIME * interval )
+{
+    sample->x = (int16_t)(produced * RAMP_STEP);
+    sample->y = (int16_t)-sample->x;
+    sample->z = (int16_t)(16384 - (produced & 0xFF));
+    produced ++;
+    return true;
+}
+
+static uint16_t _Get16 ( const uint8_t * data )
+{
+    return (uint16_t)(data[0] | (data[1] << 8));
+}
+
+static uint32_t _Get32 ( const uint8_t * data )
+{
+    return _Get16(data) | ((uint32_t)_Get16(&data[2]) << 16);
+}
+
+/* Reads one capture report and appends its samples to the trace. Returns
+   the drop count it carries. */
+static uint32_t _CaptureRead ( SIM_TRACE * trace )
+{
+    uint8_t report[CAPTURE_REPORT_SIZE];
+    const uint8_t * slot;
+    int result;
+    unsigned int index;
+
+    TEST_CHECK(SIM_USB_GetReport(USB_HID_REPORT_TYPE_FEATURE, CAPTURE_REPORT_ID,
+                                 report, sizeof(report)));
+    while(!SIM_USB_ControlDone(&result))
+    {
+        SIM_SYSTEM_RunUntil(SIM_CORE_Now() + SIM_US_TO_TICKS(100));
+    }
+    TEST_CHECK_EQUAL(CAPTURE_REPORT_SIZE, result);
+    TEST_CHECK_EQUAL(CAPTURE_REPORT_FORMAT, report[1]);
+
+    for(index = 0; (index < report[2]) && (writtenCount < RECORDS_MAX); index ++)
+    {
+        slot = &report[CAPTURE_REPORT_HEADER_BYTES + index * CAPTURE_SAMPLE_BYTES];
+        written[writtenCount].sample.x = (int16_t)_Get16(&slot[0]);
+        written[writtenCount].sample.y = (int16_t)_Get16(&slot[2]);
+        written[writtenCount].sample.z = (int16_t)_Get16(&slot[4]);
+        written[writtenCount].sequence = _Get16(&slot[6]);
+        written[writtenCount].time = _Get32(&slot[8]);
+        SIM_TRACE_Write(trace, written[writtenCount].sequence,
+                        written[writtenCount].time, &written[writtenCount].sample);
+        writtenCount ++;
+    }
+    return _Get32(&report[4]);
+}
+
+static void CaptureRoundTrip ( void )
+{
+    SIM_SYSTEM_CONFIG config;
+    SIM_TRACE trace;
+    SIM_TRACE_RECORD record;
+    char path[] = "/tmp/test_capture_XXXXXX";
+    uint32_t dropped;
+    uint32_t droppedFirst;
+    unsigned int index;
+    unsigned int gaps = 0;
+    unsigned int mismatches = 0;
+    SIM_TIME end;
+
+    SIM_SYSTEM_ConfigDefault(&config);
+    config.source = _Ramp;
+    SIM_SYSTEM_Start(&config);
+    SIM_SYSTEM_RunUntil(SIM_US_TO_TICKS(SETTLE_US));
+
+    close(mkstemp(path));
+    TEST_CHECK(SIM_TRACE_Create(&trace, path, SIM_TICKS_PER_SECOND, ACC_ODR_HZ));
+
+    /* The ring has filled up and dropped samples while nobody read it.
+       From the first read on, nothing more is lost. */
+    droppedFirst = _CaptureRead(&trace);
+    end = SIM_CORE_Now() + SIM_US_TO_TICKS(CAPTURE_US);
+    do
+    {
+        SIM_SYSTEM_RunUntil(SIM_CORE_Now() + SIM_US_TO_TICKS(READ_PERIOD_US));
+        dropped = _CaptureRead(&trace);
+    } while(SIM_CORE_Now() < end);
+    SIM_TRACE_Close(&trace);
+
+    TEST_CHECK_EQUAL(droppedFirst, dropped);
+    TEST_CHECK(writtenCount > (CAPTURE_US / 1000) * ACC_ODR_HZ / 1000);
+    TEST_CHECK(writtenCount < RECORDS_MAX);
+
+    /* Each sample is the sensor's, at its place in the stream */
+    for(index = 1; index < writtenCount; index ++)
+    {
+        if((uint16_t)(written[index].sample.x - written[index].sequence * RAMP_STEP) !=
+           (uint16_t)(written[0].sample.x - written[0].sequence * RAMP_STEP))
+        {
+            mismatches ++;
+        }
+        if((uint16_t)(written[index].sequence - written[index - 1].sequence) != 1)
+        {
+            gaps ++;
+        }
+    }
+    TEST_CHECK_EQUAL(0, mismatches);
+    TEST_CHECK(gaps <= 1);
+
+    /* and reads back as it was written */
+    TEST_CHECK(SIM_TRACE_Open(&trace, path));
+    TEST_CHECK_EQUAL(ACC_ODR_HZ, trace.odrHz);
+    for(index = 0; (index < writtenCount) && SIM_TRACE_Read(&trace, &record); index ++)
+    {
+        if(((uint16_t)record.sequence != written[index].sequence) ||
+           ((uint32_t)(written[0].time + record.ticks) != written[index].time) ||
+           (record.sample.x != written[index].sample.x) ||
+           (record.sample.y != written[index].sample.y) ||
+           (record.sample.z != written[index].sample.z))
+        {
+            mismatches ++;
+        }
+    }
+    TEST_CHECK_EQUAL(writtenCount, index);
+    TEST_CHECK(!SIM_TRACE_Read(&trace, &record));
+    TEST_CHECK_EQUAL(0, mismatches);
+    SIM_TRACE_Close(&trace);
+    remove(path);
+}
+
+int main ( void )
+{
+    TEST_RUN(CaptureRoundTrip);
+    return TEST_RESULT();
+}
@@ -0,0 +1,129 @@
+/*******************************************************************************
+  Sample Rate Converter Tests
+
+  File Name:
+    test_decimator.c
+
+  Summary:
+    The 5/8 polyphase converter gives 1000 outputs for 1600 samples, passes
+    a steady tilt unchanged and has the response tools/decimator_design.py
+    reports for its coefficients: flat in the pointer band, -6 dB at
+    500 Hz and below -70 dB at 950 Hz, which aliases onto 50 Hz.
+*******************************************************************************/
+
+#include <math.h>
+#include "decimator.h"
+#include "test.h"
+
+#define AMPLITUDE           16000.0
+
+/* Outputs left out while the history fills, and the ones measured: a
+   whole number of periods of every frequency below */
+#define SETTLE_OUTPUTS      (2 * DECIMATOR_TAPS)
+#define MEASURE_OUTPUTS     DECIMATOR_RATE_HZ
+
+static DECIMATOR decimator;
+
+/* Gain at frequency in dB. x and y take the cosine and the sine, so that
+   together they are one complex exponential whose amplitude does not
+   depend on when the outputs sample it. */
+static double _GainDb ( double frequency )
+{
+    ACC_SAMPLE sample;
+    ACC_SAMPLE output;
+    double real = 0.0;
+    double imag = 0.0;
+    double angle;
+    unsigned int input = 0;
+    unsigned int outputs = 0;
+
+    DECIMATOR_Initialize(&decimator);
+    while(outputs < SETTLE_OUTPUTS + MEASURE_OUTPUTS)
+    {
+        angle = 2.0 * M_PI * frequency * input / ACC_ODR_HZ;
+        sample.x = (int16_t)lround(AMPLITUDE * cos(angle));
+        sample.y = (int16_t)lround(AMPLITUDE * sin(angle));
+        sample.z = 0;
+        input ++;
+        if(!DECIMATOR_Put(&decimator, &sample, &output))
+        {
+            continue;
+        }
+        if(outputs >= SETTLE_OUTPUTS)
+        {
+            angle = 2.0 * M_PI * frequency * outputs / DECIMATOR_RATE_HZ;
+            real += output.x * cos(angle) + output.y * sin(angle);
+            imag += output.y * cos(angle) - output.x * sin(angle);
+        }
+        outputs ++;
+    }
+    return 20.0 * log10(hypot(real, imag) / (MEASURE_OUTPUTS * AMPLITUDE));
+}
+
+static void ConvertsTheRate ( void )
+{
+    ACC_SAMPLE sample = { 0, 0, 0 };
+    ACC_SAMPLE output;
+    unsigned int input;
+    unsigned int outputs = 0;
+    unsigned int window = 0;
+
+    DECIMATOR_Initialize(&decimator);
+    for(input = 0; input < ACC_ODR_HZ; input ++)
+    {
+        if(DECIMATOR_Put(&decimator, &sample, &output))
+        {
+            outputs ++;
+            window ++;
+        }
+
+        /* And evenly, DECIMATOR_UP in every DECIMATOR_DOWN samples */
+        if((input % DECIMATOR_DOWN) == DECIMATOR_DOWN - 1)
+        {
+            TEST_CHECK_EQUAL(DECIMATOR_UP, window);
+            window = 0;
+        }
+    }
+    TEST_CHECK_EQUAL(DECIMATOR_RATE_HZ, outputs);
+}
+
+static void PassesSteadyTilt ( void )
+{
+    ACC_SAMPLE sample = { 12345, -23456, 16384 };
+    ACC_SAMPLE output;
+    unsigned int input;
+
+    DECIMATOR_Initialize(&decimator);
+    for(input = 0; input < ACC_ODR_HZ; input ++)
+    {
+        if(DECIMATOR_Put(&decimator, &sample, &output) &&
+           (input >= DECIMATOR_TAPS))
+        {
+            TEST_CHECK_EQUAL(sample.x, output.x);
+            TEST_CHECK_EQUAL(sample.y, output.y);
+            TEST_CHECK_EQUAL(sample.z, output.z);
+        }
+    }
+}
+
+static void FiltersAsDesigned ( void )
+{
+    double gain;
+
+    gain = _GainDb(50.0);
+    TEST_CHECK((gain > -0.1) && (gain < 0.1));
+
+    gain = _GainDb(DECIMATOR_RATE_HZ / 2);
+    TEST_CHECK((gain > -6.5) && (gain < -5.5));
+
+    gain = _GainDb(DECIMATOR_RATE_HZ - 50.0);
+    TEST_CHECK(gain < -70.0);
+}
+
+int main ( void )
+{
+    TEST_RUN(ConvertsTheRate);
+    TEST_RUN(PassesSteadyTilt);
+    TEST_RUN(FiltersAsDesigned);
+    return TEST_RESULT();
+}
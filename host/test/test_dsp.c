@@ -0,0 +1,168 @@
+/*******************************************************************************
+  Q15 Kernel Tests
+
+  File Name:
+    test_dsp.c
+
+  Summary:
+    The DSP ASE kernels of dsp.c, built on emulated builtins (mips_dsp.h),
+    give the same results as the C kernels the firmware uses elsewhere, for
+    inputs within the preconditions of dsp.h.
+*******************************************************************************/
+
+#include "dsp.h"
+#include "tilt.h"
+#include "test.h"
+
+/* dsp.c with DSP_ASE_ENABLE, see CMakeLists.txt */
+int16_t DSP_ASE_DotQ15 ( const int16_t * x, const int16_t * h, unsigned int count );
+void DSP_ASE_CurvePairQ15 ( const int16_t * input, const int16_t * offset,
+                            int16_t deadZone, const int16_t * curve,
+                            unsigned int fractionBits, int16_t * output );
+
+#define ROUNDS              100000
+#define TAPS_MAX            48
+
+#define FRACTION_BITS       (15 - TILT_GAIN_SEGMENT_BITS)
+
+/* Values at and around the saturation limits */
+static const int16_t edges[] =
+{
+    INT16_MIN, INT16_MIN + 1, -16384, -1, 0, 1, 16384, INT16_MAX - 1, INT16_MAX
+};
+
+#define EDGES               (sizeof(edges) / sizeof(edges[0]))
+
+static uint32_t randomState;
+
+static uint32_t _Random ( void )
+{
+    randomState = randomState * 1664525u + 1013904223u;
+    return randomState >> 8;
+}
+
+static int16_t _Random16 ( void )
+{
+    return (int16_t)_Random();
+}
+
+static void DotMatches ( void )
+{
+    int16_t x[TAPS_MAX + 1];
+    int16_t h[TAPS_MAX + 1];
+    unsigned int count;
+    unsigned int n;
+    unsigned int round;
+    int32_t sum;
+    unsigned int mismatches = 0;
+
+    randomState = 1;
+    for(round = 0; round < ROUNDS; round ++)
+    {
+        /* Odd and even lengths, from an odd start as well */
+        count = 1 + _Random() % TAPS_MAX;
+        sum = 0;
+        for(n = 0; n <= count; n ++)
+        {
+            x[n] = (round & 1) ? edges[_Random() % EDGES] : _Random16();
+            do
+            {
+                h[n] = _Random16();
+            } while(h[n] == INT16_MIN);
+            sum += (h[n] < 0) ? -h[n] : h[n];
+        }
+
+        /* Scale the magnitudes of h below 2.0 in total */
+        for(n = 0; (sum >= 65536) && (n <= count); n ++)
+        {
+            h[n] = (int16_t)(((int32_t)h[n] * 65535) / sum);
+        }
+
+        if(DSP_DotQ15(&x[round & 1], &h[round & 1], count) !=
+           DSP_ASE_DotQ15(&x[round & 1], &h[round & 1], count))
+        {
+            mismatches ++;
+        }
+    }
+    TEST_CHECK_EQUAL(0, mismatches);
+}
+
+static void _CurveFill ( int16_t * curve )
+{
+    unsigned int segment;
+
+    for(segment = 0; segment <= TILT_GAIN_SEGMENTS; segment ++)
+    {
+        curve[segment] = (int16_t)(_Random() & INT16_MAX);
+    }
+}
+
+static bool _CurveMatches ( const int16_t * input, const int16_t * offset,
+                            int16_t deadZone, const int16_t * curve )
+{
+    int16_t reference[2];
+    int16_t ase[2];
+
+    DSP_CurvePairQ15(input, offset, deadZone, curve, FRACTION_BITS, reference);
+    DSP_ASE_CurvePairQ15(input, offset, deadZone, curve, FRACTION_BITS, ase);
+    return (reference[0] == ase[0]) && (reference[1] == ase[1]);
+}
+
+static void CurveMatches ( void )
+{
+    int16_t curve[TILT_GAIN_SEGMENTS + 1];
+    int16_t input[2];
+    int16_t offset[2];
+    int16_t deadZone;
+    unsigned int a;
+    unsigned int b;
+    unsigned int round;
+    unsigned int mismatches = 0;
+
+    randomState = 2;
+    _CurveFill(curve);
+
+    /* Every pair of edge values, on both lanes, with and without a dead
+       zone */
+    for(a = 0; a < EDGES; a ++)
+    {
+        for(b = 0; b < EDGES; b ++)
+        {
+            input[0] = edges[a];
+            offset[0] = edges[b];
+            input[1] = edges[b];
+            offset[1] = edges[a];
+            if(!_CurveMatches(input, offset, 0, curve) ||
+               !_CurveMatches(input, offset, TILT_DEAD_ZONE, curve) ||
+               !_CurveMatches(input, offset, INT16_MAX, curve))
+            {
+                mismatches ++;
+            }
+        }
+    }
+
+    for(round = 0; round < ROUNDS; round ++)
+    {
+        if((round % 1000) == 0)
+        {
+            _CurveFill(curve);
+        }
+        input[0] = _Random16();
+        input[1] = _Random16();
+        offset[0] = _Random16();
+        offset[1] = _Random16();
+        deadZone = (round & 1) ? TILT_DEAD_ZONE : (int16_t)(_Random() & INT16_MAX);
+        if(!_CurveMatches(input, offset, deadZone, curve))
+        {
+            mismatches ++;
+        }
+    }
+    TEST_CHECK_EQUAL(0, mismatches);
+}
+
+int main ( void )
+{
+    TEST_RUN(DotMatches);
+    TEST_RUN(CurveMatches);
+    return TEST_RESULT();
+}
@@ -0,0 +1,151 @@
+/*******************************************************************************
+  Idle Rate Tests
+
+  File Name:
+    test_hid_idle.c
+
+  Summary:
+    The host's SET_IDLE and GET_IDLE requests on a still mouse: a duration
+    of 0 sends nothing until something changes, a finite one repeats the
+    report every duration * 4 ms, report ID 0 stands for all reports and an
+    ID without an input report is stalled.
+*******************************************************************************/
+
+#include "system_config.h"
+#include "mouse.h"
+#include "sim_system.h"
+#include "test.h"
+
+#define SETTLE_US           300000
+#define WATCH_US            1000000
+
+static struct
+{
+    uint32_t reports;
+    uint32_t moved;
+    SIM_TIME last;
+    SIM_TIME gapMin;
+    SIM_TIME gapMax;
+
+} received;
+
+static bool _Flat ( uintptr_t context, SIM_ACCEL_SAMPLE * sample, SIM_TIME * interval )
+{
+    sample->x = 0;
+    sample->y = 0;
+    sample->z = 16384;
+    return true;
+}
+
+static void _Report ( uintptr_t context, const uint8_t * data, size_t length,
+                      SIM_TIME stamp, SIM_TIME time )
+{
+    if((length != MOUSE_REPORT_SIZE) || (data[0] != MOUSE_REPORT_ID))
+    {
+        return;
+    }
+    if(received.reports != 0)
+    {
+        if((time - received.last) < received.gapMin)
+        {
+            received.gapMin = time - received.last;
+        }
+        if((time - received.last) > received.gapMax)
+        {
+            received.gapMax = time - received.last;
+        }
+    }
+    if((data[2] | data[3] | data[4] | data[5]) != 0)
+    {
+        received.moved ++;
+    }
+    received.last = time;
+    received.reports ++;
+}
+
+static void _Watch ( void )
+{
+    received.reports = 0;
+    received.moved = 0;
+    received.gapMin = (SIM_TIME)-1;
+    received.gapMax = 0;
+    SIM_SYSTEM_RunUntil(SIM_CORE_Now() + SIM_US_TO_TICKS(WATCH_US));
+}
+
+/* The number of data bytes the transfer moved, or -1 if it was stalled */
+static int _ControlWait ( bool started )
+{
+    int result = -2;
+
+    TEST_CHECK(started);
+    while(started && !SIM_USB_ControlDone(&result))
+    {
+        SIM_SYSTEM_RunUntil(SIM_CORE_Now() + SIM_US_TO_TICKS(100));
+    }
+    return result;
+}
+
+static uint8_t _IdleGet ( uint8_t id )
+{
+    uint8_t duration = 0xFF;
+
+    TEST_CHECK_EQUAL(1, _ControlWait(SIM_USB_GetIdle(id, &duration)));
+    return duration;
+}
+
+static void RepeatsAtTheIdleRate ( void )
+{
+    SIM_SYSTEM_CONFIG config;
+    uint8_t duration;
+
+    SIM_SYSTEM_ConfigDefault(&config);
+    config.source = _Flat;
+    config.usb.reportHandler = _Report;
+    SIM_SYSTEM_Start(&config);
+    SIM_SYSTEM_RunUntil(SIM_US_TO_TICKS(SETTLE_US));
+    TEST_CHECK(SIM_USB_IsConfigured());
+
+    /* Indefinite by default: nothing changes, nothing is sent */
+    TEST_CHECK_EQUAL(0, _IdleGet(MOUSE_REPORT_ID));
+    _Watch();
+    TEST_CHECK_EQUAL(0, received.reports);
+
+    /* 100 ms for the mouse report */
+    TEST_CHECK_EQUAL(0, _ControlWait(SIM_USB_SetIdle(25, MOUSE_REPORT_ID)));
+    TEST_CHECK_EQUAL(25, _IdleGet(MOUSE_REPORT_ID));
+    _Watch();
+    TEST_CHECK(received.reports >= 9);
+    TEST_CHECK(received.reports <= 10);
+    TEST_CHECK_EQUAL(0, received.moved);
+    TEST_CHECK(received.gapMin >= SIM_US_TO_TICKS(100000 - 1000));
+    TEST_CHECK(received.gapMax <= SIM_US_TO_TICKS(100000 + 1000));
+
+    /* No input report has this ID */
+    duration = 0xFF;
+    TEST_CHECK_EQUAL(-1, _ControlWait(SIM_USB_SetIdle(5, MOUSE_REPORT_ID + 1)));
+    TEST_CHECK_EQUAL(-1, _ControlWait(SIM_USB_GetIdle(MOUSE_REPORT_ID + 1, &duration)));
+    TEST_CHECK_EQUAL(25, _IdleGet(MOUSE_REPORT_ID));
+
+    /* ID 0 sets all reports, 20 ms */
+    TEST_CHECK_EQUAL(0, _ControlWait(SIM_USB_SetIdle(5, 0)));
+    TEST_CHECK_EQUAL(5, _IdleGet(MOUSE_REPORT_ID));
+    TEST_CHECK_EQUAL(5, _IdleGet(0));
+    _Watch();
+    TEST_CHECK(received.reports >= 49);
+    TEST_CHECK(received.reports <= 50);
+    TEST_CHECK(received.gapMin >= SIM_US_TO_TICKS(20000 - 1000));
+    TEST_CHECK(received.gapMax <= SIM_US_TO_TICKS(20000 + 1000));
+
+    /* Back to indefinite; at most the report already due goes out */
+    TEST_CHECK_EQUAL(0, _ControlWait(SIM_USB_SetIdle(0, MOUSE_REPORT_ID)));
+    TEST_CHECK_EQUAL(0, _IdleGet(MOUSE_REPORT_ID));
+    SIM_SYSTEM_RunUntil(SIM_CORE_Now() + SIM_US_TO_TICKS(20000));
+    _Watch();
+    TEST_CHECK_EQUAL(0, received.reports);
+}
+
+int main ( void )
+{
+    TEST_RUN(RepeatsAtTheIdleRate);
+    return TEST_RESULT();
+}
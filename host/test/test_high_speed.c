@@ -0,0 +1,92 @@
+/*******************************************************************************
+  High Speed Tests
+
+  File Name:
+    test_high_speed.c
+
+  Summary:
+    On a high speed bus, with an SOF every 125 us microframe, the report
+    slot still comes before the next SOF, tilt goes out as mouse reports,
+    and the statistics window is one second of microframes.
+*******************************************************************************/
+
+#include "system_config.h"
+#include "mouse.h"
+#include "app.h"
+#include "sim_system.h"
+#include "test.h"
+
+#define SETTLE_US           200000
+#define WINDOW_WAIT_US      1200000
+
+static struct
+{
+    uint32_t reports;
+    int32_t x;
+    int32_t y;
+
+} received;
+
+static bool _Tilted ( uintptr_t context, SIM_ACCEL_SAMPLE * sample, SIM_TIME * interval )
+{
+    sample->x = 11585;
+    sample->y = 0;
+    sample->z = 11585;
+    return true;
+}
+
+static void _Report ( uintptr_t context, const uint8_t * data, size_t length,
+                      SIM_TIME stamp, SIM_TIME time )
+{
+    received.reports ++;
+    if((length == MOUSE_REPORT_SIZE) && (data[0] == MOUSE_REPORT_ID))
+    {
+        received.x += (int16_t)(data[2] | (data[3] << 8));
+        received.y += (int16_t)(data[4] | (data[5] << 8));
+    }
+}
+
+static uint32_t _Get32 ( const uint8_t * data )
+{
+    return data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+static void SendsTiltAtHighSpeed ( void )
+{
+    SIM_SYSTEM_CONFIG config;
+    uint8_t report[APP_STATS_REPORT_SIZE];
+    int result;
+
+    SIM_SYSTEM_ConfigDefault(&config);
+    config.source = _Tilted;
+    config.usb.highSpeed = true;
+    config.usb.reportHandler = _Report;
+    SIM_SYSTEM_Start(&config);
+
+    SIM_SYSTEM_RunUntil(SIM_US_TO_TICKS(SETTLE_US));
+    TEST_CHECK(SIM_USB_IsConfigured());
+    TEST_CHECK(received.reports > 100);
+    TEST_CHECK(received.x > 0);
+    TEST_CHECK_EQUAL(0, received.y);
+
+    /* The first complete window */
+    SIM_SYSTEM_RunUntil(SIM_US_TO_TICKS(WINDOW_WAIT_US));
+    TEST_CHECK(SIM_USB_GetReport(USB_HID_REPORT_TYPE_FEATURE, APP_STATS_REPORT_ID,
+                                 report, sizeof(report)));
+    while(!SIM_USB_ControlDone(&result))
+    {
+        SIM_SYSTEM_RunUntil(SIM_CORE_Now() + SIM_US_TO_TICKS(100));
+    }
+    TEST_CHECK_EQUAL(APP_STATS_REPORT_SIZE, result);
+    TEST_CHECK_EQUAL(APP_STATS_WINDOW_US / APP_USB_MICROFRAME_US, _Get32(&report[4]));
+
+    /* A report for each count of movement, a few hundred a second at this
+       tilt, all of them sent */
+    TEST_CHECK(_Get32(&report[8]) > 500);
+}
+
+int main ( void )
+{
+    TEST_RUN(SendsTiltAtHighSpeed);
+    return TEST_RESULT();
+}
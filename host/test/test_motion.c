@@ -0,0 +1,203 @@
+/*******************************************************************************
+  Motion Accumulator Tests
+
+  File Name:
+    test_motion.c
+
+  Summary:
+    What the reports carry adds up to the movement put in, over long traces
+    with reversals and steps larger than a report, and what saturation cuts
+    off is exactly what is counted as saturated.
+*******************************************************************************/
+
+#include "motion.h"
+#include "test.h"
+
+/* Movement put in and taken out since the last _Reset(), Q8.8 */
+static int64_t inX, inY;
+static int64_t outX, outY;
+static MOTION_ACCUMULATOR motion;
+
+static uint32_t randomState;
+
+static uint32_t _Random ( void )
+{
+    randomState = randomState * 1664525u + 1013904223u;
+    return randomState >> 8;
+}
+
+static void _Reset ( void )
+{
+    MOTION_Initialize(&motion);
+    inX = inY = outX = outY = 0;
+    randomState = 12345;
+}
+
+static void _Add ( int32_t dx, int32_t dy )
+{
+    MOTION_Add(&motion, dx, dy);
+    inX += dx;
+    inY += dy;
+}
+
+static bool _Take ( bool boot )
+{
+    MOUSE_COORDINATE x;
+    MOUSE_COORDINATE y;
+    bool moved;
+
+    moved = boot ? MOTION_TakeBoot(&motion, &x, &y) : MOTION_Take(&motion, &x, &y);
+
+    TEST_CHECK(x >= (boot ? MOUSE_BOOT_COORDINATE_MIN : MOUSE_COORDINATE_MIN));
+    TEST_CHECK(x <= (boot ? MOUSE_BOOT_COORDINATE_MAX : MOUSE_COORDINATE_MAX));
+    TEST_CHECK(y >= (boot ? MOUSE_BOOT_COORDINATE_MIN : MOUSE_COORDINATE_MIN));
+    TEST_CHECK(y <= (boot ? MOUSE_BOOT_COORDINATE_MAX : MOUSE_COORDINATE_MAX));
+    TEST_CHECK_EQUAL((x != 0) || (y != 0), moved);
+
+    outX += (int64_t)x * MOTION_ONE;
+    outY += (int64_t)y * MOTION_ONE;
+    return moved;
+}
+
+/* Takes reports until no whole count is left, and checks the books */
+static void _Drain ( bool boot, int64_t lost )
+{
+    while(_Take(boot))
+    {
+    }
+    TEST_CHECK(!MOTION_IsPending(&motion));
+
+    /* Only a fraction stays behind, and nothing went missing */
+    TEST_CHECK(motion.x > -MOTION_ONE && motion.x < MOTION_ONE);
+    TEST_CHECK(motion.y > -MOTION_ONE && motion.y < MOTION_ONE);
+    TEST_CHECK_EQUAL(inX - lost, outX + motion.x);
+    TEST_CHECK_EQUAL(inY, outY + motion.y);
+}
+
+static void LongTraceAddsUp ( void )
+{
+    int32_t speedX = 0;
+    int32_t speedY = 0;
+    unsigned int step;
+
+    _Reset();
+
+    /* A wandering speed of up to +/- 4 counts a sample on each axis, with
+       noise, that crosses zero every few hundred samples, and a report
+       every one to four samples */
+    for(step = 0; step < 1000000; step ++)
+    {
+        speedX += (int32_t)(_Random() % 33) - 16;
+        speedY += (int32_t)(_Random() % 33) - 16;
+        speedX = (speedX > 4 * MOTION_ONE) ? 4 * MOTION_ONE :
+                 (speedX < -4 * MOTION_ONE) ? -4 * MOTION_ONE : speedX;
+        speedY = (speedY > 4 * MOTION_ONE) ? 4 * MOTION_ONE :
+                 (speedY < -4 * MOTION_ONE) ? -4 * MOTION_ONE : speedY;
+
+        _Add(speedX + (int32_t)(_Random() % 65) - 32,
+             speedY + (int32_t)(_Random() % 65) - 32);
+
+        if((_Random() % 4) == 0)
+        {
+            _Take((step & 0x10000) != 0);
+        }
+        if((step % 1000) == 0)
+        {
+            TEST_CHECK_EQUAL(inX, outX + motion.x);
+            TEST_CHECK_EQUAL(inY, outY + motion.y);
+        }
+    }
+    _Drain(false, 0);
+    TEST_CHECK_EQUAL(0, motion.saturated);
+}
+
+static void LargeStepsAreSplit ( void )
+{
+    MOUSE_COORDINATE x;
+    MOUSE_COORDINATE y;
+
+    _Reset();
+
+    _Add(1000 * MOTION_ONE + 77, -300 * MOTION_ONE - 200);
+    TEST_CHECK(MOTION_TakeBoot(&motion, &x, &y));
+    TEST_CHECK_EQUAL(MOUSE_BOOT_COORDINATE_MAX, x);
+    TEST_CHECK_EQUAL(MOUSE_BOOT_COORDINATE_MIN, y);
+    outX += x * MOTION_ONE;
+    outY += y * MOTION_ONE;
+
+    /* A step the other way is taken from what is still pending */
+    _Add(-5000 * MOTION_ONE, 600 * MOTION_ONE);
+    _Drain(true, 0);
+
+    _Add(100000 * MOTION_ONE + 1, 3);
+    _Drain(false, 0);
+    TEST_CHECK_EQUAL(0, motion.saturated);
+}
+
+static void ReversalCancelsTheFraction ( void )
+{
+    _Reset();
+
+    /* Three quarters forward, then one back: the quarter back is a fraction
+       and must not be sent as a step */
+    _Add(3 * MOTION_ONE / 4, 0);
+    TEST_CHECK(!_Take(false));
+    _Add(-MOTION_ONE, 0);
+    TEST_CHECK(!_Take(false));
+    TEST_CHECK_EQUAL(-MOTION_ONE / 4, motion.x);
+
+    _Add(-3 * MOTION_ONE / 4, 0);
+    TEST_CHECK(_Take(false));
+    TEST_CHECK_EQUAL(-MOTION_ONE, outX);
+    _Drain(false, 0);
+}
+
+static void SaturationIsCounted ( void )
+{
+    const int32_t step = MOTION_ACCUMULATOR_LIMIT / 4;
+    unsigned int index;
+
+    _Reset();
+
+    /* Nobody takes anything: five quarters of the limit go in, one quarter
+       and a bit is cut off */
+    for(index = 0; index < 5; index ++)
+    {
+        _Add(step, -step / 2);
+    }
+    _Add(10 * MOTION_ONE + 1, 0);
+    TEST_CHECK_EQUAL(MOTION_ACCUMULATOR_LIMIT, motion.x);
+    TEST_CHECK_EQUAL(-(step / 2) * 5, motion.y);
+
+    /* Each cut rounded up to whole counts */
+    TEST_CHECK_EQUAL((5 * (int64_t)step - MOTION_ACCUMULATOR_LIMIT +
+                      MOTION_ONE - 1) / MOTION_ONE + 11, motion.saturated);
+
+    /* Reversing takes from the saturated total and nothing more is lost */
+    _Add(-step, step);
+    _Drain(false, 5 * (int64_t)step + 10 * MOTION_ONE + 1 - MOTION_ACCUMULATOR_LIMIT);
+
+    /* The other way, on y */
+    _Reset();
+    for(index = 0; index < 6; index ++)
+    {
+        _Add(0, -step);
+    }
+    TEST_CHECK_EQUAL(-MOTION_ACCUMULATOR_LIMIT, motion.y);
+    TEST_CHECK_EQUAL((6 * (int64_t)step - MOTION_ACCUMULATOR_LIMIT +
+                      MOTION_ONE - 1) / MOTION_ONE, motion.saturated);
+    inY += 6 * (int64_t)step - MOTION_ACCUMULATOR_LIMIT;
+    _Drain(false, 0);
+}
+
+int main ( void )
+{
+    TEST_RUN(LongTraceAddsUp);
+    TEST_RUN(LargeStepsAreSplit);
+    TEST_RUN(ReversalCancelsTheFraction);
+    TEST_RUN(SaturationIsCounted);
+    return TEST_RESULT();
+}
+/*******************************************************************************
+ End of File
+ */
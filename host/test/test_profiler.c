@@ -0,0 +1,118 @@
+/*******************************************************************************
+  Profiler Tests
+
+  File Name:
+    test_profiler.c
+
+  Summary:
+    Histogram bins, saturation and packing, the feature report, and the
+    durations PROFILER_MEASURE() takes from the core timer.
+*******************************************************************************/
+
+#include <string.h>
+#include "sim_core.h"
+#include "profiler.h"
+#include "test.h"
+
+static uint32_t _Unpack32 ( const uint8_t * buffer )
+{
+    return buffer[0] | (buffer[1] << 8) | (buffer[2] << 16) | ((uint32_t)buffer[3] << 24);
+}
+
+static void BinsAreLog2 ( void )
+{
+    TEST_CHECK_EQUAL(0, PROFILER_BinGet(0));
+    TEST_CHECK_EQUAL(0, PROFILER_BinGet(1));
+    TEST_CHECK_EQUAL(1, PROFILER_BinGet(2));
+    TEST_CHECK_EQUAL(1, PROFILER_BinGet(3));
+    TEST_CHECK_EQUAL(2, PROFILER_BinGet(4));
+    TEST_CHECK_EQUAL(9, PROFILER_BinGet(1000));
+    TEST_CHECK_EQUAL(15, PROFILER_BinGet(1u << 15));
+    TEST_CHECK_EQUAL(PROFILER_BINS - 1, PROFILER_BinGet(UINT32_MAX));
+}
+
+static void HistogramCountsAndKeepsTheMaximum ( void )
+{
+    PROFILER_HISTOGRAM histogram;
+
+    PROFILER_HistogramClear(&histogram);
+    PROFILER_HistogramAdd(&histogram, 5);
+    PROFILER_HistogramAdd(&histogram, 6);
+    PROFILER_HistogramAdd(&histogram, 700);
+    PROFILER_HistogramAdd(&histogram, 3);
+
+    TEST_CHECK_EQUAL(700, histogram.max);
+    TEST_CHECK_EQUAL(1, histogram.bins[1]);
+    TEST_CHECK_EQUAL(2, histogram.bins[2]);
+    TEST_CHECK_EQUAL(1, histogram.bins[9]);
+}
+
+static void HistogramSaturates ( void )
+{
+    PROFILER_HISTOGRAM histogram;
+
+    PROFILER_HistogramClear(&histogram);
+    histogram.bins[4] = UINT32_MAX - 1;
+    PROFILER_HistogramAdd(&histogram, 20);
+    PROFILER_HistogramAdd(&histogram, 20);
+    TEST_CHECK_EQUAL(UINT32_MAX, histogram.bins[4]);
+}
+
+static void HistogramPacksLittleEndian ( void )
+{
+    PROFILER_HISTOGRAM histogram;
+    uint8_t buffer[PROFILER_HISTOGRAM_BYTES];
+
+    PROFILER_HistogramClear(&histogram);
+    histogram.max = 0x12345678;
+    histogram.bins[0] = 0x01020304;
+    histogram.bins[PROFILER_BINS - 1] = 0xA0B0C0D0;
+    PROFILER_HistogramPack(&histogram, buffer);
+
+    TEST_CHECK_EQUAL(0x78, buffer[0]);
+    TEST_CHECK_EQUAL(0x12, buffer[3]);
+    TEST_CHECK_EQUAL(0x01020304, _Unpack32(&buffer[4]));
+    TEST_CHECK_EQUAL(0xA0B0C0D0, _Unpack32(&buffer[4 * PROFILER_BINS]));
+}
+
+/* Spends ticks core timer ticks */
+static void _Work ( uint32_t ticks )
+{
+    SIM_CORE_Spend(2 * ticks);
+}
+
+static void MeasureTimesTheCall ( void )
+{
+    uint8_t report[PROFILER_REPORT_SIZE];
+    const uint8_t * app = &report[5 + PROFILER_TASK_APP * PROFILER_HISTOGRAM_BYTES];
+    const uint8_t * wheel = &report[5 + PROFILER_TASK_TIMER_WHEEL * PROFILER_HISTOGRAM_BYTES];
+
+    SIM_CORE_Reset();
+    PROFILER_MEASURE(PROFILER_TASK_APP, _Work(1500));
+    PROFILER_MEASURE(PROFILER_TASK_APP, _Work(40));
+    PROFILER_MEASURE(PROFILER_TASK_TIMER_WHEEL, _Work(0));
+
+    memset(report, 0xEE, sizeof(report));
+    PROFILER_ReportGet(report);
+
+    TEST_CHECK_EQUAL(PROFILER_REPORT_ID, report[0]);
+    TEST_CHECK_EQUAL(PROFILER_REPORT_FORMAT, report[1]);
+    TEST_CHECK_EQUAL(PROFILER_TASKS, report[2]);
+    TEST_CHECK_EQUAL(PROFILER_BINS, report[3]);
+
+    TEST_CHECK_EQUAL(1500, _Unpack32(app));
+    TEST_CHECK_EQUAL(1, _Unpack32(&app[4 * (1 + PROFILER_BinGet(1500))]));
+    TEST_CHECK_EQUAL(1, _Unpack32(&app[4 * (1 + PROFILER_BinGet(40))]));
+    TEST_CHECK_EQUAL(0, _Unpack32(wheel));
+    TEST_CHECK_EQUAL(1, _Unpack32(&wheel[4]));
+}
+
+int main ( void )
+{
+    TEST_RUN(BinsAreLog2);
+    TEST_RUN(HistogramCountsAndKeepsTheMaximum);
+    TEST_RUN(HistogramSaturates);
+    TEST_RUN(HistogramPacksLittleEndian);
+    TEST_RUN(MeasureTimesTheCall);
+    return TEST_RESULT();
+}
@@ -0,0 +1,122 @@
+/*******************************************************************************
+  Replay Tests
+
+  File Name:
+    test_replay.c
+
+  Summary:
+    A trace with every other sample missing, as a decimated capture has
+    them, replays one sample per sensor period with the gaps held, and its
+    tilt comes out as mouse movement.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <unistd.h>
+#include "system_config.h"
+#include "accel.h"
+#include "mouse.h"
+#include "sim_system.h"
+#include "sim_trace.h"
+#include "test.h"
+
+#define SETTLE_US           300000
+
+/* Records in the trace, two sample periods apart */
+#define RECORDS             800
+#define FIRST_SEQUENCE      0xFF00
+
+static SIM_TRACE trace;
+static bool replaying;
+static bool ended;
+
+static struct
+{
+    uint32_t reports;
+    int32_t x;
+    int32_t y;
+
+} received;
+
+static bool _Source ( uintptr_t context, SIM_ACCEL_SAMPLE * sample, SIM_TIME * interval )
+{
+    if(!replaying)
+    {
+        *sample = trace.held;
+        return true;
+    }
+    if(!SIM_TRACE_Source((uintptr_t)&trace, sample, interval))
+    {
+        ended = true;
+        return false;
+    }
+    return true;
+}
+
+static void _Report ( uintptr_t context, const uint8_t * data, size_t length,
+                      SIM_TIME stamp, SIM_TIME time )
+{
+    if(replaying && (length == MOUSE_REPORT_SIZE) && (data[0] == MOUSE_REPORT_ID))
+    {
+        received.reports ++;
+        received.x += (int16_t)(data[2] | (data[3] << 8));
+        received.y += (int16_t)(data[4] | (data[5] << 8));
+    }
+}
+
+static void ReplaysWithGapsHeld ( void )
+{
+    SIM_SYSTEM_CONFIG config;
+    SIM_ACCEL_SAMPLE sample;
+    char path[] = "/tmp/test_replay_XXXXXX";
+    uint32_t period = SIM_TICKS_PER_SECOND / ACC_ODR_HZ;
+    uint32_t produced;
+    unsigned int index;
+
+    /* Flat for the first record, then tilted 45 degrees to the right. The
+       sequence numbers wrap on the way. */
+    close(mkstemp(path));
+    TEST_CHECK(SIM_TRACE_Create(&trace, path, SIM_TICKS_PER_SECOND, ACC_ODR_HZ));
+    for(index = 0; index < RECORDS; index ++)
+    {
+        sample.x = (index == 0) ? 0 : 11585;
+        sample.y = 0;
+        sample.z = (index == 0) ? 16384 : 11585;
+        SIM_TRACE_Write(&trace, (uint16_t)(FIRST_SEQUENCE + 2 * index),
+                        0x12345678u + 2 * index * period, &sample);
+    }
+    SIM_TRACE_Close(&trace);
+
+    TEST_CHECK(SIM_TRACE_Open(&trace, path));
+    TEST_CHECK(SIM_TRACE_ReplayStart(&trace));
+    TEST_CHECK_EQUAL(0, trace.held.x);
+
+    SIM_SYSTEM_ConfigDefault(&config);
+    config.source = _Source;
+    config.usb.reportHandler = _Report;
+    SIM_SYSTEM_Start(&config);
+    SIM_SYSTEM_RunUntil(SIM_US_TO_TICKS(SETTLE_US));
+    TEST_CHECK(SIM_USB_IsConfigured());
+
+    produced = SIM_ACCEL_StatsGet()->produced;
+    replaying = true;
+    while(!ended)
+    {
+        SIM_SYSTEM_RunUntil(SIM_CORE_Now() + SIM_US_TO_TICKS(10000));
+    }
+    SIM_SYSTEM_RunUntil(SIM_CORE_Now() + SIM_US_TO_TICKS(10000));
+    SIM_TRACE_Close(&trace);
+    remove(path);
+
+    /* One sample per sequence number from the first record to the last */
+    TEST_CHECK_EQUAL(2 * (RECORDS - 1) + 1, SIM_ACCEL_StatsGet()->produced - produced);
+    TEST_CHECK_EQUAL(0, SIM_ACCEL_StatsGet()->overwritten);
+    TEST_CHECK(received.reports > 100);
+    TEST_CHECK(received.x > 0);
+    TEST_CHECK_EQUAL(0, received.y);
+}
+
+int main ( void )
+{
+    TEST_RUN(ReplaysWithGapsHeld);
+    return TEST_RESULT();
+}
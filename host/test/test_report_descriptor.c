@@ -0,0 +1,180 @@
+/*******************************************************************************
+  Report Descriptor Tests
+
+  File Name:
+    test_report_descriptor.c
+
+  Summary:
+    Walks the items of the HID report descriptor the device hands out and
+    checks that every report it describes is as long as the buffer the
+    firmware sends or answers it with.
+*******************************************************************************/
+
+#include <string.h>
+#include "system_config.h"
+#include "usb/usb_device_hid.h"
+#include "mouse.h"
+#include "profiler.h"
+#include "trace.h"
+#include "capture.h"
+#include "app.h"
+#include "test.h"
+
+/* From the system configuration */
+extern const USB_DEVICE_HID_INIT hidInit0;
+
+#define MAIN_INPUT          0x80
+#define MAIN_OUTPUT         0x90
+#define MAIN_FEATURE        0xB0
+#define MAIN_COLLECTION     0xA0
+#define MAIN_END_COLLECTION 0xC0
+#define GLOBAL_REPORT_SIZE  0x74
+#define GLOBAL_REPORT_ID    0x84
+#define GLOBAL_REPORT_COUNT 0x94
+#define LONG_ITEM           0xFE
+
+enum { INPUT, OUTPUT, FEATURE, TYPES };
+
+/* Bits of each report, by type and report ID, and whether it appears */
+static uint32_t bits[TYPES][256];
+static bool described[TYPES][256];
+static bool isWellFormed;
+
+static void _Walk ( const uint8_t * item, size_t length )
+{
+    const uint8_t * end = item + length;
+    uint32_t reportSize = 0;
+    uint32_t reportCount = 0;
+    uint8_t reportID = 0;
+    int depth = 0;
+    uint32_t value;
+    size_t size;
+    int type;
+
+    memset(bits, 0, sizeof(bits));
+    memset(described, 0, sizeof(described));
+    isWellFormed = false;
+
+    while(item < end)
+    {
+        if(item[0] == LONG_ITEM)
+        {
+            if((item + 3 > end) || (item + 3 + item[1] > end))
+            {
+                return;
+            }
+            item += 3 + item[1];
+            continue;
+        }
+
+        size = ((item[0] & 0x03) == 3) ? 4 : (item[0] & 0x03);
+        if(item + 1 + size > end)
+        {
+            return;
+        }
+        value = 0;
+        while(size > 0)
+        {
+            value = (value << 8) | item[size];
+            size --;
+        }
+
+        type = -1;
+        switch(item[0] & 0xFC)
+        {
+            case GLOBAL_REPORT_SIZE:
+                reportSize = value;
+                break;
+            case GLOBAL_REPORT_ID:
+                reportID = (uint8_t)value;
+                break;
+            case GLOBAL_REPORT_COUNT:
+                reportCount = value;
+                break;
+            case MAIN_INPUT:
+                type = INPUT;
+                break;
+            case MAIN_OUTPUT:
+                type = OUTPUT;
+                break;
+            case MAIN_FEATURE:
+                type = FEATURE;
+                break;
+            case MAIN_COLLECTION:
+                depth ++;
+                break;
+            case MAIN_END_COLLECTION:
+                depth --;
+                if(depth < 0)
+                {
+                    return;
+                }
+                break;
+            default:
+                break;
+        }
+        if(type >= 0)
+        {
+            bits[type][reportID] += reportSize * reportCount;
+            described[type][reportID] = true;
+        }
+
+        item += 1 + (((item[0] & 0x03) == 3) ? 4 : (item[0] & 0x03));
+    }
+    isWellFormed = (depth == 0);
+}
+
+/* The length of a report on the wire, its report ID byte included */
+static uint32_t _ReportBytes ( int type, uint8_t reportID )
+{
+    TEST_CHECK(described[type][reportID]);
+    TEST_CHECK_EQUAL(0, bits[type][reportID] % 8);
+    return bits[type][reportID] / 8 + ((reportID != 0) ? 1 : 0);
+}
+
+static void DescribesEveryReport ( void )
+{
+    unsigned int reports = 0;
+    unsigned int expected = 1;
+    unsigned int id;
+    int type;
+
+    _Walk(hidInit0.hidReportDescriptor, hidInit0.hidReportDescriptorSize);
+    TEST_CHECK(isWellFormed);
+
+    TEST_CHECK_EQUAL(sizeof(MOUSE_REPORT), _ReportBytes(INPUT, MOUSE_REPORT_ID));
+    TEST_CHECK_EQUAL(MOUSE_REPORT_SIZE, sizeof(MOUSE_REPORT));
+#if PROFILER_ENABLE
+    /* Past 255 bytes, in a two byte Report Count */
+    TEST_CHECK_EQUAL(PROFILER_REPORT_SIZE, _ReportBytes(FEATURE, PROFILER_REPORT_ID));
+    expected ++;
+#endif
+#if TRACE_ENABLE
+    TEST_CHECK_EQUAL(TRACE_REPORT_SIZE, _ReportBytes(FEATURE, TRACE_REPORT_ID));
+    expected ++;
+#endif
+#if APP_STATS_ENABLE
+    TEST_CHECK_EQUAL(APP_STATS_REPORT_SIZE, _ReportBytes(FEATURE, APP_STATS_REPORT_ID));
+    expected ++;
+#endif
+#if CAPTURE_ENABLE
+    TEST_CHECK_EQUAL(CAPTURE_REPORT_SIZE, _ReportBytes(FEATURE, CAPTURE_REPORT_ID));
+    expected ++;
+#endif
+
+    /* Nothing else */
+    for(type = 0; type < TYPES; type ++)
+    {
+        for(id = 0; id < 256; id ++)
+        {
+            reports += described[type][id] ? 1 : 0;
+        }
+    }
+    TEST_CHECK_EQUAL(expected, reports);
+}
+
+int main ( void )
+{
+    TEST_RUN(DescribesEveryReport);
+    return TEST_RESULT();
+}
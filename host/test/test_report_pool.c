@@ -0,0 +1,109 @@
+/*******************************************************************************
+  Report Buffer Pool Tests
+
+  File Name:
+    test_report_pool.c
+
+  Summary:
+    Buffers go from free to staged to owned and back, and a completion frees
+    the oldest of the buffers submitted with its handle, as the HID driver
+    reuses handles.
+*******************************************************************************/
+
+#include "report_pool.h"
+#include "test.h"
+
+/* Stand-ins for the IRP addresses the HID driver hands out */
+#define HANDLE_A    ((USB_DEVICE_HID_TRANSFER_HANDLE)0x1000)
+#define HANDLE_B    ((USB_DEVICE_HID_TRANSFER_HANDLE)0x1040)
+
+static REPORT_POOL pool;
+
+static void BuffersCycle ( void )
+{
+    int first;
+    int second;
+
+    REPORT_POOL_Initialize(&pool);
+
+    first = REPORT_POOL_Stage(&pool);
+    TEST_CHECK(first != REPORT_POOL_NONE);
+    REPORT_POOL_Unstage(&pool, first);
+    TEST_CHECK_EQUAL(first, REPORT_POOL_Stage(&pool));
+    REPORT_POOL_Submit(&pool, first, HANDLE_A);
+
+    second = REPORT_POOL_Stage(&pool);
+    TEST_CHECK(second != REPORT_POOL_NONE);
+    TEST_CHECK(second != first);
+    REPORT_POOL_Submit(&pool, second, HANDLE_B);
+
+    TEST_CHECK_EQUAL(REPORT_POOL_NONE, REPORT_POOL_Stage(&pool));
+    TEST_CHECK_EQUAL(2, REPORT_POOL_OwnedCount(&pool));
+
+    TEST_CHECK_EQUAL(second, REPORT_POOL_Release(&pool, HANDLE_B));
+    TEST_CHECK_EQUAL(REPORT_POOL_NONE, REPORT_POOL_Release(&pool, HANDLE_B));
+    TEST_CHECK_EQUAL(first, REPORT_POOL_Release(&pool, HANDLE_A));
+    TEST_CHECK_EQUAL(0, REPORT_POOL_OwnedCount(&pool));
+}
+
+static void DuplicateHandlesReleaseInOrder ( void )
+{
+    int first;
+    int second;
+    int round;
+
+    REPORT_POOL_Initialize(&pool);
+
+    /* Submit the higher index first, so that index order and submission
+       order disagree every other round, and start near the wrap of the
+       submission count */
+    pool.submitted = UINT32_MAX - 2;
+    for(round = 0; round < 6; round ++)
+    {
+        first = REPORT_POOL_Stage(&pool);
+        second = REPORT_POOL_Stage(&pool);
+        if((round & 1) == 0)
+        {
+            int swap = first;
+            first = second;
+            second = swap;
+        }
+
+        /* The IRP of the first transfer completed and was reused for the
+           second before the application saw the first completion */
+        REPORT_POOL_Submit(&pool, first, HANDLE_A);
+        REPORT_POOL_Submit(&pool, second, HANDLE_A);
+
+        TEST_CHECK_EQUAL(first, REPORT_POOL_Release(&pool, HANDLE_A));
+        TEST_CHECK_EQUAL(1, REPORT_POOL_OwnedCount(&pool));
+        TEST_CHECK_EQUAL(second, REPORT_POOL_Release(&pool, HANDLE_A));
+        TEST_CHECK_EQUAL(REPORT_POOL_NONE, REPORT_POOL_Release(&pool, HANDLE_A));
+    }
+}
+
+static void CancelledTransfersAreIgnored ( void )
+{
+    int index;
+
+    REPORT_POOL_Initialize(&pool);
+    index = REPORT_POOL_Stage(&pool);
+    REPORT_POOL_Submit(&pool, index, HANDLE_A);
+
+    /* Reset: the pool starts over before the cancelled transfer completes */
+    REPORT_POOL_Initialize(&pool);
+    index = REPORT_POOL_Stage(&pool);
+    REPORT_POOL_Submit(&pool, index, HANDLE_B);
+    TEST_CHECK_EQUAL(REPORT_POOL_NONE, REPORT_POOL_Release(&pool, HANDLE_A));
+    TEST_CHECK_EQUAL(1, REPORT_POOL_OwnedCount(&pool));
+}
+
+int main ( void )
+{
+    TEST_RUN(BuffersCycle);
+    TEST_RUN(DuplicateHandlesReleaseInOrder);
+    TEST_RUN(CancelledTransfersAreIgnored);
+    return TEST_RESULT();
+}
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,101 @@
+/*******************************************************************************
+  Report Trace Tests
+
+  File Name:
+    test_report_trace.c
+
+  Summary:
+    The tracer records each report's completion with the number and sample
+    of that report, and with room for two reports in the HID driver and a
+    host that polls every other frame, the firmware still never queues a
+    report behind one that is waiting for its IN token.
+*******************************************************************************/
+
+#include "system_config.h"
+#include "sim_system.h"
+#include "trace.h"
+#include "test.h"
+
+/* Tilted 45 degrees to the right, enough to move every frame */
+static bool _Tilted ( uintptr_t context, SIM_ACCEL_SAMPLE * sample, SIM_TIME * interval )
+{
+    sample->x = 11585;
+    sample->y = 0;
+    sample->z = 11585;
+    return true;
+}
+
+static void TraceFollowsEachReport ( void )
+{
+    SIM_SYSTEM_CONFIG config;
+    uint8_t report[TRACE_REPORT_SIZE];
+    uint16_t sampleOf[256];
+    bool isSent[256] = { false };
+    unsigned int inFlight = 0;
+    unsigned int inFlightMax = 0;
+    unsigned int sent = 0;
+    unsigned int count;
+    unsigned int index;
+
+    /* A host that polls every other frame, so that a report is still
+       waiting at the next frame's slot */
+    SIM_SYSTEM_ConfigDefault(&config);
+    config.source = _Tilted;
+    config.usb.interval = 2;
+    SIM_SYSTEM_Start(&config);
+    SIM_SYSTEM_RunUntil(SIM_US_TO_TICKS(100000));
+
+    /* Start with an empty ring, then trace some more */
+    do
+    {
+        TRACE_ReportGet(report);
+    } while(report[2] != 0);
+    SIM_SYSTEM_RunUntil(SIM_CORE_Now() + SIM_US_TO_TICKS(40000));
+
+    do
+    {
+        TRACE_ReportGet(report);
+        count = report[2];
+        TEST_CHECK_EQUAL(0, report[4] | (report[5] << 8));
+
+        for(index = 0; index < count; index ++)
+        {
+            const uint8_t * record = &report[TRACE_REPORT_HEADER_BYTES +
+                                             index * TRACE_RECORD_BYTES];
+            uint8_t number = record[5];
+            uint16_t sample = record[6] | (record[7] << 8);
+
+            if(record[4] == TRACE_EVENT_REPORT_SEND)
+            {
+                sampleOf[number] = sample;
+                isSent[number] = true;
+                inFlight ++;
+                inFlightMax = (inFlight > inFlightMax) ? inFlight : inFlightMax;
+            }
+            else if((record[4] == TRACE_EVENT_REPORT_SENT) && isSent[number])
+            {
+                /* The report in the buffer that came back, with its own
+                   sample, not the last one built */
+                TEST_CHECK_EQUAL(sampleOf[number], sample);
+                isSent[number] = false;
+                inFlight --;
+                sent ++;
+            }
+        }
+    } while(count != 0);
+
+    TEST_CHECK(sent > 10);
+
+    /* A second report would only have gone out behind the first, with
+       older movement than the report built after the first had gone */
+    TEST_CHECK_EQUAL(1, inFlightMax);
+}
+
+int main ( void )
+{
+    TEST_RUN(TraceFollowsEachReport);
+    return TEST_RESULT();
+}
+/*******************************************************************************
+ End of File
+ */
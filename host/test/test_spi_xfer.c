@@ -0,0 +1,147 @@
+/*******************************************************************************
+  SPI Transaction Engine Tests
+
+  File Name:
+    test_spi_xfer.c
+
+  Summary:
+    Interrupt and DMA mode transactions complete in order on the simulated
+    SPI1 and DMA controller, including an interrupt mode transaction
+    started from the DMA completion while the DMA interrupt is still busy.
+*******************************************************************************/
+
+#include <string.h>
+#include "system_config.h"
+#include "system_definitions.h"
+#include "spi_xfer.h"
+#include "sim_board.h"
+#include "sim_spi.h"
+#include "test.h"
+
+#define TRANSACTIONS        32
+
+static SPI_XFER_DESCRIPTOR xfers[TRANSACTIONS];
+static uint8_t tx[TRANSACTIONS][8];
+static uint8_t rx[TRANSACTIONS][8];
+static unsigned int completed[TRANSACTIONS];
+static unsigned int completedCount;
+
+/* Cycles a completion callback takes, during which the next transaction
+   runs on the bus */
+static uint32_t callbackCycles;
+
+/* Answers each byte with its complement */
+static uint8_t _Slave ( uint8_t mosi )
+{
+    return (uint8_t)~mosi;
+}
+
+static void _Completed ( SPI_XFER_DESCRIPTOR * xfer, uintptr_t context )
+{
+    completed[completedCount ++] = (unsigned int)context;
+    SIM_CORE_Spend(callbackCycles);
+}
+
+static void _Setup ( void )
+{
+    SIM_CORE_Reset();
+    SIM_BOARD_Reset();
+    SIM_SPI_Reset();
+    SIM_SPI_SlaveSet(_Slave);
+    SIM_CORE_VectorsSet(sysVectors);
+
+    SYS_INT_Initialize();
+    SYS_INT_VectorPrioritySet(INT_VECTOR_SPI1, INT_PRIORITY_LEVEL3);
+    SYS_INT_VectorPrioritySet(INT_VECTOR_DMA1, INT_PRIORITY_LEVEL3);
+    SPI_XFER_Initialize();
+    SYS_INT_Enable();
+
+    memset(xfers, 0, sizeof(xfers));
+    memset(rx, 0, sizeof(rx));
+    completedCount = 0;
+    callbackCycles = 0;
+}
+
+static SPI_XFER_DESCRIPTOR * _Xfer ( unsigned int index, size_t length, SPI_XFER_MODE mode )
+{
+    SPI_XFER_DESCRIPTOR * xfer = &xfers[index];
+    unsigned int byte;
+
+    for(byte = 0; byte < length; byte ++)
+    {
+        tx[index][byte] = (uint8_t)(index * 16 + byte);
+    }
+    xfer->csChannel = PORT_CHANNEL_B;
+    xfer->csBitPos = PORTS_BIT_POS_4;
+    xfer->txBuffer = tx[index];
+    xfer->rxBuffer = rx[index];
+    xfer->length = length;
+    xfer->mode = mode;
+    xfer->callback = _Completed;
+    xfer->context = index;
+    return xfer;
+}
+
+static void _CheckCompleted ( unsigned int count )
+{
+    unsigned int index;
+    unsigned int byte;
+
+    TEST_CHECK_EQUAL(count, completedCount);
+    TEST_CHECK(!SPI_XFER_IsBusy());
+    TEST_CHECK(LATBbits.LATB4);
+
+    for(index = 0; index < completedCount; index ++)
+    {
+        TEST_CHECK_EQUAL(index, completed[index]);
+        TEST_CHECK_EQUAL(SPI_XFER_STATUS_COMPLETE, xfers[index].status);
+        for(byte = 0; byte < xfers[index].length; byte ++)
+        {
+            TEST_CHECK_EQUAL((uint8_t)~tx[index][byte], rx[index][byte]);
+        }
+    }
+}
+
+static void BothModesComplete ( void )
+{
+    _Setup();
+    TEST_CHECK(SPI_XFER_Submit(_Xfer(0, 4, SPI_XFER_MODE_INTERRUPT)));
+    TEST_CHECK(SPI_XFER_Submit(_Xfer(1, 7, SPI_XFER_MODE_DMA)));
+    TEST_CHECK(!SPI_XFER_Submit(&xfers[1]));
+    TEST_CHECK(SPI_XFER_Submit(_Xfer(2, 2, SPI_XFER_MODE_INTERRUPT)));
+
+    SIM_CORE_RunUntil(SIM_CORE_Now() + SIM_US_TO_TICKS(100));
+    _CheckCompleted(3);
+    /* Each byte is moved once by either channel */
+    TEST_CHECK_EQUAL(2 * 7, SIM_SPI_DmaBytesGet());
+}
+
+static void InterruptModeAfterDmaKeepsItsEvent ( void )
+{
+    unsigned int index;
+
+    /* The DMA completion starts the interrupt mode transaction queued
+       behind it, and its callback then keeps the CPU for longer than a
+       byte takes on the bus.  The byte's receive event must still reach
+       the SPI1 interrupt once the DMA interrupt returns. */
+    _Setup();
+    callbackCycles = 1000;
+    for(index = 0; index < TRANSACTIONS; index ++)
+    {
+        TEST_CHECK(SPI_XFER_Submit(_Xfer(index, 1 + (index % 8),
+                (index & 1) ? SPI_XFER_MODE_INTERRUPT : SPI_XFER_MODE_DMA)));
+    }
+
+    SIM_CORE_RunUntil(SIM_CORE_Now() + SIM_US_TO_TICKS(1000));
+    _CheckCompleted(TRANSACTIONS);
+}
+
+int main ( void )
+{
+    TEST_RUN(BothModesComplete);
+    TEST_RUN(InterruptModeAfterDmaKeepsItsEvent);
+    return TEST_RESULT();
+}
+/*******************************************************************************
+ End of File
+ */
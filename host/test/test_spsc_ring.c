@@ -0,0 +1,199 @@
+/*******************************************************************************
+  SPSC Ring Tests
+
+  File Name:
+    test_spsc_ring.c
+
+  Summary:
+    Elements come out in order and whole, through index wrap-around, with
+    a full ring dropping and counting what it cannot take, and with the
+    producer and the consumer on two threads.
+*******************************************************************************/
+
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include "spsc_ring.h"
+#include "test.h"
+
+typedef struct
+{
+    uint32_t sequence;
+    uint32_t check;
+
+} ELEMENT;
+
+SPSC_RING_DEFINE(ring, ELEMENT, 8);
+
+/* Enough to wrap the small ring many times over and to see it full */
+#define STRESS_ELEMENTS         1000000u
+
+static ELEMENT _Element ( uint32_t sequence )
+{
+    ELEMENT element = { sequence, ~sequence * 2654435761u };
+    return element;
+}
+
+static void _Reset ( unsigned int index )
+{
+    ring.head = index;
+    ring.tail = index;
+    ring.overflows = 0;
+}
+
+static void EmptyRingGivesNothing ( void )
+{
+    ELEMENT element = _Element(99);
+
+    _Reset(0);
+    TEST_CHECK_EQUAL(0, SPSC_RING_Count(&ring));
+    TEST_CHECK(!SPSC_RING_Get(&ring, &element));
+    TEST_CHECK_EQUAL(99, element.sequence);
+}
+
+static void FullRingDropsAndCounts ( void )
+{
+    ELEMENT element;
+    uint32_t sequence;
+
+    _Reset(0);
+    for(sequence = 0; sequence < 8; sequence ++)
+    {
+        element = _Element(sequence);
+        TEST_CHECK(SPSC_RING_Put(&ring, &element));
+    }
+    TEST_CHECK_EQUAL(8, SPSC_RING_Count(&ring));
+
+    element = _Element(8);
+    TEST_CHECK(!SPSC_RING_Put(&ring, &element));
+    TEST_CHECK(!SPSC_RING_Put(&ring, &element));
+    TEST_CHECK_EQUAL(2, SPSC_RING_OverflowsGet(&ring));
+    TEST_CHECK_EQUAL(8, SPSC_RING_Count(&ring));
+
+    /* What was queued is untouched by the drops */
+    for(sequence = 0; sequence < 8; sequence ++)
+    {
+        TEST_CHECK(SPSC_RING_Get(&ring, &element));
+        TEST_CHECK_EQUAL(sequence, element.sequence);
+    }
+    TEST_CHECK(!SPSC_RING_Get(&ring, &element));
+
+    /* Room again, and the count stays */
+    element = _Element(9);
+    TEST_CHECK(SPSC_RING_Put(&ring, &element));
+    TEST_CHECK_EQUAL(2, SPSC_RING_OverflowsGet(&ring));
+}
+
+static void IndexesWrapAround ( void )
+{
+    ELEMENT element;
+    uint32_t put = 0;
+    uint32_t got = 0;
+    unsigned int round;
+    unsigned int count;
+    unsigned int queued;
+
+    /* Start a few elements short of the free running counters wrapping, so
+       that both the slot index and the counters go round, and vary the fill
+       so that every slot is written at every level */
+    _Reset(UINT_MAX - 10);
+    for(round = 0; round < 40; round ++)
+    {
+        queued = SPSC_RING_Count(&ring);
+        for(count = 0; count <= (round % 7); count ++)
+        {
+            element = _Element(put ++);
+            TEST_CHECK(SPSC_RING_Put(&ring, &element));
+        }
+        TEST_CHECK_EQUAL(queued + (round % 7) + 1, SPSC_RING_Count(&ring));
+
+        /* Leave one behind every other round */
+        while(SPSC_RING_Count(&ring) > (round & 1))
+        {
+            TEST_CHECK(SPSC_RING_Get(&ring, &element));
+            TEST_CHECK_EQUAL(got ++, element.sequence);
+        }
+    }
+
+    while(SPSC_RING_Get(&ring, &element))
+    {
+        TEST_CHECK_EQUAL(got ++, element.sequence);
+    }
+    TEST_CHECK_EQUAL(put, got);
+    TEST_CHECK_EQUAL(0, SPSC_RING_OverflowsGet(&ring));
+    TEST_CHECK(ring.head < put);
+}
+
+static unsigned int producerRefused;
+
+static void * _Producer ( void * argument )
+{
+    ELEMENT element;
+    uint32_t sequence;
+
+    for(sequence = 0; sequence < STRESS_ELEMENTS; sequence ++)
+    {
+        element = _Element(sequence);
+        while(!SPSC_RING_Put(&ring, &element))
+        {
+            producerRefused ++;
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void TwoThreadsKeepOrder ( void )
+{
+    pthread_t producer;
+    ELEMENT element;
+    uint32_t expected = 0;
+    unsigned int torn = 0;
+    unsigned int outOfOrder = 0;
+    unsigned int empty = 0;
+
+    _Reset(UINT_MAX - 1000);
+    producerRefused = 0;
+    TEST_CHECK_EQUAL(0, pthread_create(&producer, NULL, _Producer, NULL));
+
+    while(expected < STRESS_ELEMENTS)
+    {
+        if(!SPSC_RING_Get(&ring, &element))
+        {
+            empty ++;
+            sched_yield();
+            continue;
+        }
+        if(element.check != _Element(element.sequence).check)
+        {
+            torn ++;
+        }
+        if(element.sequence != expected)
+        {
+            outOfOrder ++;
+        }
+        expected = element.sequence + 1;
+    }
+
+    TEST_CHECK_EQUAL(0, pthread_join(producer, NULL));
+    TEST_CHECK_EQUAL(0, torn);
+    TEST_CHECK_EQUAL(0, outOfOrder);
+    TEST_CHECK_EQUAL(0, SPSC_RING_Count(&ring));
+
+    /* Every refused put was counted as an overflow, and no more */
+    TEST_CHECK_EQUAL(producerRefused, SPSC_RING_OverflowsGet(&ring));
+    printf("  %u elements, %u refused while full, %u gets while empty\n",
+           STRESS_ELEMENTS, producerRefused, empty);
+}
+
+int main ( void )
+{
+    TEST_RUN(EmptyRingGivesNothing);
+    TEST_RUN(FullRingDropsAndCounts);
+    TEST_RUN(IndexesWrapAround);
+    TEST_RUN(TwoThreadsKeepOrder);
+    return TEST_RESULT();
+}
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,70 @@
+/*******************************************************************************
+  System Tests
+
+  File Name:
+    test_system.c
+
+  Summary:
+    The whole firmware boots on the simulated board, is configured by the
+    simulated host and sends tilt as mouse reports.
+*******************************************************************************/
+
+#include "system_config.h"
+#include "mouse.h"
+#include "sim_system.h"
+#include "sim_board.h"
+#include "test.h"
+
+static struct
+{
+    uint32_t reports;
+    int32_t x;
+    int32_t y;
+
+} received;
+
+/* Tilted 45 degrees to the right, enough to move every frame */
+static bool _Tilted ( uintptr_t context, SIM_ACCEL_SAMPLE * sample, SIM_TIME * interval )
+{
+    sample->x = 11585;
+    sample->y = 0;
+    sample->z = 11585;
+    return true;
+}
+
+static void _Report ( uintptr_t context, const uint8_t * data, size_t length,
+                      SIM_TIME stamp, SIM_TIME time )
+{
+    received.reports ++;
+    if((length == MOUSE_REPORT_SIZE) && (data[0] == MOUSE_REPORT_ID))
+    {
+        received.x += (int16_t)(data[2] | (data[3] << 8));
+        received.y += (int16_t)(data[4] | (data[5] << 8));
+    }
+}
+
+static void BootsAndSendsTilt ( void )
+{
+    SIM_SYSTEM_CONFIG config;
+
+    SIM_SYSTEM_ConfigDefault(&config);
+    config.source = _Tilted;
+    config.usb.reportHandler = _Report;
+    SIM_SYSTEM_Start(&config);
+
+    SIM_SYSTEM_RunUntil(SIM_US_TO_TICKS(200000));
+
+    TEST_CHECK(SIM_USB_IsConfigured());
+    TEST_CHECK(SIM_BOARD_LEDGet(BSP_LED_3));
+    TEST_CHECK(SIM_ACCEL_StatsGet()->read > 250);
+    TEST_CHECK_EQUAL(0, SIM_ACCEL_StatsGet()->overwritten);
+    TEST_CHECK(received.reports > 100);
+    TEST_CHECK(received.x > 0);
+    TEST_CHECK_EQUAL(0, received.y);
+}
+
+int main ( void )
+{
+    TEST_RUN(BootsAndSendsTilt);
+    return TEST_RESULT();
+}
@@ -0,0 +1,148 @@
+/*******************************************************************************
+  Timer Wheel Tests
+
+  File Name:
+    test_timer_wheel.c
+
+  Summary:
+    Timers expire at their deadline, and the run loop wake-up the wheel asks
+    for is the earliest armed deadline, not the next slot boundary, even
+    for a timer more than one turn of the wheel away.  A callback that stops
+    or re-arms another expired timer of its slot does not keep the rest of
+    the slot from expiring.
+*******************************************************************************/
+
+#include "system_config.h"
+#include "system_definitions.h"
+#include "timer_wheel.h"
+#include "run_loop.h"
+#include "test.h"
+
+#define SLOT_TICKS          ((uint64_t)1 << TIMER_WHEEL_SLOT_SHIFT)
+
+static TIMER_WHEEL_TIMER timers[3];
+static unsigned int expired[3];
+
+static void _Expired ( TIMER_WHEEL_TIMER * timer, uintptr_t context )
+{
+    expired[context] ++;
+}
+
+/* Expires, then stops or re-arms (context 1) the timer filed after it */
+static void _ExpiredTouchingNext ( TIMER_WHEEL_TIMER * timer, uintptr_t context )
+{
+    expired[2] ++;
+    if(context == 0)
+    {
+        TIMER_WHEEL_Stop(&timers[1]);
+    }
+    else
+    {
+        TIMER_WHEEL_Start(&timers[1], 5 * SLOT_TICKS, _Expired, 1);
+    }
+}
+
+static void _Setup ( void )
+{
+    int index;
+
+    for(index = 0; index < 3; index ++)
+    {
+        TIMER_WHEEL_Stop(&timers[index]);
+        expired[index] = 0;
+    }
+    SIM_CORE_Reset();
+    SIM_CORE_VectorsSet(sysVectors);
+
+    SYS_INT_Initialize();
+    SYS_INT_VectorPrioritySet(INT_VECTOR_CT, INT_PRIORITY_LEVEL1);
+    TIMEBASE_Initialize();
+    TIMER_WHEEL_Initialize();
+    RUN_LOOP_Initialize();
+    SYS_INT_Enable();
+}
+
+/* Idles until just before time, then up to it, and returns whether the
+   core timer woke the CPU in the second step only */
+static bool _WakesAt ( uint64_t time )
+{
+    uint32_t before;
+
+    before = SIM_CORE_VectorCountGet(INT_VECTOR_CT);
+    SIM_CORE_RunUntil(time - 1);
+    if(SIM_CORE_VectorCountGet(INT_VECTOR_CT) != before)
+    {
+        return false;
+    }
+    SIM_CORE_RunUntil(time + 1);
+    return (SIM_CORE_VectorCountGet(INT_VECTOR_CT) == before + 1);
+}
+
+static void WakesAtTheEarliestDeadline ( void )
+{
+    uint64_t start;
+
+    _Setup();
+    start = TIMEBASE_TicksGet();
+
+    /* Ten slots away, behind a timer filed in the same ring slot one turn
+       later, and one further out than a whole turn */
+    TIMER_WHEEL_StartAt(&timers[0], start + 10 * SLOT_TICKS + 5, _Expired, 0);
+    TIMER_WHEEL_StartAt(&timers[1], start + (10 + TIMER_WHEEL_SLOTS) * SLOT_TICKS, _Expired, 1);
+    TIMER_WHEEL_StartAt(&timers[2], start + (20 + TIMER_WHEEL_SLOTS) * SLOT_TICKS, _Expired, 2);
+
+    TIMER_WHEEL_Tasks();
+    TEST_CHECK(_WakesAt(timers[0].deadline));
+    TIMER_WHEEL_Tasks();
+    TEST_CHECK_EQUAL(1, expired[0]);
+    TEST_CHECK_EQUAL(0, expired[1]);
+
+    TEST_CHECK(_WakesAt(timers[1].deadline));
+    TIMER_WHEEL_Tasks();
+    TEST_CHECK_EQUAL(1, expired[1]);
+
+    TEST_CHECK(_WakesAt(timers[2].deadline));
+    TIMER_WHEEL_Tasks();
+    TEST_CHECK_EQUAL(1, expired[2]);
+    TEST_CHECK(!TIMER_WHEEL_IsActive(&timers[2]));
+}
+
+static void _ExpireSlotTouchingNext ( uintptr_t context )
+{
+    uint64_t slot;
+
+    _Setup();
+    slot = ((TIMEBASE_TicksGet() >> TIMER_WHEEL_SLOT_SHIFT) + 2) << TIMER_WHEEL_SLOT_SHIFT;
+
+    /* Filed at the head of the slot, timers[2] expires first, then
+       timers[1], then timers[0] */
+    TIMER_WHEEL_StartAt(&timers[0], slot + 1, _Expired, 0);
+    TIMER_WHEEL_StartAt(&timers[1], slot + 2, _Expired, 1);
+    TIMER_WHEEL_StartAt(&timers[2], slot + 3, _ExpiredTouchingNext, context);
+
+    SIM_CORE_RunUntil(slot + 4);
+    TIMER_WHEEL_Tasks();
+    TEST_CHECK_EQUAL(1, expired[2]);
+    TEST_CHECK_EQUAL(0, expired[1]);
+    TEST_CHECK_EQUAL(1, expired[0]);
+    TEST_CHECK(!TIMER_WHEEL_IsActive(&timers[0]));
+    TEST_CHECK_EQUAL(context, TIMER_WHEEL_IsActive(&timers[1]));
+}
+
+static void ExpiresPastAStoppedTimer ( void )
+{
+    _ExpireSlotTouchingNext(0);
+}
+
+static void ExpiresPastARearmedTimer ( void )
+{
+    _ExpireSlotTouchingNext(1);
+}
+
+int main ( void )
+{
+    TEST_RUN(WakesAtTheEarliestDeadline);
+    TEST_RUN(ExpiresPastAStoppedTimer);
+    TEST_RUN(ExpiresPastARearmedTimer);
+    return TEST_RESULT();
+}
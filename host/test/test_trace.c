@@ -0,0 +1,93 @@
+/*******************************************************************************
+  Tracer Tests
+
+  File Name:
+    test_trace.c
+
+  Summary:
+    Records come out oldest first, a report at a time, and records lost to
+    overwriting are counted once.
+*******************************************************************************/
+
+#include "sim_core.h"
+#include "trace.h"
+#include "test.h"
+
+static unsigned int _Drain ( uint8_t * report )
+{
+    TRACE_ReportGet(report);
+    TEST_CHECK_EQUAL(TRACE_REPORT_ID, report[0]);
+    TEST_CHECK_EQUAL(TRACE_REPORT_FORMAT, report[1]);
+    return report[2];
+}
+
+static void RecordsComeOutInOrder ( void )
+{
+    uint8_t report[TRACE_REPORT_SIZE];
+    const uint8_t * record = &report[TRACE_REPORT_HEADER_BYTES];
+
+    TRACE_Record(TRACE_EVENT_REPORT_SEND, 0x11223344, 7, 0x0102);
+    TRACE_Record(TRACE_EVENT_REPORT_SENT, 0x11223355, 7, 0x0102);
+
+    TEST_CHECK_EQUAL(2, _Drain(report));
+    TEST_CHECK_EQUAL(0, report[4] | (report[5] << 8));
+
+    TEST_CHECK_EQUAL(0x44, record[0]);
+    TEST_CHECK_EQUAL(0x11, record[3]);
+    TEST_CHECK_EQUAL(TRACE_EVENT_REPORT_SEND, record[4]);
+    TEST_CHECK_EQUAL(7, record[5]);
+    TEST_CHECK_EQUAL(0x0102, record[6] | (record[7] << 8));
+    TEST_CHECK_EQUAL(TRACE_EVENT_REPORT_SENT, record[TRACE_RECORD_BYTES + 4]);
+
+    /* Unused slots are zero */
+    TEST_CHECK_EQUAL(0, record[2 * TRACE_RECORD_BYTES + 4]);
+
+    TEST_CHECK_EQUAL(0, _Drain(report));
+}
+
+static void ReportsTakeAtMostTheirSlots ( void )
+{
+    uint8_t report[TRACE_REPORT_SIZE];
+    unsigned int index;
+
+    for(index = 0; index < TRACE_REPORT_RECORDS + 5; index ++)
+    {
+        TRACE_Record(TRACE_EVENT_PIPELINE_OUT, index, 0, (uint16_t)index);
+    }
+    TEST_CHECK_EQUAL(TRACE_REPORT_RECORDS, _Drain(report));
+    TEST_CHECK_EQUAL(5, _Drain(report));
+    TEST_CHECK_EQUAL(TRACE_REPORT_RECORDS, report[TRACE_REPORT_HEADER_BYTES + 6]);
+    TEST_CHECK_EQUAL(0, _Drain(report));
+}
+
+static void OverwritingCountsTheLostRecords ( void )
+{
+    uint8_t report[TRACE_REPORT_SIZE];
+    const uint8_t * record = &report[TRACE_REPORT_HEADER_BYTES];
+    unsigned int index;
+
+    for(index = 0; index < TRACE_RECORDS + 3; index ++)
+    {
+        TRACE_Record(TRACE_EVENT_DATA_READY, index, 0, (uint16_t)index);
+    }
+
+    /* The three oldest are gone, and only the first report says so */
+    TEST_CHECK_EQUAL(TRACE_REPORT_RECORDS, _Drain(report));
+    TEST_CHECK_EQUAL(3, report[4] | (report[5] << 8));
+    TEST_CHECK_EQUAL(3, record[6] | (record[7] << 8));
+    TEST_CHECK_EQUAL(TRACE_REPORT_RECORDS, _Drain(report));
+    TEST_CHECK_EQUAL(0, report[4] | (report[5] << 8));
+
+    while(_Drain(report) != 0)
+    {
+    }
+}
+
+int main ( void )
+{
+    SIM_CORE_Reset();
+    TEST_RUN(RecordsComeOutInOrder);
+    TEST_RUN(ReportsTakeAtMostTheirSlots);
+    TEST_RUN(OverwritingCountsTheLostRecords);
+    return TEST_RESULT();
+}
@@ -0,0 +1,245 @@
+/*
+ * File:   accel.c
+ * Author: karenbuitano
+ *
+ * LSM303D accelerometer access through the SPI1 transaction engine.
+ */
+
+#include <xc.h>
+#include <string.h>
+#include "accel.h"
+#include "spsc_ring.h"
+#include "timebase.h"
+
+#define INT_PIN ACC_INT_PIN_GET() // LSM303D INT2, high while the FIFO is at the watermark
+
+#define ACC_SAMPLE_BYTES 6 // OUT_X_L_A..OUT_Z_H_A
+#define ACC_REGISTER_MAX 16 // longest blocking register read
+#define ACC_BURST_BYTES (1 + ACC_FIFO_DEPTH * ACC_SAMPLE_BYTES)
+
+// command byte followed by the dummy bytes clocked out while reading.
+// with the FIFO enabled the auto increment wraps from OUT_Z_H_A back to
+// OUT_X_L_A, so one burst drains any number of samples
+static const uint8_t sampleTx[ACC_BURST_BYTES] =
+        {OUT_X_L_A | ACC_READ_BIT | ACC_AUTOINC_BIT};
+
+// ping-pong sample buffers. DMA fills one half while the other one is
+// copied into the queue. the burst lands at offset 1 so that the samples
+// after the command byte start on a halfword boundary
+static union {
+  ACC_SAMPLE align;
+  uint8_t bytes[1 + ACC_BURST_BYTES];
+} sampleRx[2] APP_MAKE_BUFFER_DMA_READY;
+static SPI_XFER_DESCRIPTOR sampleXfer[2];
+static uint8_t sampleFill = 0;                // half the next burst goes into
+static uint8_t sampleCount[2];                // samples in each half
+static uint32_t sampleTime[2];                // core timer count of the newest one
+static bool sampleDraining = false;           // level poll or burst in flight
+static uint16_t sampleSequence = 0;           // number of the next sample queued
+
+// FIFO_SRC poll that sizes the next burst
+static const uint8_t levelTx[2] = {FIFO_SRC | ACC_READ_BIT};
+static uint8_t levelRx[2] APP_MAKE_BUFFER_DMA_READY;
+static SPI_XFER_DESCRIPTOR levelXfer;
+
+// timestamped samples on their way to the application. filled by the DMA
+// interrupt, emptied by acc_sample_get()
+SPSC_RING_DEFINE(sampleQueue, ACC_STAMPED_SAMPLE, ACC_QUEUE_SIZE);
+
+volatile unsigned int acc_fifo_overruns = 0;
+
+static void acc_descriptor_init(SPI_XFER_DESCRIPTOR * xfer) {
+  xfer->csChannel = ACC_CS_CHANNEL;
+  xfer->csBitPos = ACC_CS_PIN;
+  xfer->mode = SPI_XFER_MODE_INTERRUPT;
+  xfer->callback = NULL;
+  xfer->context = 0;
+  xfer->status = SPI_XFER_STATUS_IDLE;
+}
+
+// run a transaction to completion. only for use outside interrupt context
+static void acc_transfer_wait(SPI_XFER_DESCRIPTOR * xfer) {
+  SPI_XFER_Submit(xfer);
+  while(xfer->status != SPI_XFER_STATUS_COMPLETE) { // wait for the SPI1 interrupt
+    ACC_TRANSFER_WAIT();
+  }
+}
+
+// start a drain unless one is already in flight. interrupt context only
+static void acc_fifo_request(void) {
+  if(sampleDraining) {
+    return;
+  }
+  // the burst is sized and started from the level poll's callback
+  sampleDraining = SPI_XFER_Submit(&levelXfer);
+}
+
+// runs in the DMA interrupt. timestamps the batch and queues it
+static void acc_burst_complete(SPI_XFER_DESCRIPTOR * xfer, uintptr_t context) {
+  unsigned int half = (unsigned int)context;
+  unsigned int count = sampleCount[half];
+  // the LSM303D sends little endian pairs, same as the PIC32
+  const ACC_SAMPLE * samples = (const ACC_SAMPLE *)&sampleRx[half].bytes[2];
+  unsigned int i;
+
+  sampleFill = half ^ 1;
+  sampleDraining = false;
+
+  for(i = 0; i < count; ++i) {
+    ACC_STAMPED_SAMPLE stamped;
+
+    stamped.sample = samples[i];
+    stamped.sequence = sampleSequence++;
+    // oldest first, one ODR period apart
+    stamped.time = sampleTime[half] - (count - 1 - i) * ACC_TICKS_PER_SAMPLE;
+    SPSC_RING_Put(&sampleQueue, &stamped); // counts the sample if it is full
+  }
+
+  TRACE_RECORD_EVENT(TRACE_EVENT_DATA_READY, sampleTime[half], 0,
+                     (uint16_t)(sampleSequence - 1));
+  TRACE_RECORD_EVENT(TRACE_EVENT_SPI_DONE, TIMEBASE_COUNT_GET(), count,
+                     (uint16_t)(sampleSequence - 1));
+
+  // INT2 is level style: if the FIFO refilled to the watermark while we were
+  // draining it, there is no new edge to wait for
+  if(INT_PIN) {
+    acc_fifo_request();
+  }
+}
+
+// runs in the SPI1 interrupt. sizes the burst from the FIFO level
+static void acc_level_complete(SPI_XFER_DESCRIPTOR * xfer, uintptr_t context) {
+  uint8_t src = levelRx[1];
+  unsigned int level = src & FIFO_SRC_FSS;
+  SPI_XFER_DESCRIPTOR * burst = &sampleXfer[sampleFill];
+
+  if(src & FIFO_SRC_OVRN) {
+    // FIFO is full and the oldest sample has been overwritten. all 32
+    // entries are stored, which the 5 bit FSS reads as 0
+    acc_fifo_overruns++;
+    if(level == 0) {
+      level = ACC_FIFO_DEPTH;
+    }
+  }
+  if(level == 0) {
+    sampleDraining = false;
+    return;
+  }
+
+  // the newest stored sample is less than one ODR period old here
+  sampleTime[sampleFill] = TIMEBASE_COUNT_GET();
+  sampleCount[sampleFill] = level;
+  burst->length = 1 + level * ACC_SAMPLE_BYTES;
+  if(!SPI_XFER_Submit(burst)) {
+    sampleDraining = false;
+  }
+}
+
+void acc_read_register(unsigned char reg, unsigned char data[], unsigned int len) {
+  SPI_XFER_DESCRIPTOR xfer;
+  uint8_t tx[1 + ACC_REGISTER_MAX] = {0};
+  uint8_t rx[1 + ACC_REGISTER_MAX];
+
+  if(len > ACC_REGISTER_MAX) {
+    len = ACC_REGISTER_MAX;
+  }
+
+  reg |= ACC_READ_BIT; // set the read bit (as per the accelerometer's protocol)
+  if(len > 1) {
+    reg |= ACC_AUTOINC_BIT; // set the address auto increment bit (as per the accelerometer's protocol)
+  }
+
+  acc_descriptor_init(&xfer);
+  tx[0] = reg;
+  xfer.txBuffer = tx;
+  xfer.rxBuffer = rx;
+  xfer.length = 1 + len;
+  acc_transfer_wait(&xfer);
+
+  memcpy(data, &rx[1], len); // first byte was clocked in during the address phase
+}
+
+
+void acc_write_register(unsigned char reg, unsigned char data) {
+  SPI_XFER_DESCRIPTOR xfer;
+  uint8_t cmd[2];
+
+  cmd[0] = reg;
+  cmd[1] = data;
+  acc_descriptor_init(&xfer);
+  xfer.txBuffer = cmd;
+  xfer.rxBuffer = NULL;
+  xfer.length = 2;
+  acc_transfer_wait(&xfer);  // CS is framed by the engine
+}
+
+
+void acc_setup(void) {
+  int i;
+
+  // SYS_Initialize has routed the pins, chip select deselected, and
+  // configured SPI1 with SPI_XFER_Initialize()
+
+  for(i = 0; i < 2; ++i) {
+    acc_descriptor_init(&sampleXfer[i]);
+    sampleXfer[i].txBuffer = sampleTx;
+    sampleXfer[i].rxBuffer = &sampleRx[i].bytes[1];
+    sampleXfer[i].length = ACC_BURST_BYTES;
+    sampleXfer[i].mode = SPI_XFER_MODE_DMA;
+    sampleXfer[i].callback = acc_burst_complete;
+    sampleXfer[i].context = i;
+  }
+
+  acc_descriptor_init(&levelXfer);
+  levelXfer.txBuffer = levelTx;
+  levelXfer.rxBuffer = levelRx;
+  levelXfer.length = sizeof(levelRx);
+  levelXfer.callback = acc_level_complete;
+
+  // set the accelerometer data rate to 1600 Hz. Do not update until we read values
+  acc_write_register(CTRL1, 0xAF);
+
+  // 50 Hz magnetometer, high resolution, temperature sensor on
+  acc_write_register(CTRL5, 0xF0);
+
+  // enable continuous reading of the magnetometer
+  acc_write_register(CTRL7, 0x0);
+
+  //make the accelerometer sensitivity be +/- 2g
+ //acc_write_register(CTRL2, 0x0);
+
+  // stream mode: the FIFO keeps the newest 32 samples between reads. the
+  // watermark only raises INT2; FTH_EN stays clear so that it does not
+  // also cut the FIFO down to the watermark depth
+  acc_write_register(FIFO_CTRL, FIFO_CTRL_MODE_STREAM | ACC_FIFO_WATERMARK);
+  acc_write_register(CTRL0, CTRL0_FIFO_EN);
+
+  // signal the watermark on INT2. nothing on INT1
+  acc_write_register(CTRL3, 0x0);
+  acc_write_register(CTRL4, CTRL4_INT2_FTH);
+
+  SYS_INT_SourceStatusClear(ACC_INT_SOURCE);
+  SYS_INT_SourceEnable(ACC_INT_SOURCE);
+
+  // the FIFO may already have reached the watermark, and then there will be
+  // no edge. let the interrupt handler start the first drain
+  if(INT_PIN) {
+    SYS_INT_SourceStatusSet(ACC_INT_SOURCE);
+  }
+}
+
+
+void acc_int_isr(void) {
+  SYS_INT_SourceStatusClear(ACC_INT_SOURCE);
+  acc_fifo_request();
+}
+
+
+bool acc_sample_get(ACC_STAMPED_SAMPLE * out) {
+  return SPSC_RING_Get(&sampleQueue, out);
+}
+
+
+unsigned int acc_sample_overflows(void) {
+  return SPSC_RING_OverflowsGet(&sampleQueue);
+}
@@ -1,5 +1,5 @@
-/* 
- * File:   accel2.h
+/*
+ * File:   accel.h
  * Author: karenbuitano
  *
  * Created on June 10, 2015, 3:12 PM
@@ -8,12 +8,118 @@
 #ifndef ACCEL2_H
 #define	ACCEL2_H
 
+#include <stdint.h>
+#include <stdbool.h>
+#include "spi_xfer.h"
+#include "trace.h"
+
 #ifdef	__cplusplus
 extern "C" {
 #endif
 
+// Basic interface with an LSM303D accelerometer/compass over SPI1.
+
+                        // register addresses
+#define CTRL0 0x1F      // control register 0
+#define CTRL1 0x20      // control register 1
+#define CTRL3 0x22      // INT1 routing
+#define CTRL4 0x23      // INT2 routing
+#define CTRL5 0x24      // control register 5
+#define CTRL7 0x26      // control register 7
+
+#define OUT_X_L_A 0x28  // LSB of x axis acceleration register.
+                        // all acceleration registers are contiguous, and this is the lowest address
+#define OUT_X_L_M 0x08  // LSB of x axis of magnetometer register
+
+#define TEMP_OUT_L 0x05 // temperature sensor register
+
+#define FIFO_CTRL 0x2E  // FIFO mode and watermark threshold
+#define FIFO_SRC 0x2F   // FIFO status and stored data level
+
+#define CTRL0_FIFO_EN 0x40          // FIFO enable
+#define FIFO_CTRL_MODE_STREAM 0x40  // FM = 010, newest samples overwrite the oldest
+#define FIFO_SRC_FTH 0x80           // level is at or above the watermark
+#define FIFO_SRC_OVRN 0x40          // FIFO full, a sample was overwritten
+#define FIFO_SRC_EMPTY 0x20         // FIFO empty
+#define FIFO_SRC_FSS 0x1F           // stored data level
+#define CTRL4_INT2_FTH 0x01         // FIFO watermark on the INT2 pin
+
+#define ACC_FIFO_DEPTH 32           // samples the LSM303D FIFO can hold
+#define ACC_FIFO_WATERMARK 2        // FTH, flagged in FIFO_SRC and on INT2.
+                                    // low so a sample is never more than a
+                                    // couple of ODR periods old when drained.
+                                    // the FIFO itself stays 32 deep, 20 ms
+                                    // at 1600 Hz, for a drain held up
+#define ACC_ODR_HZ 1600             // accelerometer output data rate
+
+// core timer ticks (SYSCLK / 2) between two accelerometer samples
+#define ACC_TICKS_PER_SAMPLE (SYS_CLK_FREQ / 2 / ACC_ODR_HZ)
+
+#define ACC_QUEUE_SIZE 64           // timestamped samples, a power of two
+
+#define ACC_READ_BIT    0x80    // read access
+#define ACC_AUTOINC_BIT 0x40    // address auto increment for multi byte access
+
+#define ACC_CS_CHANNEL  PORT_CHANNEL_B  // chip select on B4
+#define ACC_CS_PIN      PORTS_BIT_POS_4
+
+// the LSM303D INT2 pin drives external interrupt 2 through RPB13
+#define ACC_INT_SOURCE  INT_SOURCE_EXTERNAL_2
+
+// true on a board with the LSM303D wired as above. SYS_Initialize routes its
+// pins before SPI_XFER_Initialize(). without it acc_setup() is never called
+// and no sample is ever queued, so the mouse only reports its buttons
+#ifndef ACC_ENABLE
+#define ACC_ENABLE false
+#endif
+
+// level of the INT2 pin. a build without the real port may define its own
+#ifndef ACC_INT_PIN_GET
+#define ACC_INT_PIN_GET() PORTBbits.RB13
+#endif
+
+// one pass of the loop that waits for a blocking transfer. a build without
+// the real core may define its own to let time pass
+#ifndef ACC_TRANSFER_WAIT
+#define ACC_TRANSFER_WAIT()
+#endif
+
+// read len bytes starting at reg, blocks until the transfer is done
+void acc_read_register(unsigned char reg, unsigned char data[], unsigned int len);
+
+// write to the register, blocks until the transfer is done
+void acc_write_register(unsigned char reg, unsigned char data);
+
+// initialize the accelerometer
+void acc_setup(void);
+
+// one acceleration sample, as read from OUT_X_L_A..OUT_Z_H_A
+typedef struct {
+  short x;
+  short y;
+  short z;
+} ACC_SAMPLE;
+
+// a sample, its number and the core timer count at which the sensor produced it
+typedef struct {
+  ACC_SAMPLE sample;
+  uint16_t sequence;  // counts every sample read, wraps. used by the tracer
+  uint32_t time;
+} ACC_STAMPED_SAMPLE;
+
+// FIFO overflows seen in FIFO_SRC since reset
+extern volatile unsigned int acc_fifo_overruns;
+
+// FIFO watermark interrupt. polls FIFO_SRC and drains every stored sample in
+// one DMA burst, then timestamps the samples and queues them. call from the
+// external interrupt 2 vector, at the SPI1/DMA1 priority level
+void acc_int_isr(void);
 
+// take the oldest queued sample. returns false if the queue is empty
+bool acc_sample_get(ACC_STAMPED_SAMPLE * out);
 
+// samples dropped because the application did not empty the queue in time
+unsigned int acc_sample_overflows(void);
 
 #ifdef	__cplusplus
 }
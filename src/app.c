@@ -54,7 +54,6 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 // *****************************************************************************
 
 #include "app.h"
-//#include "accel.h"
 #include <xc.h>
 //#include "i12c_display.h"
 // *****************************************************************************
@@ -82,98 +81,58 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 
 APP_DATA appData;
 //#define OUT_X_L_A 0x28 
-/* Mouse Report */
-MOUSE_REPORT mouseReport APP_MAKE_BUFFER_DMA_READY;
-MOUSE_REPORT mouseReportPrevious APP_MAKE_BUFFER_DMA_READY;
+/* Mouse report buffers, handed out by appData.reportPool */
+APP_MOUSE_REPORT_BUFFER mouseReports[REPORT_POOL_BUFFERS] APP_MAKE_BUFFER_DMA_READY;
 
+#if PROFILER_ENABLE
+/* Stays untouched until the control transfer that sends it is over */
+uint8_t profilerReport[PROFILER_REPORT_SIZE] APP_MAKE_BUFFER_DMA_READY;
+#endif
 
-// *****************************************************************************
-// *****************************************************************************
-// Section: Application Callback Functions
-// *****************************************************************************
-// *****************************************************************************
-#define CS LATBbits.LATB4 // replace x with some digital pin
-
-// send a byte via spi and return the response
-unsigned char spi_io(unsigned char o) {
-  SPI1BUF = o;
-  while(!SPI1STATbits.SPIRBF) { // wait to receive the byte
-    ;
-  }
-  return SPI1BUF;
-}
-void acc_read_register(unsigned char reg, unsigned char data[], unsigned int len) {
-  unsigned int i;
-  reg |= 0x80; // set the read bit (as per the accelerometer's protocol)
-  if(len > 1) {
-    reg |= 0x40; // set the address auto increment bit (as per the accelerometer's protocol)
-  }
-  CS = 0;
-  spi_io(reg);
-  for(i = 0; i != len; ++i) {
-    data[i] = spi_io(0); // read data from spi
-  }
-  CS = 1;
-}
-
-
-void acc_write_register(unsigned char reg, unsigned char data) {
-  CS = 0;               // bring CS low to activate SPI
-  spi_io(reg);
-  spi_io(data);
-  CS = 1;               // complete the command
-}
+#if TRACE_ENABLE
+/* Same for the trace records */
+uint8_t traceReport[TRACE_REPORT_SIZE] APP_MAKE_BUFFER_DMA_READY;
+#endif
 
+#if APP_STATS_ENABLE
+/* And for the statistics */
+uint8_t statsReport[APP_STATS_REPORT_SIZE] APP_MAKE_BUFFER_DMA_READY;
 
-void acc_setup() {
-  TRISBbits.TRISB4 = 0; // set B4 to output and digital if necessary
-  CS = 1;// not sure about this line 
+static void APP_StatsReportGet(uint8_t * report);
+#endif
 
-  // select a pin for SDI1
-  SDI1Rbits.SDI1R = 0b0001;// set SDI1 to RPB5 (pg 146 of data sheet)
+#if CAPTURE_ENABLE
+/* And for the captured samples */
+uint8_t captureReport[CAPTURE_REPORT_SIZE] APP_MAKE_BUFFER_DMA_READY;
+#endif
 
-  // select a pin for SD01
-  RPB2Rbits.RPB2R = 0b0011;
+/* USB events queued by the USB interrupt for APP_Tasks */
+SPSC_RING_DEFINE(appEvents, APP_EVENT, APP_EVENT_QUEUE_DEPTH);
 
-  // Setup the master Master - SPI1
-  // we manually control SS as a digital output 
-  // since the pic is just starting, we know that spi is off. We rely on defaults here
- 
-  // setup spi1
-  SPI1CON = 0;              // turn off the spi module and reset it
-  SPI1BUF;                  // clear the rx buffer by reading from it
-  SPI1BRG = 0x3;            // baud rate to 5MHz [SPI1BRG = (40000000/(2*desired))-1]
-  SPI1STATbits.SPIROV = 0;  // clear the overflow bit
-  SPI1CONbits.CKE = 1;      // data changes when clock goes from active to inactive
-                            //    (high to low since CKP is 0)
-  SPI1CONbits.MSTEN = 1;    // master operation
-  SPI1CONbits.ON = 1;       // turn on spi
- 
-  // set the accelerometer data rate to 1600 Hz. Do not update until we read values
-  acc_write_register(CTRL1, 0xAF); 
-
-  // 50 Hz magnetometer, high resolution, temperature sensor on
-  acc_write_register(CTRL5, 0xF0); 
 
-  // enable continuous reading of the magnetometer
-  acc_write_register(CTRL7, 0x0); 
-  
-  //make the accelerometer sensitivity be +/- 2g
- //acc_write_register(CTRL2, 0x0); 
-}
+// *****************************************************************************
+// *****************************************************************************
+// Section: Application Callback Functions
+// *****************************************************************************
+// *****************************************************************************
 void APP_USBDeviceHIDEventHandler(USB_DEVICE_HID_INDEX hidInstance,
         USB_DEVICE_HID_EVENT event, void * eventData, uintptr_t userData)
 {
     APP_DATA * appData = (APP_DATA *)userData;
+    APP_EVENT appEvent;
 
     switch(event)
     {
         case USB_DEVICE_HID_EVENT_REPORT_SENT:
 
-            /* This means the mouse report was sent.
-             We are free to send another report */
+            /* This means a mouse report was sent. APP_Tasks gets its
+             buffer back and is free to send another report once it has
+             seen this event. */
 
-            appData->isMouseReportSendBusy = false;
+            appEvent.type = APP_EVENT_REPORT_SENT;
+            appEvent.data = ((USB_DEVICE_HID_EVENT_DATA_REPORT_SENT *)eventData)->handle;
+            appEvent.time = TIMEBASE_COUNT_GET();
+            SPSC_RING_Put(&appEvents, &appEvent);
             break;
 
         case USB_DEVICE_HID_EVENT_REPORT_RECEIVED:
@@ -183,17 +142,38 @@ void APP_USBDeviceHIDEventHandler(USB_DEVICE_HID_INDEX hidInstance,
 
         case USB_DEVICE_HID_EVENT_SET_IDLE:
 
-             /* Acknowledge the Control Write Transfer */
-           USB_DEVICE_ControlStatus(appData->deviceHandle, USB_DEVICE_CONTROL_STATUS_OK);
+            /* save Idle rate received from Host. The report's deadline is
+               moved in APP_Tasks, where the timers run. */
+            if(HID_IDLE_DurationSet(&appData->idle,
+                    ((USB_DEVICE_HID_EVENT_DATA_SET_IDLE*)eventData)->reportID,
+                    ((USB_DEVICE_HID_EVENT_DATA_SET_IDLE*)eventData)->duration))
+            {
+                appEvent.type = APP_EVENT_SET_IDLE;
+                appEvent.data = ((USB_DEVICE_HID_EVENT_DATA_SET_IDLE*)eventData)->reportID;
+                appEvent.time = TIMEBASE_COUNT_GET();
+                SPSC_RING_Put(&appEvents, &appEvent);
 
-            /* save Idle rate received from Host */
-            appData->idleRate = ((USB_DEVICE_HID_EVENT_DATA_SET_IDLE*)eventData)->duration;
+                /* Acknowledge the Control Write Transfer */
+                USB_DEVICE_ControlStatus(appData->deviceHandle, USB_DEVICE_CONTROL_STATUS_OK);
+            }
+            else
+            {
+                /* Not one of our input reports */
+                USB_DEVICE_ControlStatus(appData->deviceHandle, USB_DEVICE_CONTROL_STATUS_ERROR);
+            }
             break;
 
         case USB_DEVICE_HID_EVENT_GET_IDLE:
 
             /* Host is requesting for Idle rate. Now send the Idle rate */
-            USB_DEVICE_ControlSend(appData->deviceHandle, &(appData->idleRate),1);
+            if(!HID_IDLE_DurationGet(&appData->idle,
+                    ((USB_DEVICE_HID_EVENT_DATA_GET_IDLE*)eventData)->reportID,
+                    &appData->idleDuration))
+            {
+                USB_DEVICE_ControlStatus(appData->deviceHandle, USB_DEVICE_CONTROL_STATUS_ERROR);
+                break;
+            }
+            USB_DEVICE_ControlSend(appData->deviceHandle, &(appData->idleDuration),1);
 
             /* On successfully receiving Idle rate, the Host would acknowledge back with a
                Zero Length packet. The HID function driver returns an event
@@ -206,8 +186,19 @@ void APP_USBDeviceHIDEventHandler(USB_DEVICE_HID_INDEX hidInstance,
 
         case USB_DEVICE_HID_EVENT_SET_PROTOCOL:
             /* Host is trying set protocol. Now receive the protocol and save */
+            if(*(USB_HID_PROTOCOL_CODE *)eventData > APP_HID_PROTOCOL_REPORT)
+            {
+                USB_DEVICE_ControlStatus(appData->deviceHandle, USB_DEVICE_CONTROL_STATUS_ERROR);
+                break;
+            }
             appData->activeProtocol = *(USB_HID_PROTOCOL_CODE *)eventData;
 
+            /* APP_Tasks builds the next report in the new format */
+            appEvent.type = APP_EVENT_SET_PROTOCOL;
+            appEvent.data = appData->activeProtocol;
+            appEvent.time = TIMEBASE_COUNT_GET();
+            SPSC_RING_Put(&appEvents, &appEvent);
+
               /* Acknowledge the Control Write Transfer */
             USB_DEVICE_ControlStatus(appData->deviceHandle, USB_DEVICE_CONTROL_STATUS_OK);
             break;
@@ -225,6 +216,56 @@ void APP_USBDeviceHIDEventHandler(USB_DEVICE_HID_INDEX hidInstance,
                this control transfer event is complete */
              break;
 
+        case USB_DEVICE_HID_EVENT_GET_REPORT:
+
+#if PROFILER_ENABLE
+            if((((USB_DEVICE_HID_EVENT_DATA_GET_REPORT *)eventData)->reportType == USB_HID_REPORT_TYPE_FEATURE) &&
+               (((USB_DEVICE_HID_EVENT_DATA_GET_REPORT *)eventData)->reportID == PROFILER_REPORT_ID))
+            {
+                /* Host is reading the superloop profile */
+                PROFILER_ReportGet(profilerReport);
+                USB_DEVICE_ControlSend(appData->deviceHandle, profilerReport,
+                        PROFILER_REPORT_SIZE);
+                break;
+            }
+#endif
+#if TRACE_ENABLE
+            if((((USB_DEVICE_HID_EVENT_DATA_GET_REPORT *)eventData)->reportType == USB_HID_REPORT_TYPE_FEATURE) &&
+               (((USB_DEVICE_HID_EVENT_DATA_GET_REPORT *)eventData)->reportID == TRACE_REPORT_ID))
+            {
+                /* Host is draining the latency trace */
+                TRACE_ReportGet(traceReport);
+                USB_DEVICE_ControlSend(appData->deviceHandle, traceReport,
+                        TRACE_REPORT_SIZE);
+                break;
+            }
+#endif
+#if APP_STATS_ENABLE
+            if((((USB_DEVICE_HID_EVENT_DATA_GET_REPORT *)eventData)->reportType == USB_HID_REPORT_TYPE_FEATURE) &&
+               (((USB_DEVICE_HID_EVENT_DATA_GET_REPORT *)eventData)->reportID == APP_STATS_REPORT_ID))
+            {
+                /* Host is comparing configurations */
+                APP_StatsReportGet(statsReport);
+                USB_DEVICE_ControlSend(appData->deviceHandle, statsReport,
+                        APP_STATS_REPORT_SIZE);
+                break;
+            }
+#endif
+#if CAPTURE_ENABLE
+            if((((USB_DEVICE_HID_EVENT_DATA_GET_REPORT *)eventData)->reportType == USB_HID_REPORT_TYPE_FEATURE) &&
+               (((USB_DEVICE_HID_EVENT_DATA_GET_REPORT *)eventData)->reportID == CAPTURE_REPORT_ID))
+            {
+                /* Host is recording the raw sensor samples */
+                CAPTURE_ReportGet(captureReport);
+                USB_DEVICE_ControlSend(appData->deviceHandle, captureReport,
+                        CAPTURE_REPORT_SIZE);
+                break;
+            }
+#endif
+            /* No other report can be read over the control endpoint */
+            USB_DEVICE_ControlStatus(appData->deviceHandle, USB_DEVICE_CONTROL_STATUS_ERROR);
+            break;
+
         case USB_DEVICE_HID_EVENT_CONTROL_TRANSFER_DATA_SENT:
             break;
 
@@ -254,13 +295,16 @@ void APP_USBDeviceHIDEventHandler(USB_DEVICE_HID_INDEX hidInstance,
 void APP_USBDeviceEventHandler(USB_DEVICE_EVENT event, void * eventData, uintptr_t context)
 {
     USB_DEVICE_EVENT_DATA_CONFIGURED * configurationValue;
+    APP_EVENT appEvent;
     switch(event)
     {
         case USB_DEVICE_EVENT_SOF:
-            /* This event is used for switch debounce. This flag is reset
-             * by the switch process routine. */
-            appData.sofEventHasOccurred = true;
-            appData.setIdleTimer++;
+            /* This event is used for switch debounce. Every frame is
+             * queued, so none is lost while APP_Tasks is busy. */
+            appEvent.type = APP_EVENT_SOF;
+            appEvent.data = ((USB_DEVICE_EVENT_DATA_SOF *)eventData)->frameNumber;
+            appEvent.time = TIMEBASE_COUNT_GET();
+            SPSC_RING_Put(&appEvents, &appEvent);
             break;
         case USB_DEVICE_EVENT_RESET:
         case USB_DEVICE_EVENT_DECONFIGURED:
@@ -268,9 +312,10 @@ void APP_USBDeviceEventHandler(USB_DEVICE_EVENT event, void * eventData, uintptr
             /* Device got deconfigured */
             
             appData.isConfigured = false;
-            appData.isMouseReportSendBusy = false;
             appData.state = APP_STATE_WAIT_FOR_CONFIGURATION;
             appData.emulateMouse = true;
+            appData.activeProtocol = APP_HID_PROTOCOL_REPORT;
+            HID_IDLE_Reset(&appData.idle);
             BSP_LEDOn ( APP_USB_LED_1 );
             BSP_LEDOn ( APP_USB_LED_2 );
             BSP_LEDOff ( APP_USB_LED_3 );
@@ -329,48 +374,236 @@ void APP_USBDeviceEventHandler(USB_DEVICE_EVENT event, void * eventData, uintptr
 // *****************************************************************************
 // *****************************************************************************
 
+/********************************************************
+ * Application statistics routines
+ ********************************************************/
+
+static void APP_StatsFrameEnd(void)
+{
+    /* Called at each SOF, for the frame that just ended */
+    appData.stats.frames ++;
+    if(!appData.isFrameReportSent)
+    {
+        if(MOTION_IsPending(&appData.motion))
+        {
+            appData.stats.framesMissed ++;
+        }
+        else
+        {
+            /* Nothing to send. The gap to the next report is not one. */
+            appData.isReportStreaming = false;
+        }
+    }
+
+    if(appData.stats.frames >= appData.statsWindowFrames)
+    {
+        appData.statsLast = appData.stats;
+        appData.stats.frames = 0;
+        appData.stats.reportsSent = 0;
+        appData.stats.framesMissed = 0;
+        appData.stats.sentGapMax = 0;
+    }
+}
+
+#if APP_STATS_ENABLE
+static void APP_StatsPack32(uint8_t * buffer, uint32_t value)
+{
+    buffer[0] = (uint8_t)value;
+    buffer[1] = (uint8_t)(value >> 8);
+    buffer[2] = (uint8_t)(value >> 16);
+    buffer[3] = (uint8_t)(value >> 24);
+}
+
+static void APP_StatsReportGet(uint8_t * report)
+{
+    /* Runs in the USB interrupt. The counters are single words, so each
+     * one is consistent even if the set as a whole may straddle an update. */
+    const RUN_LOOP_STATS * runLoop = RUN_LOOP_StatsGet();
+    uint32_t values[APP_STATS_REPORT_VALUES];
+    int index;
+
+    values[0] = appData.statsLast.frames;
+    values[1] = appData.statsLast.reportsSent;
+    values[2] = appData.statsLast.framesMissed;
+    values[3] = appData.statsLast.sentGapMax;
+    values[4] = appData.motion.saturated;
+    values[5] = acc_sample_overflows();
+    values[6] = acc_fifo_overruns;
+    values[7] = appData.sampleAgeMax;
+    values[8] = runLoop->passes;
+    values[9] = runLoop->wakeups;
+    values[10] = runLoop->busyTicks;
+    values[11] = runLoop->windowTicks;
+
+    report[0] = APP_STATS_REPORT_ID;
+    report[1] = APP_STATS_REPORT_FORMAT;
+    report[2] = APP_REPORT_QUEUE_DEPTH;
+    report[3] = 0;
+    for(index = 0; index < APP_STATS_REPORT_VALUES; index ++)
+    {
+        APP_StatsPack32(&report[4 + 4 * index], values[index]);
+    }
+}
+#endif
+
+/********************************************************
+ * Application USB event routine
+ ********************************************************/
+
+static void APP_ProcessEvents(void)
+{
+    /* Work through everything the USB interrupt has queued since the
+     * last call, oldest first. */
+    APP_EVENT appEvent;
+    int reportIndex;
+
+    while(SPSC_RING_Get(&appEvents, &appEvent))
+    {
+        switch(appEvent.type)
+        {
+            case APP_EVENT_SOF:
+                APP_StatsFrameEnd();
+                appData.sofTime = appEvent.time;
+                appData.isFrameReportDone = false;
+                appData.isFrameReportSent = false;
+                break;
+
+            case APP_EVENT_REPORT_SENT:
+                /* A transfer cancelled by a reset may complete after the
+                 * pool has been emptied. It does not free the endpoint. */
+                reportIndex = REPORT_POOL_Release(&appData.reportPool,
+                        (USB_DEVICE_HID_TRANSFER_HANDLE)appEvent.data);
+                if(reportIndex != REPORT_POOL_NONE)
+                {
+                    /* Traced for the report that was in the buffer, which
+                     * need not be the last one built */
+                    TRACE_RECORD_EVENT(TRACE_EVENT_REPORT_SENT, appEvent.time,
+                            appData.reportBufferSequence[reportIndex],
+                            appData.reportBufferSampleSequence[reportIndex]);
+                    appData.stats.reportsSent ++;
+                    if(appData.isReportStreaming &&
+                       ((appEvent.time - appData.reportSentTime) > appData.stats.sentGapMax))
+                    {
+                        appData.stats.sentGapMax = appEvent.time - appData.reportSentTime;
+                    }
+                    appData.reportSentTime = appEvent.time;
+                    appData.isReportStreaming = true;
+                }
+                break;
+
+            case APP_EVENT_SET_IDLE:
+                HID_IDLE_Update(&appData.idle, (uint8_t)appEvent.data);
+                break;
+
+            case APP_EVENT_SET_PROTOCOL:
+                /* The host has not seen the button state in this format */
+                appData.isButtonChanged = true;
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+/********************************************************
+ * Application report schedule routine
+ ********************************************************/
+
+static bool APP_ReportSlotReached(void)
+{
+    uint32_t elapsed;
+
+    /* One report per frame, built as late as possible so that it carries
+     * the freshest sample when the host's IN token arrives. If the loop
+     * got here after the slot, the report still goes out in this frame. */
+    if(appData.isFrameReportDone)
+    {
+        return false;
+    }
+
+    elapsed = TIMEBASE_COUNT_GET() - appData.sofTime;
+    if(elapsed >= appData.reportSubmitTicks)
+    {
+        return true;
+    }
+
+    /* Nothing interrupts at the slot itself. Have the loop woken there. */
+    RUN_LOOP_WakeAt(TIMEBASE_TicksGet() + (appData.reportSubmitTicks - elapsed));
+    return false;
+}
+
+static void APP_FrameTimingSet(USB_SPEED speed)
+{
+    /* A high speed host starts a microframe, with its own SOF, every
+     * 125 us. The report slot and the statistics window follow it. */
+    uint32_t frameUs = (speed == USB_SPEED_HIGH) ?
+            APP_USB_MICROFRAME_US : APP_USB_FRAME_US;
+
+    appData.reportSubmitTicks = (frameUs -
+            APP_REPORT_LEAD_US * frameUs / APP_USB_FRAME_US) * APP_CORE_TICKS_PER_US;
+    appData.statsWindowFrames = APP_STATS_WINDOW_US / frameUs;
+}
+
+static void APP_MouseButtonSet(unsigned int button, MOUSE_BUTTON_STATE state)
+{
+    /* Remember the edge, so that the next report goes out with it */
+    if(appData.mouseButton[button] != state)
+    {
+        appData.mouseButton[button] = state;
+        appData.isButtonChanged = true;
+    }
+}
+
+static bool APP_ReportIsDue(void)
+{
+    /* Relative movement always has to be sent, and so does a button that
+     * has changed since the last report. */
+    if(MOTION_IsPending(&appData.motion) || appData.isButtonChanged)
+    {
+        return true;
+    }
+
+    /* Otherwise the report would repeat the last one, which is only sent
+     * again when its idle period has elapsed */
+    return HID_IDLE_IsDue(&appData.idle, appData.mouseIdle);
+}
+
 /********************************************************
  * Application switch press routine
  ********************************************************/
 
+static void APP_SwitchDebounceExpired(TIMER_WHEEL_TIMER * timer, uintptr_t context)
+{
+    /* The switch has been held for the whole debounce time. Indicate that
+     * we have valid switch press. The switch is pressed flag will be
+     * cleared by the application tasks routine. We should be ready for the
+     * next key press.*/
+    appData.isSwitchPressed = true;
+    appData.ignoreSwitchPress = false;
+}
+
 void APP_ProcessSwitchPress(void)
 {
     /* This function checks if the switch is pressed and then
      * debounces the switch press*/
     if(BSP_SWITCH_STATE_PRESSED == (BSP_SwitchStateGet(APP_USB_SWITCH_1)))
     {
-        if(appData.ignoreSwitchPress)
-        {
-            /* This means the key press is in progress */
-            if(appData.sofEventHasOccurred)
-            {
-                /* A timer event has occurred. Update the debounce timer */
-                appData.switchDebounceTimer ++;
-                appData.sofEventHasOccurred = false;
-                if(appData.switchDebounceTimer == APP_USB_SWITCH_DEBOUNCE_COUNT)
-                {
-                    /* Indicate that we have valid switch press. The switch is
-                     * pressed flag will be cleared by the application tasks
-                     * routine. We should be ready for the next key press.*/
-                    appData.isSwitchPressed = true;
-                    appData.switchDebounceTimer = 0;
-                    appData.ignoreSwitchPress = false;
-                }
-            }
-        }
-        else
+        if(!appData.ignoreSwitchPress)
         {
-            /* We have a fresh key press */
+            /* We have a fresh key press. The debounce timer expires
+             * unless the switch is released first. */
             appData.ignoreSwitchPress = true;
-            appData.switchDebounceTimer = 0;
+            TIMER_WHEEL_Start(&appData.switchDebounceTimer,
+                    TIMEBASE_MS_TO_TICKS(APP_USB_SWITCH_DEBOUNCE_COUNT),
+                    APP_SwitchDebounceExpired, 0);
         }
     }
     else
     {
         /* No key press. Reset all the indicators. */
         appData.ignoreSwitchPress = false;
-        appData.switchDebounceTimer = 0;
-        appData.sofEventHasOccurred = false;
+        TIMER_WHEEL_Stop(&appData.switchDebounceTimer);
     }
 }
 
@@ -398,9 +631,38 @@ void APP_Initialize ( void )
     appData.isConfigured = false;
     appData.emulateMouse = true;
     appData.hidInstance = 0;
-    appData.isMouseReportSendBusy = false;
+    appData.activeProtocol = APP_HID_PROTOCOL_REPORT;
+    appData.isButtonChanged = false;
+    REPORT_POOL_Initialize(&appData.reportPool);
+    HID_IDLE_Initialize(&appData.idle);
+    appData.mouseIdle = HID_IDLE_Register(&appData.idle, MOUSE_REPORT_ID);
     appData.isSwitchPressed = false;
     appData.ignoreSwitchPress = false;
+    appData.sofTime = 0;
+    appData.isFrameReportDone = true;
+    APP_FrameTimingSet(USB_SPEED_FULL);
+    MOTION_Initialize(&appData.motion);
+    DECIMATOR_Initialize(&appData.decimator);
+    TILT_Initialize(&appData.tilt, APP_PIPELINE_SAMPLES_NUM,
+            APP_PIPELINE_SAMPLES_DEN);
+    appData.accelValid = false;
+    appData.accelSequence = 0;
+    appData.reportSequence = 0;
+    appData.isFrameReportSent = false;
+    appData.stats.frames = 0;
+    appData.stats.reportsSent = 0;
+    appData.stats.framesMissed = 0;
+    appData.stats.sentGapMax = 0;
+    appData.statsLast = appData.stats;
+    appData.reportSentTime = 0;
+    appData.isReportStreaming = false;
+    appData.sampleAge = 0;
+    appData.sampleAgeMax = 0;
+
+#if ACC_ENABLE
+    /* Configure the LSM303D. SPI1 is already running under interrupts. */
+    acc_setup();
+#endif
 }
 
 
@@ -414,12 +676,17 @@ void APP_Initialize ( void )
 
 void APP_Tasks ( void )
 {
-    static int8_t   vector = 0;
-    static uint8_t  movement_length = 0;
-    static bool     sent_dont_move = false;
-
-    int8_t dir_table[] ={-4,-4,-4, 0, 4, 4, 4, 0};
+    ACC_STAMPED_SAMPLE sample;
+    ACC_SAMPLE filtered;
+    bool isFiltered;
+    TILT_VELOCITY velocity;
+    int reportIndex;
+    size_t reportSize;
+    USB_DEVICE_HID_TRANSFER_HANDLE reportHandle;
 	
+    /* Catch up with the USB interrupt before looking at the state. */
+    APP_ProcessEvents();
+
     /* Check the application's current state. */
     switch ( appData.state )
     {
@@ -454,6 +721,17 @@ void APP_Tasks ( void )
 
             if(appData.isConfigured)
             {
+                /* Nothing that happened before configuration is sent, and
+                 * the transfers of the last configuration are gone */
+                MOTION_Clear(&appData.motion);
+                REPORT_POOL_Initialize(&appData.reportPool);
+
+                /* The speed was settled by the bus reset */
+                APP_FrameTimingSet(USB_DEVICE_ActiveSpeedGet(appData.deviceHandle));
+
+                /* The host has not seen the button state yet */
+                appData.isButtonChanged = true;
+                HID_IDLE_Start(&appData.idle);
                 appData.state = APP_STATE_MOUSE_EMULATE;
             }
             break;
@@ -462,109 +740,151 @@ void APP_Tasks ( void )
 
             APP_ProcessSwitchPress();
 
-            /* The following logic rotates the mouse icon when
-             * a switch is pressed */
+            /* The switch turns tilt control on and off */
 
             if(appData.isSwitchPressed)
             {
-                /* Toggle the mouse emulation with each switch press */
+                /* Toggle the mouse emulation with each switch press. The
+                 * position it is switched on in is the new rest position. */
                 appData.emulateMouse ^= 1;
                 appData.isSwitchPressed = false;
+                if(appData.emulateMouse && appData.accelValid)
+                {
+                    TILT_BiasCapture(&appData.tilt, &appData.accel);
+                }
             }
 
-            if(appData.emulateMouse)
+            /* The accelerometer is drained from its FIFO watermark
+             * interrupt. Catch up with everything it has queued; each
+             * sample goes through the rate converter, and each of its
+             * outputs adds its velocity, fractions included, to the pending
+             * movement, which the accumulator keeps until the endpoint is
+             * free again. The converter keeps running while tilt control
+             * is off, so that it has its history when it is switched back
+             * on. */
+            if(acc_sample_get(&sample))
             {
-                sent_dont_move = false;
-
-                if(movement_length > 50)
+                do
                 {
-                    short accels[3]; 
-                acc_read_register(OUT_X_L_A , (unsigned char *) accels, 6);
-                    appData.mouseButton[0] = MOUSE_BUTTON_STATE_RELEASED;
-                    appData.mouseButton[1] = MOUSE_BUTTON_STATE_RELEASED;
-                    appData.xCoordinate =(int8_t)dir_table[vector & 0x07] ;
-                    appData.yCoordinate =(int8_t)dir_table[(vector+2) & 0x07];
-                    //appData.xCoordinate=(int8_t)accels[0];
-                    //appData.yCoordinate=(int8_t)accels[1];
-                    vector ++;
-                    movement_length = 0;
-                }
+                    appData.accel = sample.sample;
+                    appData.accelTime = sample.time;
+                    appData.accelSequence = sample.sequence;
+                    appData.accelValid = true;
+#if CAPTURE_ENABLE
+                    CAPTURE_SamplePut(&sample);
+#endif
+#if DECIMATOR_ENABLE
+                    isFiltered = DECIMATOR_Put(&appData.decimator,
+                            &sample.sample, &filtered);
+#else
+                    filtered = sample.sample;
+                    isFiltered = true;
+#endif
+                    if(appData.emulateMouse && isFiltered)
+                    {
+                        TILT_Process(&appData.tilt, &filtered, &velocity);
+                        MOTION_Add(&appData.motion, velocity.x, velocity.y);
+                    }
+                } while(acc_sample_get(&sample));
+
+                TRACE_RECORD_EVENT(TRACE_EVENT_PIPELINE_OUT, TIMEBASE_COUNT_GET(),
+                        0, appData.accelSequence);
             }
-            else
-            { 
-                
-                
-                appData.mouseButton[0] = MOUSE_BUTTON_STATE_RELEASED;
-                appData.mouseButton[1] = MOUSE_BUTTON_STATE_RELEASED;
-                appData.xCoordinate = (int8_t)0;
-                appData.yCoordinate = (int8_t)0;
+
+            /* Tilt control has no buttons. While it is off, the device
+             * sends no movement either. */
+            APP_MouseButtonSet(0, MOUSE_BUTTON_STATE_RELEASED);
+            APP_MouseButtonSet(1, MOUSE_BUTTON_STATE_RELEASED);
+            if(!appData.emulateMouse)
+            {
+                MOTION_Clear(&appData.motion);
             }
 
-            if(!appData.isMouseReportSendBusy)
+            /* One report per frame, and only once the host has taken the
+             * previous one. A report queued behind one still waiting for
+             * its IN token would go out a whole polling interval later,
+             * with older movement than the next slot's report. */
+            if((REPORT_POOL_OwnedCount(&appData.reportPool) == 0) &&
+               APP_ReportSlotReached())
             {
-                if(((sent_dont_move == false) && (!appData.emulateMouse)) || (appData.emulateMouse))
-                {
+                /* Whatever is decided below, this frame is done */
+                appData.isFrameReportDone = true;
 
-                    /* This means we can send the mouse report. The
-                       isMouseReportBusy flag is updated in the HID Event Handler. */
+                /* The report is only built when there is a reason to
+                   send it. It is composed in a buffer the controller
+                   does not own, and given back when the HID Event
+                   Handler reports it sent. */
 
-                    appData.isMouseReportSendBusy = true;
+                reportIndex = REPORT_POOL_NONE;
+                if(APP_ReportIsDue())
+                {
+                    reportIndex = REPORT_POOL_Stage(&appData.reportPool);
+                }
+                if(reportIndex != REPORT_POOL_NONE)
+                {
+                    /* Take as much of the pending movement as fits in one
+                     * report. The rest goes out with the next one. */
+                    if(appData.activeProtocol == APP_HID_PROTOCOL_BOOT)
+                    {
+                        /* The fixed boot report, without report ID */
+                        MOTION_TakeBoot(&appData.motion, &appData.xCoordinate,
+                                &appData.yCoordinate);
+                        MOUSE_ReportBootCreate(appData.xCoordinate,
+                                appData.yCoordinate, appData.mouseButton,
+                                &mouseReports[reportIndex].boot);
+                        reportSize = sizeof(MOUSE_BOOT_REPORT);
+                    }
+                    else
+                    {
+                        MOTION_Take(&appData.motion, &appData.xCoordinate,
+                                &appData.yCoordinate);
 
-                    /* Create the mouse report */
+                        /* Create the mouse report */
 
-                    MOUSE_ReportCreate(appData.xCoordinate, appData.yCoordinate,
-                            appData.mouseButton, &mouseReport);
+                        MOUSE_ReportCreate(appData.xCoordinate, appData.yCoordinate,
+                                appData.mouseButton, &mouseReports[reportIndex].report);
+                        reportSize = sizeof(MOUSE_REPORT);
+                    }
 
-                    if(memcmp((const void *)&mouseReportPrevious, (const void *)&mouseReport,
-                            (size_t)sizeof(mouseReport)) == 0)
+                    /* Send the mouse report. The tracer follows it by
+                     * number until it has been sent. */
+                    appData.reportSequence ++;
+                    appData.reportBufferSequence[reportIndex] = appData.reportSequence;
+                    appData.reportBufferSampleSequence[reportIndex] = appData.accelSequence;
+                    appData.isFrameReportSent = true;
+                    TRACE_RECORD_EVENT(TRACE_EVENT_REPORT_SEND, TIMEBASE_COUNT_GET(),
+                            appData.reportSequence, appData.accelSequence);
+                    if(USB_DEVICE_HID_ReportSend(appData.hidInstance,
+                            &reportHandle, (uint8_t *)&mouseReports[reportIndex],
+                            reportSize) == USB_DEVICE_HID_RESULT_OK)
                     {
-                        /* Reports are same as previous report. However mouse reports
-                         * can be same as previous report as the co-ordinate positions are relative.
-                         * In that case it needs to be send */
-                        if((appData.xCoordinate == 0) && (appData.yCoordinate == 0))
-                        {
-                            /* If the coordinate positions are 0, that means there
-                             * is no relative change */
-                            if(appData.idleRate == 0)
-                            {
-                                appData.isMouseReportSendBusy = false;
-                            }
-                            else
-                            {
-                                /* Check the idle rate here. If idle rate time elapsed
-                                 * then the data will be sent. Idle rate resolution is
-                                 * 4 msec as per HID specification; possible range is
-                                 * between 4msec >= idlerate <= 1020 msec.
-                                 */
-                                if(appData.setIdleTimer * APP_USB_CONVERT_TO_MILLISECOND
-                                        >= appData.idleRate * 4)
-                                {
-                                    /* Send REPORT as idle time has elapsed */
-                                    appData.isMouseReportSendBusy = true;
-                                }
-                                else
-                                {
-                                    /* Do not send REPORT as idle time has not elapsed */
-                                    appData.isMouseReportSendBusy = false;
-                                }
-                            }
-                        }
-
+                        /* The controller owns the buffer until the
+                         * report has been sent */
+                        REPORT_POOL_Submit(&appData.reportPool, reportIndex,
+                                reportHandle);
+                        appData.isButtonChanged = false;
+                        HID_IDLE_ReportSent(&appData.idle, appData.mouseIdle);
                     }
-                    if(appData.isMouseReportSendBusy == true)
+                    else
                     {
-                        /* Copy the report sent to previous */
-                        memcpy((void *)&mouseReportPrevious, (const void *)&mouseReport,
-                                (size_t)sizeof(mouseReport));
-                        
-                        /* Send the mouse report. */
-                        USB_DEVICE_HID_ReportSend(appData.hidInstance,
-                            &appData.reportTransferHandle, (uint8_t*)&mouseReport,
-                            sizeof(MOUSE_REPORT));
-                        appData.setIdleTimer = 0;
+                        /* Not queued. The movement and the button
+                         * change go out with the next report instead. */
+                        REPORT_POOL_Unstage(&appData.reportPool, reportIndex);
+                        MOTION_Add(&appData.motion,
+                                appData.xCoordinate * MOTION_ONE,
+                                appData.yCoordinate * MOTION_ONE);
+                        appData.isFrameReportSent = false;
+                    }
+
+                    /* Sample age at report time */
+                    if(appData.accelValid)
+                    {
+                        appData.sampleAge = TIMEBASE_COUNT_GET() - appData.accelTime;
+                        if(appData.sampleAge > appData.sampleAgeMax)
+                        {
+                            appData.sampleAgeMax = appData.sampleAge;
+                        }
                     }
-                    movement_length ++;
-                    sent_dont_move = true;
                 }
             }
 
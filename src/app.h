@@ -60,22 +60,59 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 #include "system_config.h"
 #include "system_definitions.h"
 #include "mouse.h"
-//#include "accel.h"
+#include "accel.h"
+#include "spsc_ring.h"
+#include "motion.h"
+#include "timebase.h"
+#include "timer_wheel.h"
+#include "run_loop.h"
+#include "profiler.h"
+#include "trace.h"
+#include "capture.h"
+#include "tilt.h"
+#include "decimator.h"
+#include "report_pool.h"
+#include "hid_idle.h"
+
+#ifndef APP_STATS_ENABLE
+#define APP_STATS_ENABLE false
+#endif
+
+#if (PROFILER_ENABLE || TRACE_ENABLE || APP_STATS_ENABLE || CAPTURE_ENABLE) && \
+    (MOUSE_REPORT_ID == 0)
+#error "The diagnostic feature reports require MOUSE_REPORT_ID"
+#endif
+
+/* Sensor samples each tilt pipeline step stands for, as a fraction */
+#if DECIMATOR_ENABLE
+#define APP_PIPELINE_SAMPLES_NUM    DECIMATOR_DOWN
+#define APP_PIPELINE_SAMPLES_DEN    DECIMATOR_UP
+#else
+#define APP_PIPELINE_SAMPLES_NUM    1
+#define APP_PIPELINE_SAMPLES_DEN    1
+#endif
+
+/* Mouse reports the HID function driver can hold. The driver's send
+   queue (queueSizeReportSend) must be at least this deep, and so must the
+   report pool. APP_Tasks keeps no more than one report waiting for its IN
+   token, so entries beyond the first stay unused. */
+#ifndef APP_REPORT_QUEUE_DEPTH
+#define APP_REPORT_QUEUE_DEPTH      1
+#endif
+
+#if APP_REPORT_QUEUE_DEPTH + 1 > USB_DEVICE_HID_QUEUE_DEPTH_COMBINED
+#error "USB_DEVICE_HID_QUEUE_DEPTH_COMBINED cannot hold the report queue and a receive"
+#endif
+
+#if REPORT_POOL_BUFFERS < APP_REPORT_QUEUE_DEPTH
+#error "REPORT_POOL_BUFFERS must be at least APP_REPORT_QUEUE_DEPTH"
+#endif
+
+#if TILT_VELOCITY_FRACTION_BITS != MOTION_FRACTION_BITS
+#error "The tilt velocities go into the motion accumulator as they are"
+#endif
 
 
-// Basic interface with an LSM303D accelerometer/compass.
-// Used for both i2c and spi examples, but with different implementation (.c) files
-
-                        // register addresses
-#define CTRL1 0x20      // control register 1
-#define CTRL5 0x24      // control register 5
-#define CTRL7 0x26      // control register 7
-
-#define OUT_X_L_A 0x28  // LSB of x axis acceleration register.
-                        // all acceleration registers are contiguous, and this is the lowest address
-#define OUT_X_L_M 0x08  // LSB of x axis of magnetometer register
-
-#define TEMP_OUT_L 0x05 // temperature sensor register
 // *****************************************************************************
 // *****************************************************************************
 // Section: Type Definitions
@@ -109,6 +146,140 @@ typedef enum
 
 } APP_STATES;
 
+// *****************************************************************************
+/* Application events
+
+  Summary:
+    USB events handed from the USB interrupt to the application tasks.
+
+  Description:
+    The USB device and HID event handlers run in the USB interrupt.  Instead
+    of setting flags that the next event would overwrite, they queue one of
+    these per event and APP_Tasks works through them in order.
+*/
+
+typedef enum
+{
+    /* Start of frame. data is the USB frame number. */
+    APP_EVENT_SOF = 0,
+
+    /* A HID report was sent. data is its transfer handle. */
+    APP_EVENT_REPORT_SENT,
+
+    /* The host changed an idle duration. data is the report ID. */
+    APP_EVENT_SET_IDLE,
+
+    /* The host selected the boot or the report protocol */
+    APP_EVENT_SET_PROTOCOL
+
+} APP_EVENT_TYPE;
+
+typedef struct
+{
+    APP_EVENT_TYPE type;
+    uintptr_t data;
+
+    /* Core timer count when the event was raised */
+    uint32_t time;
+
+} APP_EVENT;
+
+/* SET_PROTOCOL and GET_PROTOCOL values. The device starts in the report
+   protocol, and goes back to it when the bus is reset. */
+#define APP_HID_PROTOCOL_BOOT       0
+#define APP_HID_PROTOCOL_REPORT     1
+
+/* Queued USB events, a power of two */
+#define APP_EVENT_QUEUE_DEPTH   16
+
+/* Full speed frame and high speed microframe lengths, and the core timer
+   (SYSCLK / 2) rate. An SOF starts each of either. */
+#define APP_USB_FRAME_US        1000
+#define APP_USB_MICROFRAME_US   125
+#define APP_CORE_TICKS_PER_US   (SYS_CLK_FREQ / 2 / 1000000)
+
+/* Microseconds before the next SOF at which the frame's report is built,
+   for configurations that do not choose their own.  This is the lead in a
+   full speed frame; at high speed it shrinks with the microframe. */
+#ifndef APP_REPORT_LEAD_US
+#define APP_REPORT_LEAD_US      150
+#endif
+
+// *****************************************************************************
+/* Application Statistics
+
+  Summary:
+    What the application delivered over a window of USB frames.
+
+  Description:
+    Counted from the SOF and REPORT_SENT events, so that the host can
+    compare configurations on the board itself.  The last complete window
+    is read, together with the motion, sensor and run loop counters, as a
+    vendor defined feature report when APP_STATS_ENABLE is true.
+*/
+
+typedef struct
+{
+    /* USB frames in the window */
+    uint32_t frames;
+
+    /* Reports the host collected */
+    uint32_t reportsSent;
+
+    /* Frames that ended with movement pending but without a report */
+    uint32_t framesMissed;
+
+    /* Longest time between two reports sent, core timer ticks */
+    uint32_t sentGapMax;
+
+} APP_STATS;
+
+/* One second, 1000 frames at full speed and 8000 microframes at high
+   speed */
+#define APP_STATS_WINDOW_US         1000000
+
+/* Report ID, format (2), the report queue depth, a reserved byte, then
+   twelve 32-bit little endian counters: the APP_STATS fields, the motion
+   saturation count, the sample queue overflows, the FIFO overruns, the
+   largest sample age and the RUN_LOOP_STATS fields. */
+#define APP_STATS_REPORT_FORMAT     2
+#define APP_STATS_REPORT_VALUES     12
+#define APP_STATS_REPORT_SIZE       (4 + APP_STATS_REPORT_VALUES * 4)
+
+#define APP_STATS_REPORT_DESCRIPTOR                                           \
+    0x06, 0x00, 0xFF,           /* Usage Page (Vendor Defined FF00)  */       \
+    0x09, 0x05,                 /* Usage (5)                         */       \
+    0xA1, 0x01,                 /* Collection (Application)          */       \
+    0x85, APP_STATS_REPORT_ID,  /*   Report ID                       */       \
+    0x09, 0x06,                 /*   Usage (6)                       */       \
+    0x15, 0x00,                 /*   Logical Minimum (0)             */       \
+    0x26, 0xFF, 0x00,           /*   Logical Maximum (255)           */       \
+    0x75, 0x08,                 /*   Report Size (8)                 */       \
+    0x95, APP_STATS_REPORT_SIZE - 1,                                          \
+                                /*   Report Count                    */       \
+    0xB1, 0x02,                 /*   Feature (Data, Variable, Abs)   */       \
+    0xC0                        /* End Collection                    */
+
+
+// *****************************************************************************
+/* Mouse Report Buffer
+
+  Summary:
+    One of the buffers the mouse reports are composed and sent in.
+
+  Remarks:
+    Padded to whole words, so that every buffer of an array starts as
+    aligned as the array.
+*/
+
+typedef union
+{
+    MOUSE_REPORT report;
+    MOUSE_BOOT_REPORT boot;
+    uint32_t align[(sizeof(MOUSE_REPORT) + 3) / 4];
+
+} APP_MOUSE_REPORT_BUFFER;
+
 
 // *****************************************************************************
 /* Application Data
@@ -152,32 +323,83 @@ typedef struct
     /* Mouse buttons*/
     MOUSE_BUTTON_STATE mouseButton[MOUSE_BUTTON_NUMBERS];
 
+    /* A button has changed since the last report was sent */
+    bool isButtonChanged;
+
     /* HID instance associated with this app object*/
     SYS_MODULE_INDEX hidInstance;
 
-    /* Transfer handle */
-    USB_DEVICE_HID_TRANSFER_HANDLE reportTransferHandle;
+    /* Who owns each of the mouse report buffers */
+    REPORT_POOL reportPool;
 
     /* Device Layer System Module Object */
     SYS_MODULE_OBJ deviceLayerObject;
 
-    /* USB HID active Protocol */
+    /* USB HID active Protocol, APP_HID_PROTOCOL_BOOT or
+       APP_HID_PROTOCOL_REPORT */
     uint8_t activeProtocol;
 
-    /* USB HID current Idle */
-    uint8_t idleRate;
+    /* Idle durations of the input reports, and the mouse report's handle */
+    HID_IDLE idle;
+    int mouseIdle;
 
-    /* Tracks the progress of the report send */
-    bool isMouseReportSendBusy;
+    /* Idle duration being returned to the host */
+    uint8_t idleDuration;
 
-    /* Flag determines SOF event has occured */
-    bool sofEventHasOccurred;
+    /* Core timer count when the last report was sent, and whether reports
+       have been going out since, for sentGapMax */
+    uint32_t reportSentTime;
+    bool isReportStreaming;
 
-    /* Switch debounce timer */
-    unsigned int switchDebounceTimer;
+    /* Core timer count at the most recent SOF */
+    uint32_t sofTime;
+
+    /* For the bus speed of the configuration: core timer ticks from SOF to
+       the point where the frame's report is built, and the frames in a
+       statistics window */
+    uint32_t reportSubmitTicks;
+    uint32_t statsWindowFrames;
 
-    /* SET IDLE timer */
-    uint16_t setIdleTimer;
+    /* The report for the current frame has been dealt with */
+    bool isFrameReportDone;
+
+    /* Converts the samples to the report rate */
+    DECIMATOR decimator;
+
+    /* Maps accelerometer tilt to pointer velocity */
+    TILT_PIPELINE tilt;
+
+    /* Movement not yet sent to the host */
+    MOTION_ACCUMULATOR motion;
+
+    /* Switch debounce timer */
+    TIMER_WHEEL_TIMER switchDebounceTimer;
+
+    /* Most recent accelerometer sample and the core timer count at which
+       the sensor produced it */
+    ACC_SAMPLE accel;
+    uint32_t accelTime;
+    uint16_t accelSequence;
+    bool accelValid;
+
+    /* Number of the last report built, and for the latency tracer, per
+       report buffer, the number of the report in it and of the newest
+       sample taken before it was built */
+    uint8_t reportSequence;
+    uint8_t reportBufferSequence[REPORT_POOL_BUFFERS];
+    uint16_t reportBufferSampleSequence[REPORT_POOL_BUFFERS];
+
+    /* A report was handed to the HID driver in the current frame */
+    bool isFrameReportSent;
+
+    /* Statistics of the window in progress and of the last complete one */
+    APP_STATS stats;
+    APP_STATS statsLast;
+
+    /* Age of the newest sample when the last report was sent, and the
+       largest age seen since configuration, in core timer ticks */
+    uint32_t sampleAge;
+    uint32_t sampleAgeMax;
 
 } APP_DATA;
 
@@ -262,13 +484,6 @@ void APP_Initialize ( void );
  */
 
 void APP_Tasks ( void );
-void acc_read_register(unsigned char reg, unsigned char data[], unsigned int len); 
-
-// write to the register
-void acc_write_register(unsigned char reg, unsigned char data);                    
-
-// initialize the accelerometer
-void acc_setup(); 
 
 #endif /* _APP_H */
 /*******************************************************************************
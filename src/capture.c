@@ -0,0 +1,102 @@
+/*******************************************************************************
+  Sensor Capture Source File
+
+  File Name:
+    capture.c
+
+  Summary:
+    Streams the raw accelerometer samples the application consumes to the
+    host.
+*******************************************************************************/
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "capture.h"
+#include "spsc_ring.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#if CAPTURE_ENABLE
+/* Filled by APP_Tasks, emptied from the USB interrupt */
+SPSC_RING_DEFINE(captureQueue, ACC_STAMPED_SAMPLE, CAPTURE_QUEUE_SIZE);
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void _CAPTURE_Pack16 ( uint8_t * buffer, uint16_t value )
+{
+    buffer[0] = (uint8_t)value;
+    buffer[1] = (uint8_t)(value >> 8);
+}
+
+static void _CAPTURE_Pack32 ( uint8_t * buffer, uint32_t value )
+{
+    _CAPTURE_Pack16(buffer, (uint16_t)value);
+    _CAPTURE_Pack16(&buffer[2], (uint16_t)(value >> 16));
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Capture Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void CAPTURE_SamplePut ( const ACC_STAMPED_SAMPLE * sample )
+{
+    if((sample->sequence & (CAPTURE_DECIMATION - 1)) != 0)
+    {
+        return;
+    }
+    SPSC_RING_Put(&captureQueue, sample);
+}
+
+void CAPTURE_ReportGet ( uint8_t * report )
+{
+    ACC_STAMPED_SAMPLE sample;
+    uint8_t * out = &report[CAPTURE_REPORT_HEADER_BYTES];
+    unsigned int count = 0;
+
+    while((count < CAPTURE_REPORT_SAMPLES) && SPSC_RING_Get(&captureQueue, &sample))
+    {
+        _CAPTURE_Pack16(&out[0], (uint16_t)sample.sample.x);
+        _CAPTURE_Pack16(&out[2], (uint16_t)sample.sample.y);
+        _CAPTURE_Pack16(&out[4], (uint16_t)sample.sample.z);
+        _CAPTURE_Pack16(&out[6], sample.sequence);
+        _CAPTURE_Pack32(&out[8], sample.time);
+        out += CAPTURE_SAMPLE_BYTES;
+        count ++;
+    }
+
+    /* Unused slots are zero */
+    while(out < &report[CAPTURE_REPORT_SIZE])
+    {
+        *out++ = 0;
+    }
+
+    report[0] = CAPTURE_REPORT_ID;
+    report[1] = CAPTURE_REPORT_FORMAT;
+    report[2] = (uint8_t)count;
+    report[3] = 0;
+    _CAPTURE_Pack32(&report[4], SPSC_RING_OverflowsGet(&captureQueue));
+}
+#endif
+
+
+/*******************************************************************************
+ End of File
+ */
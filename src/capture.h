@@ -0,0 +1,139 @@
+/*******************************************************************************
+  Sensor Capture Header File
+
+  File Name:
+    capture.h
+
+  Summary:
+    Streams the raw accelerometer samples the application consumes to the
+    host.
+
+  Description:
+    Every sample APP_Tasks takes from the accelerometer queue is also put
+    into a capture ring, with its sequence number and timestamp.  The host
+    drains the ring with a vendor defined feature report in a top-level
+    collection of its own; tools/sensor_capture.py stores what it reads in a
+    compact trace file for replay through the motion pipeline.
+
+    The ring drops new samples when the host does not keep up.  The drop
+    count goes out with every report and the sequence numbers show where the
+    gaps are.  Everything compiles away unless the system configuration sets
+    CAPTURE_ENABLE to true.
+
+    Each report is a control read over the 8-byte EP0: a SETUP, 31 DATA and
+    a STATUS transaction for 248 bytes.  Keeping up with 1600 Hz takes 80
+    reports a second, so a host whose GET_REPORT round trip averages more
+    than 12.5 ms loses samples, and the ring's 80 ms only covers bursts.
+    Where that is out of reach, CAPTURE_DECIMATION thins the stream at the
+    source instead; the gaps then show in the sequence numbers, not in the
+    drop count.
+*******************************************************************************/
+
+#ifndef _CAPTURE_H
+#define _CAPTURE_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "system_config.h"
+#include "accel.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants
+// *****************************************************************************
+// *****************************************************************************
+
+#ifndef CAPTURE_ENABLE
+#define CAPTURE_ENABLE              false
+#endif
+
+/* Every CAPTURE_DECIMATION-th sample by sequence number is captured, a
+   power of two.  2 halves the report rate to 40 a second. */
+#ifndef CAPTURE_DECIMATION
+#define CAPTURE_DECIMATION          1
+#endif
+
+/* Samples buffered for the host, a power of two. 80 ms at 1600 Hz. */
+#define CAPTURE_QUEUE_SIZE          128
+
+/* Samples per feature report */
+#define CAPTURE_REPORT_SAMPLES      20
+
+/* x, y, z, sequence as 16-bit and time as 32-bit values, little endian */
+#define CAPTURE_SAMPLE_BYTES        12
+
+// *****************************************************************************
+/* Capture Feature Report
+
+  Description:
+    Report ID, format (1), number of samples that follow, one reserved byte,
+    samples dropped by the ring since reset (32-bit little endian), then
+    CAPTURE_REPORT_SAMPLES sample slots.  Each report returns the oldest
+    samples in the ring and removes them.
+*/
+
+#define CAPTURE_REPORT_FORMAT       1
+#define CAPTURE_REPORT_HEADER_BYTES 8
+#define CAPTURE_REPORT_SIZE         (CAPTURE_REPORT_HEADER_BYTES + \
+                                     CAPTURE_REPORT_SAMPLES * CAPTURE_SAMPLE_BYTES)
+
+#define CAPTURE_REPORT_DESCRIPTOR                                             \
+    0x06, 0x00, 0xFF,           /* Usage Page (Vendor Defined FF00)  */       \
+    0x09, 0x07,                 /* Usage (7)                         */       \
+    0xA1, 0x01,                 /* Collection (Application)          */       \
+    0x85, CAPTURE_REPORT_ID,    /*   Report ID                       */       \
+    0x09, 0x08,                 /*   Usage (8)                       */       \
+    0x15, 0x00,                 /*   Logical Minimum (0)             */       \
+    0x26, 0xFF, 0x00,           /*   Logical Maximum (255)           */       \
+    0x75, 0x08,                 /*   Report Size (8)                 */       \
+    0x95, CAPTURE_REPORT_SIZE - 1,                                            \
+                                /*   Report Count                    */       \
+    0xB1, 0x02,                 /*   Feature (Data, Variable, Abs)   */       \
+    0xC0                        /* End Collection                    */
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Capture Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void CAPTURE_SamplePut ( const ACC_STAMPED_SAMPLE * sample )
+
+  Summary:
+    Queues a sample for the host.
+
+  Remarks:
+    Task context only; the ring has a single producer.
+*/
+
+void CAPTURE_SamplePut ( const ACC_STAMPED_SAMPLE * sample );
+
+/*******************************************************************************
+  Function:
+    void CAPTURE_ReportGet ( uint8_t * report )
+
+  Summary:
+    Moves the oldest samples into CAPTURE_REPORT_SIZE bytes of feature
+    report.
+
+  Remarks:
+    Called from the USB interrupt only; the ring has a single consumer.
+*/
+
+void CAPTURE_ReportGet ( uint8_t * report );
+
+#endif /* _CAPTURE_H */
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,96 @@
+/*******************************************************************************
+  Sample Rate Converter Source File
+
+  File Name:
+    decimator.c
+
+  Summary:
+    Low pass filters the accelerometer samples and converts them from the
+    sensor's output data rate to the report rate, in integer arithmetic.
+*******************************************************************************/
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "decimator.h"
+#include "dsp.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* DECIMATOR_TAPS per phase, oldest sample's coefficient first. The design
+   tool keeps the sum of the magnitudes of a phase below 2.0 and every
+   coefficient above -32768, as DSP_DotQ15() requires. */
+static const int16_t decimatorCoefficients[DECIMATOR_UP * DECIMATOR_TAPS] =
+{
+    DECIMATOR_COEFFICIENTS
+};
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Sample Rate Converter Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void DECIMATOR_Initialize ( DECIMATOR * decimator )
+{
+    unsigned int tap;
+
+    for(tap = 0; tap < 2 * DECIMATOR_TAPS; tap ++)
+    {
+        decimator->x[tap] = 0;
+        decimator->y[tap] = 0;
+    }
+    decimator->index = 0;
+    decimator->phase = 0;
+}
+
+bool DECIMATOR_Put ( DECIMATOR * decimator, const ACC_SAMPLE * sample,
+                     ACC_SAMPLE * output )
+{
+    unsigned int index = decimator->index;
+    const int16_t * coefficients;
+
+    decimator->x[index] = sample->x;
+    decimator->x[index + DECIMATOR_TAPS] = sample->x;
+    decimator->y[index] = sample->y;
+    decimator->y[index + DECIMATOR_TAPS] = sample->y;
+
+    /* The window now starts at the oldest sample, just after this one */
+    index ++;
+    if(index == DECIMATOR_TAPS)
+    {
+        index = 0;
+    }
+    decimator->index = index;
+
+    if(decimator->phase >= DECIMATOR_UP)
+    {
+        /* The next output falls after the next sample */
+        decimator->phase -= DECIMATOR_UP;
+        return false;
+    }
+
+    coefficients = &decimatorCoefficients[decimator->phase * DECIMATOR_TAPS];
+    output->x = DSP_DotQ15(&decimator->x[index], coefficients, DECIMATOR_TAPS);
+    output->y = DSP_DotQ15(&decimator->y[index], coefficients, DECIMATOR_TAPS);
+    output->z = sample->z;
+
+    /* DECIMATOR_UP <= DECIMATOR_DOWN, so that was the only output due */
+    decimator->phase += DECIMATOR_DOWN - DECIMATOR_UP;
+    return true;
+}
+
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,161 @@
+/*******************************************************************************
+  Sample Rate Converter Header File
+
+  File Name:
+    decimator.h
+
+  Summary:
+    Low pass filters the accelerometer samples and converts them from the
+    sensor's output data rate to the report rate, in integer arithmetic.
+
+  Description:
+    The sensor runs at ACC_ODR_HZ while the host takes at most one report
+    per frame.  Integrating every sample into the report is a box car
+    filter, which lets sensor noise and vibration above the report rate's
+    Nyquist frequency fold back into the pointer motion.
+
+    The converter is a polyphase FIR filter with the rational ratio
+    DECIMATOR_UP / DECIMATOR_DOWN.  Conceptually every sample is followed
+    by DECIMATOR_UP - 1 zeros, low pass filtered at the higher rate and only
+    every DECIMATOR_DOWN-th result kept.  Only the kept results are
+    computed: each one takes one phase of DECIMATOR_TAPS coefficients, so
+    the cost is the same for every output.  The prototype filter is
+    symmetric, so the delay is constant too, DECIMATOR_DELAY_TICKS.
+
+    The coefficients come from tools/decimator_design.py, which also
+    reports the filter's response.  Each phase is Q15 with a DC gain of
+    exactly 1, so a steady tilt gives the same output whatever the phase.
+    The x and y axes are filtered; z is passed through.
+*******************************************************************************/
+
+#ifndef _DECIMATOR_H
+#define _DECIMATOR_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "system_config.h"
+#include "accel.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants and Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#ifndef DECIMATOR_ENABLE
+#define DECIMATOR_ENABLE            false
+#endif
+
+/* Output rate. One report per full speed frame. */
+#ifndef DECIMATOR_RATE_HZ
+#define DECIMATOR_RATE_HZ           1000
+#endif
+
+/* 1600 Hz to 1000 Hz, 8 taps per phase, -6 dB at 500 Hz, Kaiser beta 5.0.
+   Delay 2.44 ms, 8 multiplies per output and axis.  Response: 50 Hz 0.0 dB,
+   950 Hz (aliases onto 50 Hz) -75.0 dB, 1550 Hz (image of 50 Hz) -71.7 dB.
+   A configuration with another ODR or rate pastes its own from the tool. */
+#ifndef DECIMATOR_COEFFICIENTS
+#define DECIMATOR_UP                5
+#define DECIMATOR_DOWN              8
+#define DECIMATOR_TAPS              8
+#define DECIMATOR_COEFFICIENTS                                                \
+      -121,  -2068,   6598,  20377,  10107,  -1746,   -476,     97,          \
+        85,  -1910,   3462,  19092,  13614,   -769,   -955,    149,          \
+       161,  -1478,    965,  16736,  16736,    965,  -1478,    161,          \
+       149,   -955,   -769,  13614,  19092,   3462,  -1910,     85,          \
+        97,   -476,  -1746,  10107,  20377,   6598,  -2068,   -121
+#endif
+
+#if DECIMATOR_ENABLE && ((ACC_ODR_HZ * DECIMATOR_UP) != (DECIMATOR_RATE_HZ * DECIMATOR_DOWN))
+#error "DECIMATOR_COEFFICIENTS were designed for another ODR or rate"
+#endif
+
+#if DECIMATOR_UP > DECIMATOR_DOWN
+#error "The decimator does not raise the sample rate"
+#endif
+
+/* Core timer ticks between a change of tilt and the middle of the output's
+   step response, for the latency budget */
+#define DECIMATOR_DELAY_TICKS                                                 \
+    (((DECIMATOR_UP * DECIMATOR_TAPS - 1) * ACC_TICKS_PER_SAMPLE) /           \
+     (2 * DECIMATOR_UP))
+
+/* Multiply-accumulates per output, for the CPU budget. There are
+   DECIMATOR_UP outputs for every DECIMATOR_DOWN samples. */
+#define DECIMATOR_MACS_PER_OUTPUT   (2 * DECIMATOR_TAPS)
+
+// *****************************************************************************
+/* Sample Rate Converter State
+
+  Remarks:
+    The members are private to the decimator functions.
+*/
+
+typedef struct
+{
+    /* Last DECIMATOR_TAPS samples of each axis, stored twice so that the
+       window ending at the newest one is always contiguous */
+    int16_t x[2 * DECIMATOR_TAPS];
+    int16_t y[2 * DECIMATOR_TAPS];
+
+    /* Where the next sample goes */
+    uint8_t index;
+
+    /* Phase of the next output at the DECIMATOR_UP times higher rate,
+       counted from the newest sample.  No output is due before the next
+       sample while it is DECIMATOR_UP or more. */
+    uint8_t phase;
+
+} DECIMATOR;
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Sample Rate Converter Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void DECIMATOR_Initialize ( DECIMATOR * decimator )
+
+  Summary:
+    Clears the filter history.
+*/
+
+void DECIMATOR_Initialize ( DECIMATOR * decimator );
+
+/*******************************************************************************
+  Function:
+    bool DECIMATOR_Put ( DECIMATOR * decimator, const ACC_SAMPLE * sample,
+                         ACC_SAMPLE * output )
+
+  Summary:
+    Adds the next sensor sample and computes the output that is due, if any.
+
+  Description:
+    Called for every sample as the application drains each batch from the
+    sample queue.  DECIMATOR_UP out of every DECIMATOR_DOWN calls produce
+    an output.
+
+  Returns:
+    true  - output holds the next filtered sample.
+    false - No output is due yet.
+*/
+
+bool DECIMATOR_Put ( DECIMATOR * decimator, const ACC_SAMPLE * sample,
+                     ACC_SAMPLE * output );
+
+#endif /* _DECIMATOR_H */
+/*******************************************************************************
+ End of File
+ */
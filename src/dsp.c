@@ -0,0 +1,189 @@
+/*******************************************************************************
+  Q15 Arithmetic Kernels Source File
+
+  File Name:
+    dsp.c
+
+  Summary:
+    The inner loops of the sample rate converter and the tilt gain curve,
+    with a MIPS DSP ASE variant for the cores that have it.
+*******************************************************************************/
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "dsp.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#if DSP_ASE_ENABLE
+/* Two Q15 values in one register, the lower address in the low half */
+typedef short v2q15 __attribute__ ((vector_size(4)));
+
+/* DSP ASE accumulator */
+typedef long long a64;
+
+/* Lets the compiler load and store a pair from a halfword aligned address */
+typedef struct __attribute__ ((packed))
+{
+    v2q15 pair;
+
+} _DSP_UNALIGNED_PAIR;
+#endif
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Gain curve at m, shared by both variants. m is 0..32767. */
+static inline int32_t _DSP_CurveLookup ( const int16_t * curve, int32_t m,
+                                         unsigned int fractionBits )
+{
+    int32_t segment;
+    int32_t fraction;
+
+    if(m == 0)
+    {
+        return 0;
+    }
+
+    segment = m >> fractionBits;
+    fraction = m & ((1 << fractionBits) - 1);
+    return curve[segment] +
+            (((curve[segment + 1] - curve[segment]) * fraction) >> fractionBits);
+}
+
+#if DSP_ASE_ENABLE
+
+static inline v2q15 _DSP_PairLoad ( const int16_t * p )
+{
+    return ((const _DSP_UNALIGNED_PAIR *)p)->pair;
+}
+
+static inline void _DSP_PairStore ( int16_t * p, v2q15 pair )
+{
+    ((_DSP_UNALIGNED_PAIR *)p)->pair = pair;
+}
+
+#else
+
+static inline int32_t _DSP_Saturate16 ( int32_t value )
+{
+    if(value > INT16_MAX)
+    {
+        return INT16_MAX;
+    }
+    if(value < INT16_MIN)
+    {
+        return INT16_MIN;
+    }
+    return value;
+}
+
+#endif
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Kernel Functions
+// *****************************************************************************
+// *****************************************************************************
+
+#if DSP_ASE_ENABLE
+
+int16_t DSP_DotQ15 ( const int16_t * x, const int16_t * h, unsigned int count )
+{
+    a64 sum = 0;
+    unsigned int n;
+
+    /* DPAQ_S.W.PH adds both fractional products, each doubled, in one go.
+       Only -32768 * -32768 would saturate, and h[] excludes it. */
+    for(n = 0; n + 1 < count; n += 2)
+    {
+        sum = __builtin_mips_dpaq_s_w_ph(sum, _DSP_PairLoad(&x[n]),
+                                         _DSP_PairLoad(&h[n]));
+    }
+    if(count & 1)
+    {
+        sum = __builtin_mips_madd(sum, (int32_t)x[n] << 1, h[n]);
+    }
+
+    /* sum is twice the reference's, so rounding at bit 15 and shifting by 16
+       gives its result. It fits 17 bits; saturate it through the top half. */
+    return (int16_t)(__builtin_mips_shll_s_w(__builtin_mips_extr_r_w(sum, 16),
+                                             16) >> 16);
+}
+
+void DSP_CurvePairQ15 ( const int16_t * input, const int16_t * offset,
+                        int16_t deadZone, const int16_t * curve,
+                        unsigned int fractionBits, int16_t * output )
+{
+    const v2q15 zero = { 0, 0 };
+    const v2q15 dead = { deadZone, deadZone };
+    v2q15 t;
+    v2q15 m;
+    v2q15 v;
+
+    t = __builtin_mips_subq_s_ph(_DSP_PairLoad(input), _DSP_PairLoad(offset));
+    m = __builtin_mips_subq_s_ph(__builtin_mips_absq_s_ph(t), dead);
+    __builtin_mips_cmp_lt_ph(m, zero);
+    m = __builtin_mips_pick_ph(zero, m);
+
+    /* The table lookups are per lane */
+    v = (v2q15){ _DSP_CurveLookup(curve, m[0], fractionBits),
+                 _DSP_CurveLookup(curve, m[1], fractionBits) };
+
+    __builtin_mips_cmp_lt_ph(t, zero);
+    _DSP_PairStore(output,
+            __builtin_mips_pick_ph(__builtin_mips_subq_s_ph(zero, v), v));
+}
+
+#else
+
+int16_t DSP_DotQ15 ( const int16_t * x, const int16_t * h, unsigned int count )
+{
+    int32_t sum = 1 << 14;
+    unsigned int n;
+
+    for(n = 0; n < count; n ++)
+    {
+        sum += (int32_t)x[n] * h[n];
+    }
+
+    return (int16_t)_DSP_Saturate16(sum >> 15);
+}
+
+void DSP_CurvePairQ15 ( const int16_t * input, const int16_t * offset,
+                        int16_t deadZone, const int16_t * curve,
+                        unsigned int fractionBits, int16_t * output )
+{
+    unsigned int lane;
+
+    for(lane = 0; lane < 2; lane ++)
+    {
+        int32_t t = _DSP_Saturate16((int32_t)input[lane] - offset[lane]);
+        int32_t m = _DSP_Saturate16((t < 0) ? -t : t) - deadZone;
+        int32_t v = _DSP_CurveLookup(curve, (m < 0) ? 0 : m, fractionBits);
+
+        output[lane] = (int16_t)_DSP_Saturate16((t < 0) ? -v : v);
+    }
+}
+
+#endif
+
+
+/*******************************************************************************
+ End of File
+ */
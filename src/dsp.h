@@ -0,0 +1,119 @@
+/*******************************************************************************
+  Q15 Arithmetic Kernels Header File
+
+  File Name:
+    dsp.h
+
+  Summary:
+    The inner loops of the sample rate converter and the tilt gain curve,
+    with a MIPS DSP ASE variant for the cores that have it.
+
+  Description:
+    Each kernel has a portable C reference, used on the PIC32MX and on the
+    host, and a variant built on the DSP ASE's paired 16-bit saturating
+    arithmetic and 64-bit accumulators, used when DSP_ASE_ENABLE is true.
+    The two give bit-identical results for every input the callers can
+    produce; where that depends on a precondition, it is stated with the
+    kernel.
+
+    DSP_ASE_ENABLE follows the compiler (__mips_dsp, set by -mdsp or
+    -mdspr2) unless the system configuration sets it.
+*******************************************************************************/
+
+#ifndef _DSP_H
+#define _DSP_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "system_config.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants and Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#ifndef DSP_ASE_ENABLE
+#if defined(__mips_dsp)
+#define DSP_ASE_ENABLE              true
+#else
+#define DSP_ASE_ENABLE              false
+#endif
+#endif
+
+#if DSP_ASE_ENABLE && !defined(__mips_dsp)
+#error "DSP_ASE_ENABLE needs a build for a core with the DSP ASE (-mdspr2)"
+#endif
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Kernel Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    int16_t DSP_DotQ15 ( const int16_t * x, const int16_t * h,
+                         unsigned int count )
+
+  Summary:
+    Q15 dot product of count samples and coefficients.
+
+  Description:
+    Returns the sum of x[n] * h[n], shifted right by 15 with rounding and
+    saturated to int16_t.
+
+  Precondition:
+    The sum of the magnitudes of h is below 2.0, so that the 32-bit sum of
+    the reference cannot overflow, and no h[n] is -32768, which the DSP
+    ASE's fractional multiply would saturate.
+
+  Remarks:
+    Neither pointer needs to be aligned to a pair.
+*/
+
+int16_t DSP_DotQ15 ( const int16_t * x, const int16_t * h, unsigned int count );
+
+/*******************************************************************************
+  Function:
+    void DSP_CurvePairQ15 ( const int16_t * input, const int16_t * offset,
+                            int16_t deadZone, const int16_t * curve,
+                            unsigned int fractionBits, int16_t * output )
+
+  Summary:
+    Maps a pair of values through a symmetric gain curve with a dead zone.
+
+  Description:
+    For each of the two lanes:
+
+      t = saturate(input - offset)
+      m = saturate(|t|) - deadZone, 0 if negative
+      v = 0 if m is 0, otherwise curve[] at m, linearly interpolated
+          between the entries 2^fractionBits apart
+      output = t < 0 ? -v : v
+
+  Precondition:
+    deadZone is not negative.  curve has (32768 >> fractionBits) + 1
+    entries, none of them -32768.
+
+  Remarks:
+    Each of input, offset and output points at an array of two values.
+*/
+
+void DSP_CurvePairQ15 ( const int16_t * input, const int16_t * offset,
+                        int16_t deadZone, const int16_t * curve,
+                        unsigned int fractionBits, int16_t * output );
+
+#endif /* _DSP_H */
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,209 @@
+/*******************************************************************************
+  HID Idle Rate Source File
+
+  File Name:
+    hid_idle.c
+
+  Summary:
+    Keeps the idle rate of each input report and tells when a report has
+    to be repeated.
+
+  Description:
+    See hid_idle.h.
+*******************************************************************************/
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "hid_idle.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void _HID_IDLE_Expired ( TIMER_WHEEL_TIMER * timer, uintptr_t context )
+{
+    ((HID_IDLE_REPORT *)context)->isDue = true;
+}
+
+/* The report applies to a request for reportID */
+static inline bool _HID_IDLE_Matches ( const HID_IDLE_REPORT * report,
+                                       uint8_t reportID )
+{
+    return ((reportID == 0) || (report->reportID == reportID));
+}
+
+/* Runs the period that began at sentTime with the current duration */
+static void _HID_IDLE_Schedule ( HID_IDLE_REPORT * report, uint64_t now )
+{
+    uint8_t duration = report->duration;
+
+    if(duration == 0)
+    {
+        /* Infinite. The report only goes out when it changes. */
+        TIMER_WHEEL_Stop(&report->timer);
+        report->isDue = false;
+        return;
+    }
+
+    report->deadline = report->sentTime + HID_IDLE_DURATION_TICKS(duration);
+    if(report->deadline <= now)
+    {
+        /* A shorter duration that has already elapsed */
+        TIMER_WHEEL_Stop(&report->timer);
+        report->isDue = true;
+    }
+    else
+    {
+        TIMER_WHEEL_StartAt(&report->timer, report->deadline,
+                _HID_IDLE_Expired, (uintptr_t)report);
+    }
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Idle Rate Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void HID_IDLE_Initialize ( HID_IDLE * idle )
+{
+    unsigned int index;
+
+    for(index = 0; index < idle->count; index ++)
+    {
+        TIMER_WHEEL_Stop(&idle->report[index].timer);
+    }
+    idle->count = 0;
+}
+
+int HID_IDLE_Register ( HID_IDLE * idle, uint8_t reportID )
+{
+    HID_IDLE_REPORT * report;
+
+    if(idle->count >= HID_IDLE_REPORTS)
+    {
+        return HID_IDLE_NONE;
+    }
+
+    report = &idle->report[idle->count];
+    report->reportID = reportID;
+    report->duration = HID_IDLE_DURATION_DEFAULT;
+    report->isDue = false;
+    report->sentTime = 0;
+    report->deadline = 0;
+    TIMER_WHEEL_Stop(&report->timer);
+
+    return idle->count ++;
+}
+
+void HID_IDLE_Reset ( HID_IDLE * idle )
+{
+    unsigned int index;
+
+    for(index = 0; index < idle->count; index ++)
+    {
+        idle->report[index].duration = HID_IDLE_DURATION_DEFAULT;
+    }
+}
+
+bool HID_IDLE_DurationSet ( HID_IDLE * idle, uint8_t reportID,
+                            uint8_t duration )
+{
+    bool isFound = false;
+    unsigned int index;
+
+    for(index = 0; index < idle->count; index ++)
+    {
+        if(_HID_IDLE_Matches(&idle->report[index], reportID))
+        {
+            idle->report[index].duration = duration;
+            isFound = true;
+        }
+    }
+    return isFound;
+}
+
+bool HID_IDLE_DurationGet ( const HID_IDLE * idle, uint8_t reportID,
+                            uint8_t * duration )
+{
+    unsigned int index;
+
+    for(index = 0; index < idle->count; index ++)
+    {
+        if(_HID_IDLE_Matches(&idle->report[index], reportID))
+        {
+            *duration = idle->report[index].duration;
+            return true;
+        }
+    }
+    return false;
+}
+
+void HID_IDLE_Start ( HID_IDLE * idle )
+{
+    uint64_t now = TIMEBASE_TicksGet();
+    unsigned int index;
+
+    for(index = 0; index < idle->count; index ++)
+    {
+        idle->report[index].isDue = false;
+        idle->report[index].sentTime = now;
+        _HID_IDLE_Schedule(&idle->report[index], now);
+    }
+}
+
+void HID_IDLE_Update ( HID_IDLE * idle, uint8_t reportID )
+{
+    uint64_t now = TIMEBASE_TicksGet();
+    HID_IDLE_REPORT * report;
+    unsigned int index;
+
+    for(index = 0; index < idle->count; index ++)
+    {
+        report = &idle->report[index];
+        if(!_HID_IDLE_Matches(report, reportID))
+        {
+            continue;
+        }
+
+        /* A period that has ended, or ends within 4 ms, still sends its
+           report. A finite duration then counts from that report on. */
+        if((report->duration != 0) &&
+           (report->isDue ||
+            (TIMER_WHEEL_IsActive(&report->timer) &&
+             ((report->deadline - now) < HID_IDLE_DURATION_TICKS(1)))))
+        {
+            continue;
+        }
+
+        _HID_IDLE_Schedule(report, now);
+    }
+}
+
+void HID_IDLE_ReportSent ( HID_IDLE * idle, int report )
+{
+    uint64_t now = TIMEBASE_TicksGet();
+
+    idle->report[report].isDue = false;
+    idle->report[report].sentTime = now;
+    _HID_IDLE_Schedule(&idle->report[report], now);
+}
+
+bool HID_IDLE_IsDue ( const HID_IDLE * idle, int report )
+{
+    return idle->report[report].isDue;
+}
+
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,260 @@
+/*******************************************************************************
+  HID Idle Rate Header File
+
+  File Name:
+    hid_idle.h
+
+  Summary:
+    Keeps the idle rate of each input report and tells when a report has
+    to be repeated.
+
+  Description:
+    The host sets an idle duration per input report with SET_IDLE, in units
+    of 4 ms, or for all of them at once with report ID 0.  While a report's
+    duration is 0 (infinite) it is only sent when its contents change.
+    Otherwise it is also sent again, unchanged, once the duration has
+    elapsed since it was last sent.
+
+    Each input report the device sends is registered once.  The deadline of
+    every report with a finite duration is a timer on the timer wheel, so
+    nothing is polled; when it expires the report is marked due until the
+    application sends it.  The rule of the HID specification for a duration
+    that changes while a period runs is kept: the new duration counts from
+    the last report, unless the current period ends within 4 ms, in which
+    case it applies from the next report on.
+
+    SET_IDLE and GET_IDLE arrive in the USB interrupt.  The durations are
+    single bytes that HID_IDLE_Reset(), HID_IDLE_DurationSet() and
+    HID_IDLE_DurationGet() can access from there; everything that touches
+    the timers runs in task context, after HID_IDLE_Update() has been called
+    for the change.
+*******************************************************************************/
+
+#ifndef _HID_IDLE_H
+#define _HID_IDLE_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "system_config.h"
+#include "timer_wheel.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants and Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Input reports that can be registered */
+#ifndef HID_IDLE_REPORTS
+#define HID_IDLE_REPORTS            1
+#endif
+
+/* Duration after a reset, in 4 ms units. The HID specification recommends
+   0 (infinite) for mice. */
+#ifndef HID_IDLE_DURATION_DEFAULT
+#define HID_IDLE_DURATION_DEFAULT   0
+#endif
+
+/* Timebase ticks of a duration */
+#define HID_IDLE_DURATION_TICKS(duration)   TIMEBASE_MS_TO_TICKS((duration) * 4)
+
+/* No report */
+#define HID_IDLE_NONE               (-1)
+
+// *****************************************************************************
+/* Idle State of One Input Report
+
+  Remarks:
+    The members are private to the idle rate functions.
+*/
+
+typedef struct
+{
+    /* Report ID, 0 if the device does not use report IDs */
+    uint8_t reportID;
+
+    /* Idle duration in 4 ms units, 0 is infinite */
+    volatile uint8_t duration;
+
+    /* The idle period has elapsed and the report has not been sent since */
+    bool isDue;
+
+    /* Timebase ticks when the report was last sent, and when the period
+       running now ends */
+    uint64_t sentTime;
+    uint64_t deadline;
+
+    /* Expires at the deadline while the duration is finite */
+    TIMER_WHEEL_TIMER timer;
+
+} HID_IDLE_REPORT;
+
+// *****************************************************************************
+/* Idle State of All Input Reports
+
+  Remarks:
+    The members are private to the idle rate functions.
+*/
+
+typedef struct
+{
+    HID_IDLE_REPORT report[HID_IDLE_REPORTS];
+
+    /* Registered reports */
+    uint8_t count;
+
+} HID_IDLE;
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Idle Rate Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void HID_IDLE_Initialize ( HID_IDLE * idle )
+
+  Summary:
+    Forgets all registered reports.
+*/
+
+void HID_IDLE_Initialize ( HID_IDLE * idle );
+
+/*******************************************************************************
+  Function:
+    int HID_IDLE_Register ( HID_IDLE * idle, uint8_t reportID )
+
+  Summary:
+    Adds an input report, with the default duration.
+
+  Returns:
+    The handle to pass to HID_IDLE_ReportSent() and HID_IDLE_IsDue(), or
+    HID_IDLE_NONE if HID_IDLE_REPORTS reports are registered already.
+*/
+
+int HID_IDLE_Register ( HID_IDLE * idle, uint8_t reportID );
+
+/*******************************************************************************
+  Function:
+    void HID_IDLE_Reset ( HID_IDLE * idle )
+
+  Summary:
+    Sets every duration back to the default.
+
+  Remarks:
+    For a bus reset or deconfiguration.  May be called from the USB
+    interrupt.  HID_IDLE_Start() brings the timers in line when the device
+    is configured again.
+*/
+
+void HID_IDLE_Reset ( HID_IDLE * idle );
+
+/*******************************************************************************
+  Function:
+    bool HID_IDLE_DurationSet ( HID_IDLE * idle, uint8_t reportID,
+                                uint8_t duration )
+
+  Summary:
+    Stores the duration of a SET_IDLE request.
+
+  Description:
+    Report ID 0 sets the duration of all reports.  Call HID_IDLE_Update()
+    with the same report ID afterwards, from task context.
+
+  Returns:
+    false if no such report is registered; the request should be stalled.
+
+  Remarks:
+    May be called from the USB interrupt.
+*/
+
+bool HID_IDLE_DurationSet ( HID_IDLE * idle, uint8_t reportID,
+                            uint8_t duration );
+
+/*******************************************************************************
+  Function:
+    bool HID_IDLE_DurationGet ( const HID_IDLE * idle, uint8_t reportID,
+                                uint8_t * duration )
+
+  Summary:
+    Looks up the duration for a GET_IDLE request.
+
+  Description:
+    Report ID 0 stands for the first registered report.
+
+  Returns:
+    false if no such report is registered; the request should be stalled.
+
+  Remarks:
+    May be called from the USB interrupt.
+*/
+
+bool HID_IDLE_DurationGet ( const HID_IDLE * idle, uint8_t reportID,
+                            uint8_t * duration );
+
+/*******************************************************************************
+  Function:
+    void HID_IDLE_Start ( HID_IDLE * idle )
+
+  Summary:
+    Starts the idle period of every report now.
+
+  Remarks:
+    For when the device is configured, before the first report is sent.
+    Task context only.
+*/
+
+void HID_IDLE_Start ( HID_IDLE * idle );
+
+/*******************************************************************************
+  Function:
+    void HID_IDLE_Update ( HID_IDLE * idle, uint8_t reportID )
+
+  Summary:
+    Reschedules the reports whose duration HID_IDLE_DurationSet() changed.
+
+  Remarks:
+    Task context only.
+*/
+
+void HID_IDLE_Update ( HID_IDLE * idle, uint8_t reportID );
+
+/*******************************************************************************
+  Function:
+    void HID_IDLE_ReportSent ( HID_IDLE * idle, int report )
+
+  Summary:
+    Starts a new idle period for a report that has just been sent.
+
+  Remarks:
+    Call whenever the report is handed to the HID function driver, whether
+    it changed or repeats the last one.  Task context only.
+*/
+
+void HID_IDLE_ReportSent ( HID_IDLE * idle, int report );
+
+/*******************************************************************************
+  Function:
+    bool HID_IDLE_IsDue ( const HID_IDLE * idle, int report )
+
+  Summary:
+    Returns true if the report has to be sent again although it has not
+    changed.
+*/
+
+bool HID_IDLE_IsDue ( const HID_IDLE * idle, int report );
+
+#endif /* _HID_IDLE_H */
+/*******************************************************************************
+ End of File
+ */
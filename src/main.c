@@ -59,6 +59,7 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 #include <stdbool.h>                    // Defines true
 #include <stdlib.h>                     // Defines EXIT_FAILURE
 #include "system/common/sys_module.h"   // SYS function prototypes
+#include "run_loop.h"                   // RUN_LOOP_Idle
 ///#include "accel.h"
 
 // *****************************************************************************
@@ -77,6 +78,9 @@ int main ( void )
         /* Maintain state machines of all polled MPLAB Harmony modules. */
         SYS_Tasks ( );
 
+        /* Sleep until an interrupt posts more work. Returns at once when
+           the run loop is configured to poll. */
+        RUN_LOOP_Idle ( );
     }
 
     /* Execution should not come here during normal operation */
@@ -0,0 +1,134 @@
+/*******************************************************************************
+  Motion Accumulator Source File
+
+  File Name:
+    motion.c
+
+  Summary:
+    Collects relative pointer movement between mouse reports.
+
+  Description:
+    See motion.h.
+*******************************************************************************/
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "motion.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static int32_t _MOTION_Saturate ( int32_t value, int32_t min, int32_t max )
+{
+    if(value < min)
+    {
+        return min;
+    }
+    if(value > max)
+    {
+        return max;
+    }
+    return value;
+}
+
+static int32_t _MOTION_AxisAdd ( MOTION_ACCUMULATOR * motion, int32_t total, int32_t delta )
+{
+    int64_t sum = (int64_t)total + delta;
+    int64_t lost = 0;
+
+    if(sum > MOTION_ACCUMULATOR_LIMIT)
+    {
+        lost = sum - MOTION_ACCUMULATOR_LIMIT;
+        sum = MOTION_ACCUMULATOR_LIMIT;
+    }
+    else if(sum < -MOTION_ACCUMULATOR_LIMIT)
+    {
+        lost = -MOTION_ACCUMULATOR_LIMIT - sum;
+        sum = -MOTION_ACCUMULATOR_LIMIT;
+    }
+
+    if(lost != 0)
+    {
+        lost = (lost + MOTION_ONE - 1) >> MOTION_FRACTION_BITS;
+        motion->saturated = (lost >= (int64_t)(UINT32_MAX - motion->saturated)) ?
+                UINT32_MAX : motion->saturated + (uint32_t)lost;
+    }
+    return (int32_t)sum;
+}
+
+/* Takes whole counts, clamped to min..max, for one report */
+static bool _MOTION_Take ( MOTION_ACCUMULATOR * motion, int32_t min, int32_t max,
+                           MOUSE_COORDINATE * x, MOUSE_COORDINATE * y )
+{
+    /* Division rounds toward zero */
+    int32_t dx = _MOTION_Saturate(motion->x / MOTION_ONE, min, max);
+    int32_t dy = _MOTION_Saturate(motion->y / MOTION_ONE, min, max);
+
+    /* Whatever did not fit, fractions included, is carried over to the
+     * next report */
+    motion->x -= dx * MOTION_ONE;
+    motion->y -= dy * MOTION_ONE;
+
+    *x = (MOUSE_COORDINATE)dx;
+    *y = (MOUSE_COORDINATE)dy;
+
+    return ((dx != 0) || (dy != 0));
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Motion Accumulator Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void MOTION_Initialize ( MOTION_ACCUMULATOR * motion )
+{
+    MOTION_Clear(motion);
+    motion->saturated = 0;
+}
+
+void MOTION_Clear ( MOTION_ACCUMULATOR * motion )
+{
+    motion->x = 0;
+    motion->y = 0;
+}
+
+void MOTION_Add ( MOTION_ACCUMULATOR * motion, int32_t dx, int32_t dy )
+{
+    motion->x = _MOTION_AxisAdd(motion, motion->x, dx);
+    motion->y = _MOTION_AxisAdd(motion, motion->y, dy);
+}
+
+bool MOTION_Take ( MOTION_ACCUMULATOR * motion,
+                   MOUSE_COORDINATE * x, MOUSE_COORDINATE * y )
+{
+    return _MOTION_Take(motion, MOUSE_COORDINATE_MIN, MOUSE_COORDINATE_MAX, x, y);
+}
+
+bool MOTION_TakeBoot ( MOTION_ACCUMULATOR * motion,
+                       MOUSE_COORDINATE * x, MOUSE_COORDINATE * y )
+{
+    return _MOTION_Take(motion, MOUSE_BOOT_COORDINATE_MIN,
+                        MOUSE_BOOT_COORDINATE_MAX, x, y);
+}
+
+bool MOTION_IsPending ( const MOTION_ACCUMULATOR * motion )
+{
+    return ((motion->x >= MOTION_ONE) || (motion->x <= -MOTION_ONE) ||
+            (motion->y >= MOTION_ONE) || (motion->y <= -MOTION_ONE));
+}
+
+
+/*******************************************************************************
+ End of File
+ */
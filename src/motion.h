@@ -0,0 +1,175 @@
+/*******************************************************************************
+  Motion Accumulator Header File
+
+  File Name:
+    motion.h
+
+  Summary:
+    Collects relative pointer movement between mouse reports.
+
+  Description:
+    Motion is produced at its own pace (once per USB frame, per sensor sample,
+    ...) while reports can only be sent when the HID endpoint is free.  The
+    accumulator sums every delta that is added and hands it out the next time
+    a report is built, so movement produced while a report is in flight is
+    delayed rather than lost.  Movement beyond what one report can carry is
+    sent in the largest report possible and the rest is carried over to the
+    following reports.
+
+    Movement is added in fractions of a count, Q8.8.  Reports only carry
+    whole counts, and the fraction left over is carried over like the rest,
+    so slow motion that adds less than one count per report still reaches
+    the host and the total sent always follows the total added.
+*******************************************************************************/
+
+#ifndef _MOTION_H
+#define _MOTION_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "mouse.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Fraction bits of the movement added and of the totals */
+#define MOTION_FRACTION_BITS        8
+#define MOTION_ONE                  (1 << MOTION_FRACTION_BITS)
+
+// *****************************************************************************
+/* Motion Accumulator
+
+  Summary:
+    Movement added but not yet reported, per axis.
+
+  Remarks:
+    The totals saturate at +/- MOTION_ACCUMULATOR_LIMIT so that a host that
+    stops polling cannot make them wrap around.  What saturation cuts off is
+    counted in saturated.
+*/
+
+typedef struct
+{
+    /* Q8.8 counts */
+    int32_t x;
+    int32_t y;
+
+    /* Counts lost to saturation on either axis, rounded up, itself
+       saturating */
+    uint32_t saturated;
+
+} MOTION_ACCUMULATOR;
+
+#define MOTION_ACCUMULATOR_LIMIT    0x3FFFFFFF
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Motion Accumulator Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void MOTION_Initialize ( MOTION_ACCUMULATOR * motion )
+
+  Summary:
+    Empties the accumulator and its saturation count.
+*/
+
+void MOTION_Initialize ( MOTION_ACCUMULATOR * motion );
+
+/*******************************************************************************
+  Function:
+    void MOTION_Clear ( MOTION_ACCUMULATOR * motion )
+
+  Summary:
+    Discards all pending movement, fractions included.
+
+  Remarks:
+    The saturation count is kept.
+*/
+
+void MOTION_Clear ( MOTION_ACCUMULATOR * motion );
+
+/*******************************************************************************
+  Function:
+    void MOTION_Add ( MOTION_ACCUMULATOR * motion, int32_t dx, int32_t dy )
+
+  Summary:
+    Adds a relative movement to the pending totals.
+
+  Remarks:
+    dx and dy are Q8.8 counts.
+*/
+
+void MOTION_Add ( MOTION_ACCUMULATOR * motion, int32_t dx, int32_t dy );
+
+/*******************************************************************************
+  Function:
+    bool MOTION_Take ( MOTION_ACCUMULATOR * motion,
+                       MOUSE_COORDINATE * x, MOUSE_COORDINATE * y )
+
+  Summary:
+    Removes as much pending movement as one report can carry.
+
+  Description:
+    Each axis is rounded toward zero to whole counts, clamped to
+    MOUSE_COORDINATE_MIN..MOUSE_COORDINATE_MAX and only the amount returned
+    is subtracted from the totals.  The fraction that stays behind has the
+    sign of the movement, so when the movement reverses it is cancelled
+    first instead of being sent as a step backwards.
+
+  Returns:
+    true if x or y is not zero.
+
+  Remarks:
+    Call once per report that is actually sent, so that nothing is taken for
+    a report that never reaches the host.
+*/
+
+bool MOTION_Take ( MOTION_ACCUMULATOR * motion,
+                   MOUSE_COORDINATE * x, MOUSE_COORDINATE * y );
+
+/*******************************************************************************
+  Function:
+    bool MOTION_TakeBoot ( MOTION_ACCUMULATOR * motion,
+                           MOUSE_COORDINATE * x, MOUSE_COORDINATE * y )
+
+  Summary:
+    Like MOTION_Take(), for a boot protocol report.
+
+  Description:
+    Each axis is clamped to MOUSE_BOOT_COORDINATE_MIN..
+    MOUSE_BOOT_COORDINATE_MAX instead.
+*/
+
+bool MOTION_TakeBoot ( MOTION_ACCUMULATOR * motion,
+                       MOUSE_COORDINATE * x, MOUSE_COORDINATE * y );
+
+/*******************************************************************************
+  Function:
+    bool MOTION_IsPending ( const MOTION_ACCUMULATOR * motion )
+
+  Summary:
+    Returns true while there is at least one whole count that has not been
+    taken.
+*/
+
+bool MOTION_IsPending ( const MOTION_ACCUMULATOR * motion );
+
+#endif /* _MOTION_H */
+/*******************************************************************************
+ End of File
+ */
@@ -39,6 +39,19 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 
 #include "mouse.h"
 
+/* Writes one axis value as MOUSE_AXIS_BYTES little endian bytes. The byte
+ * count is a compile time constant, so this unrolls to plain stores. */
+static inline void _MOUSE_AxisPack(uint8_t * data, MOUSE_COORDINATE value)
+{
+    uint32_t bits = (uint32_t)(int32_t)value;
+    int index;
+
+    for (index = 0; index < MOUSE_AXIS_BYTES; index ++)
+    {
+        data[index] = (uint8_t)(bits >> (8 * index));
+    }
+}
+
 // *****************************************************************************
 /* Function:
     void MOUSE_ReportCreate
@@ -126,22 +139,72 @@ void MOUSE_ReportCreate
     MOUSE_REPORT * mouseReport
 )
 {
+    uint8_t * data = &mouseReport->data[MOUSE_REPORT_ID_BYTES];
     int index;
 
-    /* Initialize the mouse buttons byte */
-    mouseReport->data[0] = 0;
+#if MOUSE_REPORT_ID != 0
+    mouseReport->data[0] = MOUSE_REPORT_ID;
+#endif
+
+    /* Initialize the mouse buttons bytes, padding included */
+    for (index = 0; index < MOUSE_BUTTON_BYTES; index ++)
+    {
+        data[index] = 0;
+    }
 
     for (index = 0; index < MOUSE_BUTTON_NUMBERS; index ++)
     {
-        /* Create the mouse button bit map */
-        mouseReport->data[0] |= buttonArray[index];
+        /* Create the mouse button bit map, button 1 in bit 0 */
+        if(buttonArray[index] == MOUSE_BUTTON_STATE_PRESSED)
+        {
+            data[index / 8] |= (uint8_t)(1 << (index % 8));
+        }
     }
 
     /* Update the x and y co-ordinate */
-	mouseReport->data[1] = x;
-	mouseReport->data[2] = y;
+    _MOUSE_AxisPack(&data[MOUSE_BUTTON_BYTES], x);
+    _MOUSE_AxisPack(&data[MOUSE_BUTTON_BYTES + MOUSE_AXIS_BYTES], y);
 
 	return;	
 }
 
+// *****************************************************************************
+/* Function:
+    void MOUSE_ReportBootCreate
+    (
+        MOUSE_COORDINATE x,
+        MOUSE_COORDINATE y,
+        MOUSE_BUTTON_STATE * buttonArray,
+        MOUSE_BOOT_REPORT * mouseReport
+    )
+
+  Remarks:
+    See prototype in mouse.h.
+*/
+
+void MOUSE_ReportBootCreate
+(
+    MOUSE_COORDINATE x,
+    MOUSE_COORDINATE y,
+    MOUSE_BUTTON_STATE * buttonArray,
+    MOUSE_BOOT_REPORT * mouseReport
+)
+{
+    uint8_t buttons = 0;
+    int index;
+
+    for (index = 0; (index < MOUSE_BUTTON_NUMBERS) &&
+                    (index < MOUSE_BOOT_BUTTON_NUMBERS); index ++)
+    {
+        if(buttonArray[index] == MOUSE_BUTTON_STATE_PRESSED)
+        {
+            buttons |= (uint8_t)(1 << index);
+        }
+    }
+
+    mouseReport->data[0] = buttons;
+    mouseReport->data[1] = (uint8_t)x;
+    mouseReport->data[2] = (uint8_t)y;
+}
+
 
@@ -58,18 +58,49 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 // *****************************************************************************
 
 // *****************************************************************************
-/* Number of Mouse Buttons.
+/* Mouse Report Schema.
 
   Summary:
-    Number of Mouse Buttons.
+    The one place where the layout of the mouse report is defined.
 
   Description:
-    Number of Mouse Buttons.
+    The report is an optional report ID byte, then MOUSE_BUTTON_NUMBERS
+    button bits, padded to a whole byte,
+    followed by X and Y as MOUSE_AXIS_BITS wide two's complement values,
+    little endian.  The report descriptor (MOUSE_REPORT_DESCRIPTOR), the
+    report size, the coordinate type and range and the packing done by
+    MOUSE_ReportCreate() are all derived from the definitions below, so
+    changing them cannot leave the descriptor and the reports out of step.
 
   Remarks:
-    None.
+    MOUSE_AXIS_BITS is 16 when the system configuration sets
+    MOUSE_HIGH_RESOLUTION to true, 8 otherwise.  The report carries
+    MOUSE_REPORT_ID only when the system configuration sets it, which it
+    must as soon as the report descriptor holds any other report.
 */
-#define MOUSE_BUTTON_NUMBERS 2
+
+#ifndef MOUSE_REPORT_ID
+#define MOUSE_REPORT_ID 0
+#endif
+
+#define MOUSE_BUTTON_NUMBERS 3
+
+#if MOUSE_HIGH_RESOLUTION
+#define MOUSE_AXIS_BITS 16
+#else
+#define MOUSE_AXIS_BITS 8
+#endif
+
+/* X and Y */
+#define MOUSE_AXIS_NUMBERS 2
+
+/* Derived from the schema */
+#define MOUSE_REPORT_ID_BYTES   ((MOUSE_REPORT_ID != 0) ? 1 : 0)
+#define MOUSE_BUTTON_BYTES      ((MOUSE_BUTTON_NUMBERS + 7) / 8)
+#define MOUSE_BUTTON_PADDING    (MOUSE_BUTTON_BYTES * 8 - MOUSE_BUTTON_NUMBERS)
+#define MOUSE_AXIS_BYTES        (MOUSE_AXIS_BITS / 8)
+#define MOUSE_REPORT_SIZE       (MOUSE_REPORT_ID_BYTES + MOUSE_BUTTON_BYTES + \
+                                 MOUSE_AXIS_NUMBERS * MOUSE_AXIS_BYTES)
 
 // *****************************************************************************
 /* Mouse Coordinate.
@@ -81,10 +112,97 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
     This type defines the  Mouse Coordinate data type.
     
   Remarks:
-    None.
+    Wide enough for MOUSE_AXIS_BITS.
 */
 
+#if MOUSE_AXIS_BITS > 8
+typedef int16_t MOUSE_COORDINATE;
+#else
 typedef int8_t MOUSE_COORDINATE; 
+#endif
+
+// *****************************************************************************
+/* Mouse Coordinate Range.
+
+  Summary:
+    Smallest and largest relative movement one report can carry.
+
+  Remarks:
+    Symmetric, as declared by the Logical Minimum and Logical Maximum of the
+    X and Y axes in MOUSE_REPORT_DESCRIPTOR.
+*/
+
+#define MOUSE_COORDINATE_MAX    ((1 << (MOUSE_AXIS_BITS - 1)) - 1)
+#define MOUSE_COORDINATE_MIN    (-MOUSE_COORDINATE_MAX)
+
+// *****************************************************************************
+/* Mouse Report Descriptor.
+
+  Summary:
+    Report descriptor bytes generated from the report schema.
+
+  Description:
+    Expands to a comma separated list of bytes, for use as the initializer
+    of the HID report descriptor array of the system configuration (hid_rpt0).
+    The descriptor length is then simply sizeof(hid_rpt0).
+*/
+
+#define _MOUSE_HID_ITEM_1(prefix, value)                                      \
+    ((prefix) | 1), (uint8_t)(value)
+#define _MOUSE_HID_ITEM_2(prefix, value)                                      \
+    ((prefix) | 2), (uint8_t)(value), (uint8_t)((uint16_t)(value) >> 8)
+
+#if MOUSE_REPORT_ID != 0
+#define _MOUSE_REPORT_ID_ITEMS                                                \
+    0x85, MOUSE_REPORT_ID,      /*   Report ID                       */
+#else
+#define _MOUSE_REPORT_ID_ITEMS
+#endif
+
+#if MOUSE_BUTTON_PADDING > 0
+#define _MOUSE_BUTTON_PADDING_ITEMS                                           \
+    0x95, 0x01,                 /* Report Count (1)                  */       \
+    0x75, MOUSE_BUTTON_PADDING, /* Report Size (padding)             */       \
+    0x81, 0x01,                 /* Input (Constant)                  */
+#else
+#define _MOUSE_BUTTON_PADDING_ITEMS
+#endif
+
+#if MOUSE_AXIS_BITS > 8
+#define _MOUSE_AXIS_LOGICAL_ITEMS                                             \
+    _MOUSE_HID_ITEM_2(0x14, MOUSE_COORDINATE_MIN), /* Logical Minimum */      \
+    _MOUSE_HID_ITEM_2(0x24, MOUSE_COORDINATE_MAX), /* Logical Maximum */
+#else
+#define _MOUSE_AXIS_LOGICAL_ITEMS                                             \
+    _MOUSE_HID_ITEM_1(0x14, MOUSE_COORDINATE_MIN), /* Logical Minimum */      \
+    _MOUSE_HID_ITEM_1(0x24, MOUSE_COORDINATE_MAX), /* Logical Maximum */
+#endif
+
+#define MOUSE_REPORT_DESCRIPTOR                                               \
+    0x05, 0x01,                 /* Usage Page (Generic Desktop)      */       \
+    0x09, 0x02,                 /* Usage (Mouse)                     */       \
+    0xA1, 0x01,                 /* Collection (Application)          */       \
+    _MOUSE_REPORT_ID_ITEMS                                                    \
+    0x09, 0x01,                 /*   Usage (Pointer)                 */       \
+    0xA1, 0x00,                 /*   Collection (Physical)           */       \
+    0x05, 0x09,                 /*     Usage Page (Buttons)          */       \
+    0x19, 0x01,                 /*     Usage Minimum (1)             */       \
+    0x29, MOUSE_BUTTON_NUMBERS, /*     Usage Maximum                 */       \
+    0x15, 0x00,                 /*     Logical Minimum (0)           */       \
+    0x25, 0x01,                 /*     Logical Maximum (1)           */       \
+    0x95, MOUSE_BUTTON_NUMBERS, /*     Report Count                  */       \
+    0x75, 0x01,                 /*     Report Size (1)               */       \
+    0x81, 0x02,                 /*     Input (Data, Variable, Abs)   */       \
+    _MOUSE_BUTTON_PADDING_ITEMS                                               \
+    0x05, 0x01,                 /*     Usage Page (Generic Desktop)  */       \
+    0x09, 0x30,                 /*     Usage (X)                     */       \
+    0x09, 0x31,                 /*     Usage (Y)                     */       \
+    _MOUSE_AXIS_LOGICAL_ITEMS                                                 \
+    0x75, MOUSE_AXIS_BITS,      /*     Report Size                   */       \
+    0x95, MOUSE_AXIS_NUMBERS,   /*     Report Count                  */       \
+    0x81, 0x06,                 /*     Input (Data, Variable, Rel)   */       \
+    0xC0,                       /*   End Collection                  */       \
+    0xC0                        /* End Collection                    */
 
 // *****************************************************************************
 /*  Mouse Button State.
@@ -121,15 +239,44 @@ MOUSE_BUTTON_STATE;
     MOUSE_ReportCreate() function to populate this report.
     
   Remarks:
-    None.
+    Laid out as described by the report schema above.
 */
 
 typedef struct
 {
-    uint8_t data[3];
+    uint8_t data[MOUSE_REPORT_SIZE];
 }
 MOUSE_REPORT;
 
+// *****************************************************************************
+/* Boot Mouse Report
+
+  Summary:
+   Boot protocol mouse report.
+
+  Description:
+    The fixed report of HID 1.11 appendix B.2, sent instead of MOUSE_REPORT
+    while the host has selected the boot protocol: buttons 1 to 3 in bits 0
+    to 2 of the first byte, then X and Y as 8-bit two's complement values.
+    It never has a report ID.
+
+  Remarks:
+    The MOUSE_ReportBootCreate() function populates this report.
+*/
+
+#define MOUSE_BOOT_REPORT_SIZE      3
+#define MOUSE_BOOT_BUTTON_NUMBERS   3
+
+/* Relative movement one boot report can carry */
+#define MOUSE_BOOT_COORDINATE_MAX   127
+#define MOUSE_BOOT_COORDINATE_MIN   (-MOUSE_BOOT_COORDINATE_MAX)
+
+typedef struct
+{
+    uint8_t data[MOUSE_BOOT_REPORT_SIZE];
+}
+MOUSE_BOOT_REPORT;
+
 
 // *****************************************************************************
 // *****************************************************************************
@@ -224,4 +371,36 @@ void MOUSE_ReportCreate
     MOUSE_REPORT * mouseReport
 );
 
+// *****************************************************************************
+/* Function:
+    void MOUSE_ReportBootCreate
+    (
+        MOUSE_COORDINATE x,
+        MOUSE_COORDINATE y,
+        MOUSE_BUTTON_STATE * buttonArray,
+        MOUSE_BOOT_REPORT * mouseReport
+    )
+
+  Summary:
+    This function creates a boot protocol mouse report.
+
+  Description:
+    Like MOUSE_ReportCreate(), for the boot protocol.  Buttons beyond
+    MOUSE_BOOT_BUTTON_NUMBERS are left out.
+
+  Precondition:
+    x and y are within MOUSE_BOOT_COORDINATE_MIN..MOUSE_BOOT_COORDINATE_MAX.
+
+  Returns:
+    None.
+*/
+
+void MOUSE_ReportBootCreate
+(
+    MOUSE_COORDINATE x,
+    MOUSE_COORDINATE y,
+    MOUSE_BUTTON_STATE * buttonArray,
+    MOUSE_BOOT_REPORT * mouseReport
+);
+
 #endif
@@ -0,0 +1,139 @@
+/*******************************************************************************
+  Superloop Profiler Source File
+
+  File Name:
+    profiler.c
+
+  Summary:
+    Per task execution time histograms for the calls made by SYS_Tasks().
+*******************************************************************************/
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "profiler.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#if PROFILER_ENABLE
+/* One histogram per task. Zero at reset. */
+static PROFILER_HISTOGRAM profilerTasks[PROFILER_TASKS];
+#endif
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void _PROFILER_Pack32 ( uint8_t * buffer, uint32_t value )
+{
+    buffer[0] = (uint8_t)value;
+    buffer[1] = (uint8_t)(value >> 8);
+    buffer[2] = (uint8_t)(value >> 16);
+    buffer[3] = (uint8_t)(value >> 24);
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Histogram Functions
+// *****************************************************************************
+// *****************************************************************************
+
+unsigned int PROFILER_BinGet ( uint32_t ticks )
+{
+    unsigned int bin;
+
+    if(ticks < 2)
+    {
+        return 0;
+    }
+
+    /* Index of the highest set bit, a single clz on the PIC32 */
+    bin = 31 - __builtin_clz(ticks);
+
+    return (bin < PROFILER_BINS) ? bin : (PROFILER_BINS - 1);
+}
+
+void PROFILER_HistogramClear ( PROFILER_HISTOGRAM * histogram )
+{
+    unsigned int bin;
+
+    histogram->max = 0;
+    for(bin = 0; bin < PROFILER_BINS; bin ++)
+    {
+        histogram->bins[bin] = 0;
+    }
+}
+
+void PROFILER_HistogramAdd ( PROFILER_HISTOGRAM * histogram, uint32_t ticks )
+{
+    uint32_t * count = &histogram->bins[PROFILER_BinGet(ticks)];
+
+    if(*count != UINT32_MAX)
+    {
+        (*count) ++;
+    }
+    if(ticks > histogram->max)
+    {
+        histogram->max = ticks;
+    }
+}
+
+void PROFILER_HistogramPack ( const PROFILER_HISTOGRAM * histogram, uint8_t * buffer )
+{
+    unsigned int bin;
+
+    _PROFILER_Pack32(buffer, histogram->max);
+    for(bin = 0; bin < PROFILER_BINS; bin ++)
+    {
+        _PROFILER_Pack32(&buffer[4 * (1 + bin)], histogram->bins[bin]);
+    }
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Profiler Functions
+// *****************************************************************************
+// *****************************************************************************
+
+#if PROFILER_ENABLE
+void PROFILER_Record ( PROFILER_TASK task, uint32_t ticks )
+{
+    PROFILER_HistogramAdd(&profilerTasks[task], ticks);
+}
+
+void PROFILER_ReportGet ( uint8_t * report )
+{
+    unsigned int task;
+
+    report[0] = PROFILER_REPORT_ID;
+    report[1] = PROFILER_REPORT_FORMAT;
+    report[2] = PROFILER_TASKS;
+    report[3] = PROFILER_BINS;
+    report[4] = 0;
+
+    for(task = 0; task < PROFILER_TASKS; task ++)
+    {
+        PROFILER_HistogramPack(&profilerTasks[task],
+                &report[5 + task * PROFILER_HISTOGRAM_BYTES]);
+    }
+}
+#endif
+
+
+/*******************************************************************************
+ End of File
+ */
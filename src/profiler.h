@@ -0,0 +1,228 @@
+/*******************************************************************************
+  Superloop Profiler Header File
+
+  File Name:
+    profiler.h
+
+  Summary:
+    Per task execution time histograms for the calls made by SYS_Tasks().
+
+  Description:
+    SYS_Tasks() wraps each call in PROFILER_MEASURE(), which reads the core
+    timer before and after it and files the difference in that task's
+    histogram.  Bin n counts calls that took 2^n to 2^(n+1) - 1 core timer
+    ticks (bin 0 also takes 0 ticks, the last bin takes everything above),
+    and the longest call is kept alongside.  The host reads all of it as a
+    vendor defined feature report in a top-level collection of its own.
+
+    Everything compiles away unless the system configuration sets
+    PROFILER_ENABLE to true.  The histogram functions do not touch the
+    hardware, so they build for the host as well.
+*******************************************************************************/
+
+#ifndef _PROFILER_H
+#define _PROFILER_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "system_config.h"
+#include "timebase.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants and Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#ifndef PROFILER_ENABLE
+#define PROFILER_ENABLE             false
+#endif
+
+/* Histogram bins. The last one starts at 2^15 ticks, 819 us at 80 MHz. */
+#define PROFILER_BINS               16
+
+// *****************************************************************************
+/* Profiled Tasks
+
+  Remarks:
+    The order is the order of the histograms in the feature report.
+*/
+
+typedef enum
+{
+    PROFILER_TASK_DEVCON = 0,
+
+    PROFILER_TASK_TIMER_WHEEL,
+
+    PROFILER_TASK_USB_DEVICE,
+
+    PROFILER_TASK_APP,
+
+    /* Number of profiled tasks */
+    PROFILER_TASKS
+
+} PROFILER_TASK;
+
+// *****************************************************************************
+/* Execution Time Histogram
+
+  Remarks:
+    Counts saturate instead of wrapping.
+*/
+
+typedef struct
+{
+    /* Longest call in core timer ticks */
+    uint32_t max;
+
+    /* Calls per log2 bin */
+    uint32_t bins[PROFILER_BINS];
+
+} PROFILER_HISTOGRAM;
+
+/* Packed size of one histogram: max, then the bins, little endian */
+#define PROFILER_HISTOGRAM_BYTES    (4 * (1 + PROFILER_BINS))
+
+// *****************************************************************************
+/* Profiler Feature Report
+
+  Description:
+    Report ID, then a format byte (1), the number of tasks, the number of
+    bins, one reserved byte, and the packed histogram of each task.
+*/
+
+#define PROFILER_REPORT_FORMAT      1
+#define PROFILER_REPORT_SIZE        (1 + 4 + PROFILER_TASKS * PROFILER_HISTOGRAM_BYTES)
+
+/* A top-level collection of its own, so that the host can open it while the
+   operating system owns the mouse. */
+#define PROFILER_REPORT_DESCRIPTOR                                            \
+    0x06, 0x00, 0xFF,           /* Usage Page (Vendor Defined FF00)  */       \
+    0x09, 0x01,                 /* Usage (1)                         */       \
+    0xA1, 0x01,                 /* Collection (Application)          */       \
+    0x85, PROFILER_REPORT_ID,   /*   Report ID                       */       \
+    0x09, 0x02,                 /*   Usage (2)                       */       \
+    0x15, 0x00,                 /*   Logical Minimum (0)             */       \
+    0x26, 0xFF, 0x00,           /*   Logical Maximum (255)           */       \
+    0x75, 0x08,                 /*   Report Size (8)                 */       \
+    0x96, (uint8_t)(PROFILER_REPORT_SIZE - 1),                                \
+          (uint8_t)((PROFILER_REPORT_SIZE - 1) >> 8),                         \
+                                /*   Report Count                    */       \
+    0xB1, 0x02,                 /*   Feature (Data, Variable, Abs)   */       \
+    0xC0                        /* End Collection                    */
+
+// *****************************************************************************
+/* Task Measurement
+
+  Summary:
+    Runs call and records how long it took against task.
+*/
+
+#if PROFILER_ENABLE
+#define PROFILER_MEASURE(task, call)                                          \
+    do                                                                        \
+    {                                                                         \
+        uint32_t _profilerStart = TIMEBASE_COUNT_GET();                       \
+        call;                                                                 \
+        PROFILER_Record((task), TIMEBASE_COUNT_GET() - _profilerStart);       \
+    } while(0)
+#else
+#define PROFILER_MEASURE(task, call)    call
+#endif
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Histogram Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    unsigned int PROFILER_BinGet ( uint32_t ticks )
+
+  Summary:
+    Returns the histogram bin of a duration.
+*/
+
+unsigned int PROFILER_BinGet ( uint32_t ticks );
+
+/*******************************************************************************
+  Function:
+    void PROFILER_HistogramClear ( PROFILER_HISTOGRAM * histogram )
+
+  Summary:
+    Empties a histogram.
+*/
+
+void PROFILER_HistogramClear ( PROFILER_HISTOGRAM * histogram );
+
+/*******************************************************************************
+  Function:
+    void PROFILER_HistogramAdd ( PROFILER_HISTOGRAM * histogram, uint32_t ticks )
+
+  Summary:
+    Counts one duration.
+*/
+
+void PROFILER_HistogramAdd ( PROFILER_HISTOGRAM * histogram, uint32_t ticks );
+
+/*******************************************************************************
+  Function:
+    void PROFILER_HistogramPack ( const PROFILER_HISTOGRAM * histogram,
+                                  uint8_t * buffer )
+
+  Summary:
+    Writes PROFILER_HISTOGRAM_BYTES bytes, little endian.
+*/
+
+void PROFILER_HistogramPack ( const PROFILER_HISTOGRAM * histogram, uint8_t * buffer );
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Profiler Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void PROFILER_Record ( PROFILER_TASK task, uint32_t ticks )
+
+  Summary:
+    Counts one call of task.
+
+  Remarks:
+    Task context.  Normally called through PROFILER_MEASURE().
+*/
+
+void PROFILER_Record ( PROFILER_TASK task, uint32_t ticks );
+
+/*******************************************************************************
+  Function:
+    void PROFILER_ReportGet ( uint8_t * report )
+
+  Summary:
+    Fills in PROFILER_REPORT_SIZE bytes of feature report.
+
+  Remarks:
+    May be called from the USB interrupt.  A call recorded while the report
+    is being packed may then be missing from it, which is fine for a
+    statistic.
+*/
+
+void PROFILER_ReportGet ( uint8_t * report );
+
+#endif /* _PROFILER_H */
+/*******************************************************************************
+ End of File
+ */
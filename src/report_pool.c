@@ -0,0 +1,120 @@
+/*******************************************************************************
+  HID Report Buffer Pool Source File
+
+  File Name:
+    report_pool.c
+
+  Summary:
+    Tracks who owns each of a small set of report buffers.
+
+  Description:
+    See report_pool.h.
+*******************************************************************************/
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "report_pool.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Report Buffer Pool Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void REPORT_POOL_Initialize ( REPORT_POOL * pool )
+{
+    int index;
+
+    for(index = 0; index < REPORT_POOL_BUFFERS; index ++)
+    {
+        pool->state[index] = REPORT_POOL_BUFFER_FREE;
+        pool->handle[index] = USB_DEVICE_HID_TRANSFER_HANDLE_INVALID;
+    }
+    pool->submitted = 0;
+}
+
+int REPORT_POOL_Stage ( REPORT_POOL * pool )
+{
+    int index;
+
+    for(index = 0; index < REPORT_POOL_BUFFERS; index ++)
+    {
+        if(pool->state[index] == REPORT_POOL_BUFFER_FREE)
+        {
+            pool->state[index] = REPORT_POOL_BUFFER_STAGED;
+            return index;
+        }
+    }
+
+    return REPORT_POOL_NONE;
+}
+
+void REPORT_POOL_Unstage ( REPORT_POOL * pool, int index )
+{
+    if(pool->state[index] == REPORT_POOL_BUFFER_STAGED)
+    {
+        pool->state[index] = REPORT_POOL_BUFFER_FREE;
+    }
+}
+
+void REPORT_POOL_Submit ( REPORT_POOL * pool, int index,
+                          USB_DEVICE_HID_TRANSFER_HANDLE handle )
+{
+    pool->state[index] = REPORT_POOL_BUFFER_OWNED;
+    pool->handle[index] = handle;
+    pool->order[index] = pool->submitted ++;
+}
+
+int REPORT_POOL_Release ( REPORT_POOL * pool,
+                          USB_DEVICE_HID_TRANSFER_HANDLE handle )
+{
+    int oldest = REPORT_POOL_NONE;
+    int index;
+
+    /* The oldest is the one submitted the most submissions ago, which
+     * holds across the wrap of the count */
+    for(index = 0; index < REPORT_POOL_BUFFERS; index ++)
+    {
+        if((pool->state[index] == REPORT_POOL_BUFFER_OWNED) &&
+           (pool->handle[index] == handle) &&
+           ((oldest == REPORT_POOL_NONE) ||
+            ((pool->submitted - pool->order[index]) >
+             (pool->submitted - pool->order[oldest]))))
+        {
+            oldest = index;
+        }
+    }
+
+    if(oldest != REPORT_POOL_NONE)
+    {
+        pool->state[oldest] = REPORT_POOL_BUFFER_FREE;
+        pool->handle[oldest] = USB_DEVICE_HID_TRANSFER_HANDLE_INVALID;
+    }
+    return oldest;
+}
+
+unsigned int REPORT_POOL_OwnedCount ( const REPORT_POOL * pool )
+{
+    unsigned int owned = 0;
+    int index;
+
+    for(index = 0; index < REPORT_POOL_BUFFERS; index ++)
+    {
+        if(pool->state[index] == REPORT_POOL_BUFFER_OWNED)
+        {
+            owned ++;
+        }
+    }
+    return owned;
+}
+
+
+/*******************************************************************************
+ End of File
+ */
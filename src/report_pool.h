@@ -0,0 +1,198 @@
+/*******************************************************************************
+  HID Report Buffer Pool Header File
+
+  File Name:
+    report_pool.h
+
+  Summary:
+    Tracks who owns each of a small set of report buffers.
+
+  Description:
+    A buffer handed to USB_DEVICE_HID_ReportSend() belongs to the USB
+    controller until the HID function driver reports it sent, and must not
+    be written until then.  With a single buffer the next report cannot be
+    composed while the previous one is in flight.
+
+    The pool hands out the index of a free buffer to compose the next report
+    in (staged), marks it owned by the controller when it is submitted,
+    together with the transfer handle, and frees it again when the
+    USB_DEVICE_HID_EVENT_REPORT_SENT event for that handle arrives.  The
+    buffers themselves are DMA ready storage defined by the application;
+    the pool only keeps their state.
+
+    All functions are meant for the application task.  Completion events
+    are handed over from the USB interrupt through the application's event
+    queue.
+*******************************************************************************/
+
+#ifndef _REPORT_POOL_H
+#define _REPORT_POOL_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "system_config.h"
+#include "system_definitions.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants and Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Buffers per pool, one for each report that may be in flight */
+#ifndef REPORT_POOL_BUFFERS
+#define REPORT_POOL_BUFFERS         1
+#endif
+
+/* No buffer */
+#define REPORT_POOL_NONE            (-1)
+
+// *****************************************************************************
+/* Report Buffer State
+
+  Summary:
+    Who may touch a buffer.
+*/
+
+typedef enum
+{
+    /* Nobody uses it. Its contents are those of an earlier report. */
+    REPORT_POOL_BUFFER_FREE = 0,
+
+    /* The application is composing a report in it */
+    REPORT_POOL_BUFFER_STAGED,
+
+    /* Submitted. The controller owns it until the report is sent. */
+    REPORT_POOL_BUFFER_OWNED
+
+} REPORT_POOL_BUFFER_STATE;
+
+// *****************************************************************************
+/* Report Buffer Pool
+
+  Remarks:
+    The members are private to the pool functions.
+*/
+
+typedef struct
+{
+    uint8_t state[REPORT_POOL_BUFFERS];
+
+    /* Transfer handle of each owned buffer */
+    USB_DEVICE_HID_TRANSFER_HANDLE handle[REPORT_POOL_BUFFERS];
+
+    /* Value of submitted when each owned buffer was submitted */
+    uint32_t order[REPORT_POOL_BUFFERS];
+
+    /* Free running count of submissions */
+    uint32_t submitted;
+
+} REPORT_POOL;
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Report Buffer Pool Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void REPORT_POOL_Initialize ( REPORT_POOL * pool )
+
+  Summary:
+    Frees every buffer.
+
+  Remarks:
+    Also used when the device is reset or reconfigured and the transfers in
+    flight have been cancelled.
+*/
+
+void REPORT_POOL_Initialize ( REPORT_POOL * pool );
+
+/*******************************************************************************
+  Function:
+    int REPORT_POOL_Stage ( REPORT_POOL * pool )
+
+  Summary:
+    Takes a free buffer to compose the next report in.
+
+  Returns:
+    The buffer index, or REPORT_POOL_NONE if the controller owns all of
+    them.  Never returns a buffer that is owned or already staged.
+*/
+
+int REPORT_POOL_Stage ( REPORT_POOL * pool );
+
+/*******************************************************************************
+  Function:
+    void REPORT_POOL_Unstage ( REPORT_POOL * pool, int index )
+
+  Summary:
+    Returns a staged buffer that is not going to be sent.
+*/
+
+void REPORT_POOL_Unstage ( REPORT_POOL * pool, int index );
+
+/*******************************************************************************
+  Function:
+    void REPORT_POOL_Submit ( REPORT_POOL * pool, int index,
+                              USB_DEVICE_HID_TRANSFER_HANDLE handle )
+
+  Summary:
+    Hands a staged buffer to the controller.
+
+  Description:
+    Call after USB_DEVICE_HID_ReportSend() accepted the buffer.
+*/
+
+void REPORT_POOL_Submit ( REPORT_POOL * pool, int index,
+                          USB_DEVICE_HID_TRANSFER_HANDLE handle );
+
+/*******************************************************************************
+  Function:
+    int REPORT_POOL_Release ( REPORT_POOL * pool,
+                              USB_DEVICE_HID_TRANSFER_HANDLE handle )
+
+  Summary:
+    Gives back the buffer of a transfer that has completed.
+
+  Description:
+    The Harmony HID driver hands out the address of an IRP as the transfer
+    handle, and reuses an IRP as soon as it has completed.  A handle can
+    therefore belong to more than one owned buffer when a completion is
+    still queued behind a new submission.  Transfers on the endpoint
+    complete in the order they were submitted, so the buffer freed is the
+    one submitted first among those with the handle.
+
+  Returns:
+    The index of the buffer that is free again, or REPORT_POOL_NONE if no
+    owned buffer has that handle, for example because the pool was
+    initialized again after the transfer was cancelled.
+*/
+
+int REPORT_POOL_Release ( REPORT_POOL * pool,
+                          USB_DEVICE_HID_TRANSFER_HANDLE handle );
+
+/*******************************************************************************
+  Function:
+    unsigned int REPORT_POOL_OwnedCount ( const REPORT_POOL * pool )
+
+  Summary:
+    Returns the number of buffers the controller owns.
+*/
+
+unsigned int REPORT_POOL_OwnedCount ( const REPORT_POOL * pool );
+
+#endif /* _REPORT_POOL_H */
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,172 @@
+/*******************************************************************************
+  Run Loop Source File
+
+  File Name:
+    run_loop.c
+
+  Summary:
+    Sleeps the CPU between the interrupts that post work to the superloop.
+
+  Description:
+    The check for posted work and the WAIT must not be separated by an
+    interrupt, or the work it posts would wait for the next one.  Both are
+    done with interrupts disabled.  The PIC32 still leaves Idle mode on an
+    enabled interrupt source in that state, and continues after WAIT; the
+    interrupt is taken once interrupts are restored.
+*******************************************************************************/
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <xc.h>
+#include "run_loop.h"
+#include "system_definitions.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Accounting window, one second */
+#define RUN_LOOP_WINDOW_TICKS       (SYS_CLK_FREQ / 2)
+
+/* Idles the CPU until an enabled interrupt source requests service. A
+   build without the real core, such as a simulation, defines its own. */
+#ifndef RUN_LOOP_WAIT
+#define RUN_LOOP_WAIT()             __asm__ __volatile__("wait")
+#endif
+
+static struct
+{
+    /* Set by RUN_LOOP_Post(), cleared when a pass starts */
+    volatile bool pending;
+
+#if RUN_LOOP_ACCOUNTING
+    /* Window in progress */
+    RUN_LOOP_STATS current;
+    uint32_t windowStart;
+
+    /* Start of the current busy period */
+    uint32_t busyStart;
+
+    /* Last complete window */
+    RUN_LOOP_STATS stats;
+#endif
+} runLoop;
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+#if RUN_LOOP_ACCOUNTING
+/* Closes the window once it is a second long */
+static void _RUN_LOOP_WindowUpdate ( uint32_t now )
+{
+    uint32_t length = now - runLoop.windowStart;
+
+    if(length >= RUN_LOOP_WINDOW_TICKS)
+    {
+        runLoop.current.windowTicks = length;
+        runLoop.stats = runLoop.current;
+
+        runLoop.current.passes = 0;
+        runLoop.current.wakeups = 0;
+        runLoop.current.busyTicks = 0;
+        runLoop.windowStart = now;
+    }
+}
+#endif
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Run Loop Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void RUN_LOOP_Initialize ( void )
+{
+    runLoop.pending = false;
+#if RUN_LOOP_ACCOUNTING
+    runLoop.windowStart = TIMEBASE_COUNT_GET();
+    runLoop.busyStart = runLoop.windowStart;
+#endif
+}
+
+void RUN_LOOP_Post ( void )
+{
+    runLoop.pending = true;
+}
+
+void RUN_LOOP_WakeAt ( uint64_t deadline )
+{
+    if(!TIMEBASE_AlarmSet(deadline))
+    {
+        /* Already due: do not sleep at all */
+        RUN_LOOP_Post();
+    }
+}
+
+void RUN_LOOP_Idle ( void )
+{
+#if RUN_LOOP_ACCOUNTING
+    uint32_t now = TIMEBASE_COUNT_GET();
+
+    runLoop.current.passes ++;
+#endif
+
+#if RUN_LOOP_EVENT_DRIVEN
+    bool intState = SYS_INT_Disable();
+
+    if(!runLoop.pending)
+    {
+#if RUN_LOOP_ACCOUNTING
+        runLoop.current.busyTicks += now - runLoop.busyStart;
+#endif
+        RUN_LOOP_WAIT();
+#if RUN_LOOP_ACCOUNTING
+        now = TIMEBASE_COUNT_GET();
+        runLoop.busyStart = now;
+        runLoop.current.wakeups ++;
+#endif
+    }
+
+    /* The waking interrupt runs here. Whatever it and anything before it
+     * posted is handled by the pass that follows. */
+    SYS_INT_Restore(intState);
+    runLoop.pending = false;
+#elif RUN_LOOP_ACCOUNTING
+    /* Polling: the CPU is never idle */
+    runLoop.current.busyTicks += now - runLoop.busyStart;
+    runLoop.busyStart = now;
+#endif
+
+#if RUN_LOOP_ACCOUNTING
+    _RUN_LOOP_WindowUpdate(now);
+#endif
+}
+
+const RUN_LOOP_STATS * RUN_LOOP_StatsGet ( void )
+{
+#if RUN_LOOP_ACCOUNTING
+    return &runLoop.stats;
+#else
+    static const RUN_LOOP_STATS none;
+
+    return &none;
+#endif
+}
+
+
+/*******************************************************************************
+ End of File
+ */
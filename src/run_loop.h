@@ -0,0 +1,166 @@
+/*******************************************************************************
+  Run Loop Header File
+
+  File Name:
+    run_loop.h
+
+  Summary:
+    Sleeps the CPU between the interrupts that post work to the superloop.
+
+  Description:
+    Every interrupt that produces something for the task context (a USB
+    event, a finished accelerometer burst, a core timer alarm) calls
+    RUN_LOOP_Post().  After each pass of SYS_Tasks(), main() calls
+    RUN_LOOP_Idle(), which executes WAIT unless work was posted while the
+    pass was running.  The CPU then sits in Idle mode, with the peripheral
+    clocks and the USB module running, until the next interrupt.
+
+    Task code that needs to run again at a given time, without an interrupt
+    of its own, asks for a wake-up with RUN_LOOP_WakeAt().
+
+    With RUN_LOOP_EVENT_DRIVEN false the loop polls as before.  Either way
+    RUN_LOOP_ACCOUNTING counts loop passes and busy time over one second
+    windows, so both modes can be compared.
+*******************************************************************************/
+
+#ifndef _RUN_LOOP_H
+#define _RUN_LOOP_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "system_config.h"
+#include "timebase.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants and Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Configurations that do not select a run mode keep polling */
+#ifndef RUN_LOOP_EVENT_DRIVEN
+#define RUN_LOOP_EVENT_DRIVEN       false
+#endif
+
+#ifndef RUN_LOOP_ACCOUNTING
+#define RUN_LOOP_ACCOUNTING         false
+#endif
+
+// *****************************************************************************
+/* Run Loop Statistics
+
+  Summary:
+    Loop activity over the last complete one second window.
+
+  Remarks:
+    Only maintained when RUN_LOOP_ACCOUNTING is true.
+*/
+
+typedef struct
+{
+    /* Passes of SYS_Tasks() */
+    uint32_t passes;
+
+    /* Times the CPU came out of WAIT */
+    uint32_t wakeups;
+
+    /* Core timer ticks spent outside WAIT */
+    uint32_t busyTicks;
+
+    /* Length of the window in core timer ticks */
+    uint32_t windowTicks;
+
+} RUN_LOOP_STATS;
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Run Loop Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void RUN_LOOP_Initialize ( void )
+
+  Summary:
+    Starts the first accounting window, and the busy period, at the
+    current time.
+
+  Remarks:
+    Must be called from SYS_Initialize after TIMEBASE_Initialize().
+*/
+
+void RUN_LOOP_Initialize ( void );
+
+/*******************************************************************************
+  Function:
+    void RUN_LOOP_Post ( void )
+
+  Summary:
+    Makes sure SYS_Tasks() runs again before the CPU sleeps.
+
+  Remarks:
+    May be called from any context.  Costs one store.
+*/
+
+void RUN_LOOP_Post ( void );
+
+/*******************************************************************************
+  Function:
+    void RUN_LOOP_WakeAt ( uint64_t deadline )
+
+  Summary:
+    Makes sure SYS_Tasks() runs again no later than deadline.
+
+  Description:
+    The wake-up is one-shot and is shared with the other callers through
+    the core timer alarm.  Task code that is still waiting for its deadline
+    on the next pass simply asks again.
+
+  Remarks:
+    Task context.
+*/
+
+void RUN_LOOP_WakeAt ( uint64_t deadline );
+
+/*******************************************************************************
+  Function:
+    void RUN_LOOP_Idle ( void )
+
+  Summary:
+    Waits for posted work.
+
+  Description:
+    Returns at once if work was posted since the previous call.  Otherwise
+    the CPU executes WAIT until an interrupt arrives, and returns after that
+    interrupt has been serviced.
+
+  Remarks:
+    Called by main() after every pass of SYS_Tasks().
+*/
+
+void RUN_LOOP_Idle ( void );
+
+/*******************************************************************************
+  Function:
+    const RUN_LOOP_STATS * RUN_LOOP_StatsGet ( void )
+
+  Summary:
+    Returns the statistics of the last complete one second window.
+*/
+
+const RUN_LOOP_STATS * RUN_LOOP_StatsGet ( void );
+
+#endif /* _RUN_LOOP_H */
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,320 @@
+/*******************************************************************************
+  SPI1 Transaction Engine Source File
+
+  File Name:
+    spi_xfer.c
+
+  Summary:
+    Interrupt driven, non-blocking transaction queue for the SPI1 master.
+
+  Description:
+    Transactions are kept in a singly linked FIFO of caller owned descriptors.
+    The head of the queue is the active transaction.
+
+    In interrupt mode each SPI1 receive interrupt stores the byte that just
+    arrived and writes the next one, so the CPU is only involved for a few
+    instructions per byte instead of spinning on SPIRBF for the whole
+    transfer.
+
+    In DMA mode DMA channel 1 (SPI1BUF to memory) and DMA channel 0 (memory
+    to SPI1BUF) are both started by the SPI1 receive event.  Channel 1 has
+    the higher priority, so every received byte is drained before the next
+    one is written and the 1-deep SPI1 receive buffer can never overflow.
+    The first byte is pushed with a forced channel 0 transfer.  The CPU is
+    only interrupted once, by the channel 1 block complete event.
+*******************************************************************************/
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <xc.h>
+#include <sys/kmem.h>
+#include "spi_xfer.h"
+
+/* DMA start event. The PIC32MZ numbers its interrupt requests by vector. */
+#ifndef _SPI1_RX_IRQ
+#define _SPI1_RX_IRQ _SPI1_RX_VECTOR
+#endif
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Transaction queue. head is the active transaction. */
+static struct
+{
+    SPI_XFER_DESCRIPTOR * volatile head;
+    SPI_XFER_DESCRIPTOR * tail;
+} spiXfer;
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Masks both sources that can retire a transaction. Returns the previous
+ * enable state as a bit mask for _SPI_XFER_Unlock(). */
+static unsigned int _SPI_XFER_Lock ( void )
+{
+    unsigned int state = 0;
+
+    if(SYS_INT_SourceDisable(INT_SOURCE_SPI_1_RECEIVE))
+    {
+        state |= 1;
+    }
+    if(SYS_INT_SourceDisable(INT_SOURCE_DMA_1))
+    {
+        state |= 2;
+    }
+    return state;
+}
+
+static void _SPI_XFER_Unlock ( unsigned int state )
+{
+    /* While a DMA transaction owns the bus the SPI1 receive event belongs
+     * to the DMA controller and must not reach the CPU. */
+    SPI_XFER_DESCRIPTOR * head = spiXfer.head;
+
+    if((state & 1) && ((head == NULL) || (head->mode != SPI_XFER_MODE_DMA)))
+    {
+        SYS_INT_SourceEnable(INT_SOURCE_SPI_1_RECEIVE);
+    }
+    if(state & 2)
+    {
+        SYS_INT_SourceEnable(INT_SOURCE_DMA_1);
+    }
+}
+
+static void _SPI_XFER_ByteWrite ( SPI_XFER_DESCRIPTOR * xfer )
+{
+    SPI1BUF = (xfer->txBuffer != NULL) ? xfer->txBuffer[xfer->index] : 0;
+}
+
+static void _SPI_XFER_DmaStart ( SPI_XFER_DESCRIPTOR * xfer )
+{
+    SYS_INT_SourceDisable(INT_SOURCE_SPI_1_RECEIVE);
+
+    /* Receive channel: SPI1BUF -> rxBuffer, one byte per receive event */
+    DCH1SSA = KVA_TO_PA(&SPI1BUF);
+    DCH1SSIZ = 1;
+    DCH1DSA = KVA_TO_PA(xfer->rxBuffer);
+    DCH1DSIZ = xfer->length;
+    DCH1CSIZ = 1;
+
+    /* Transmit channel: txBuffer -> SPI1BUF, one byte per receive event */
+    DCH0SSA = KVA_TO_PA(xfer->txBuffer);
+    DCH0SSIZ = xfer->length;
+    DCH0DSA = KVA_TO_PA(&SPI1BUF);
+    DCH0DSIZ = 1;
+    DCH0CSIZ = 1;
+
+    DCH1INTCLR = 0xff;
+    DCH1CONbits.CHEN = 1;
+    DCH0CONbits.CHEN = 1;
+
+    /* Push the first byte. Every byte received after that triggers the
+     * next one on both channels. */
+    DCH0ECONbits.CFORCE = 1;
+}
+
+static void _SPI_XFER_Start ( SPI_XFER_DESCRIPTOR * xfer )
+{
+    xfer->status = SPI_XFER_STATUS_ACTIVE;
+
+    /* A receive event left over from a DMA transaction must not be taken
+     * for the first byte of this one. */
+    SYS_INT_SourceStatusClear(INT_SOURCE_SPI_1_RECEIVE);
+    SYS_PORTS_PinClear(PORTS_ID_0, xfer->csChannel, xfer->csBitPos);
+
+    if(xfer->mode == SPI_XFER_MODE_DMA)
+    {
+        _SPI_XFER_DmaStart(xfer);
+    }
+    else
+    {
+        /* The SPI1 receive event belongs to the CPU again after a DMA
+         * transaction. It has to be enabled before the first byte is
+         * written: that byte may be received before whatever called this
+         * returns, and its event must not be cleared or left masked. */
+        SYS_INT_SourceEnable(INT_SOURCE_SPI_1_RECEIVE);
+        _SPI_XFER_ByteWrite(xfer);
+    }
+}
+
+/* Called from interrupt context once the last byte of the head transaction
+ * has been received. */
+static void _SPI_XFER_Complete ( SPI_XFER_DESCRIPTOR * xfer )
+{
+    /* Release the device and retire the descriptor. */
+    SYS_PORTS_PinSet(PORTS_ID_0, xfer->csChannel, xfer->csBitPos);
+
+    spiXfer.head = xfer->next;
+    if(spiXfer.head == NULL)
+    {
+        spiXfer.tail = NULL;
+    }
+    else
+    {
+        /* Start the next transaction before the callback so that anything
+         * the callback submits is simply appended behind it. */
+        _SPI_XFER_Start(spiXfer.head);
+    }
+
+    xfer->status = SPI_XFER_STATUS_COMPLETE;
+
+    if(xfer->callback != NULL)
+    {
+        xfer->callback(xfer, xfer->context);
+    }
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: SPI Transaction Engine Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void SPI_XFER_Initialize ( void )
+{
+    spiXfer.head = NULL;
+    spiXfer.tail = NULL;
+
+    SPI1CON = 0;              // turn off the spi module and reset it
+    SPI1BUF;                  // clear the rx buffer by reading from it
+    SPI1BRG = SPI_XFER_BRG;   // baud rate to 5MHz [SPI1BRG = (40000000/(2*desired))-1]
+    SPI1STATbits.SPIROV = 0;  // clear the overflow bit
+    SPI1CONbits.CKE = 1;      // data changes when clock goes from active to inactive
+                              //    (high to low since CKP is 0)
+    SPI1CONbits.MSTEN = 1;    // master operation
+    SPI1CONbits.ON = 1;       // turn on spi
+
+    /* Both DMA channels are started by the SPI1 receive event. Channel 1
+     * (receive) outranks channel 0 (transmit) so the byte in SPI1BUF is
+     * always read before the next one is written. */
+    DMACONbits.ON = 1;
+
+    DCH0CON = 0;
+    DCH0CONbits.CHPRI = 2;
+    DCH0ECON = 0;
+    DCH0ECONbits.CHSIRQ = _SPI1_RX_IRQ;
+    DCH0ECONbits.SIRQEN = 1;
+    DCH0INT = 0;
+
+    DCH1CON = 0;
+    DCH1CONbits.CHPRI = 3;
+    DCH1ECON = 0;
+    DCH1ECONbits.CHSIRQ = _SPI1_RX_IRQ;
+    DCH1ECONbits.SIRQEN = 1;
+    DCH1INT = 0;
+    DCH1INTbits.CHBCIE = 1;   // block complete: last byte has been received
+
+    SYS_INT_SourceStatusClear(INT_SOURCE_DMA_1);
+    SYS_INT_SourceEnable(INT_SOURCE_DMA_1);
+
+    SYS_INT_SourceStatusClear(INT_SOURCE_SPI_1_RECEIVE);
+    SYS_INT_SourceEnable(INT_SOURCE_SPI_1_RECEIVE);
+}
+
+bool SPI_XFER_Submit ( SPI_XFER_DESCRIPTOR * xfer )
+{
+    unsigned int intState;
+
+    if((xfer->length == 0) ||
+       ((xfer->mode == SPI_XFER_MODE_DMA) &&
+        ((xfer->txBuffer == NULL) || (xfer->rxBuffer == NULL))) ||
+       (xfer->status == SPI_XFER_STATUS_QUEUED) ||
+       (xfer->status == SPI_XFER_STATUS_ACTIVE))
+    {
+        return false;
+    }
+
+    xfer->index = 0;
+    xfer->next = NULL;
+    xfer->status = SPI_XFER_STATUS_QUEUED;
+
+    /* The completion interrupts are the only other writers of the queue, so
+     * masking just those sources is enough to link the descriptor safely. */
+    intState = _SPI_XFER_Lock();
+
+    if(spiXfer.head == NULL)
+    {
+        spiXfer.head = xfer;
+        spiXfer.tail = xfer;
+        _SPI_XFER_Start(xfer);
+    }
+    else
+    {
+        spiXfer.tail->next = xfer;
+        spiXfer.tail = xfer;
+    }
+
+    _SPI_XFER_Unlock(intState);
+
+    return true;
+}
+
+bool SPI_XFER_IsBusy ( void )
+{
+    return (spiXfer.head != NULL);
+}
+
+void SPI_XFER_Tasks_ISR ( void )
+{
+    SPI_XFER_DESCRIPTOR * xfer = spiXfer.head;
+    uint8_t data = SPI1BUF;
+
+    SYS_INT_SourceStatusClear(INT_SOURCE_SPI_1_RECEIVE);
+
+    if((xfer == NULL) || (xfer->mode == SPI_XFER_MODE_DMA))
+    {
+        /* Spurious byte, nothing is in flight for the CPU */
+        return;
+    }
+
+    if(xfer->rxBuffer != NULL)
+    {
+        xfer->rxBuffer[xfer->index] = data;
+    }
+
+    xfer->index ++;
+    if(xfer->index < xfer->length)
+    {
+        _SPI_XFER_ByteWrite(xfer);
+        return;
+    }
+
+    _SPI_XFER_Complete(xfer);
+}
+
+void SPI_XFER_Tasks_ISR_DMA ( void )
+{
+    SPI_XFER_DESCRIPTOR * xfer = spiXfer.head;
+
+    DCH1INTCLR = 0xff;
+    SYS_INT_SourceStatusClear(INT_SOURCE_DMA_1);
+
+    if((xfer == NULL) || (xfer->mode != SPI_XFER_MODE_DMA))
+    {
+        return;
+    }
+
+    /* An interrupt mode transaction started next takes the SPI1 receive
+     * event back in _SPI_XFER_Start() */
+    xfer->index = xfer->length;
+    _SPI_XFER_Complete(xfer);
+}
+
+
+/*******************************************************************************
+ End of File
+ */
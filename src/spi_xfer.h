@@ -0,0 +1,270 @@
+/*******************************************************************************
+  SPI1 Transaction Engine Header File
+
+  File Name:
+    spi_xfer.h
+
+  Summary:
+    Interrupt driven, non-blocking transaction queue for the SPI1 master.
+
+  Description:
+    This header defines the transaction descriptor and the interface of the
+    SPI1 transaction engine.  The application fills in a descriptor (chip
+    select pin, transmit and receive buffers, length and an optional
+    completion callback) and submits it.  The bytes are then clocked out one
+    at a time from the SPI1 receive interrupt, so the caller returns
+    immediately and the superloop keeps servicing the USB stack while the
+    transfer is in progress.  Longer transactions can instead be handed to a
+    DMA channel pair, in which case the CPU only sees one interrupt at the end
+    of the transaction.
+*******************************************************************************/
+
+#ifndef _SPI_XFER_H
+#define _SPI_XFER_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "system_config.h"
+#include "system_definitions.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Configuration Defaults
+// *****************************************************************************
+// *****************************************************************************
+
+/* SPI1BRG for a 5 MHz clock, (peripheral bus clock / (2 * 5 MHz)) - 1.
+   The default is for a 40 MHz bus; configurations with another define
+   their own. */
+#ifndef SPI_XFER_BRG
+#define SPI_XFER_BRG                3
+#endif
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* SPI Transaction Status
+
+  Summary:
+    Identifies where a transaction descriptor is in its life cycle.
+
+  Description:
+    The status is written by the engine (partly from interrupt context) and
+    may be polled by the application.
+
+  Remarks:
+    A descriptor may only be modified or re-submitted while its status is
+    SPI_XFER_STATUS_IDLE or SPI_XFER_STATUS_COMPLETE.
+*/
+
+typedef enum
+{
+    /* Descriptor has never been submitted */
+    SPI_XFER_STATUS_IDLE = 0,
+
+    /* Descriptor is waiting in the queue */
+    SPI_XFER_STATUS_QUEUED,
+
+    /* Descriptor is being clocked out on the bus */
+    SPI_XFER_STATUS_ACTIVE,
+
+    /* All bytes have been exchanged and chip select is released */
+    SPI_XFER_STATUS_COMPLETE
+
+} SPI_XFER_STATUS;
+
+// *****************************************************************************
+/* SPI Transaction Mode
+
+  Summary:
+    Selects how the bytes of a transaction are moved.
+
+  Description:
+    SPI_XFER_MODE_INTERRUPT costs one SPI1 receive interrupt per byte.
+    SPI_XFER_MODE_DMA moves every byte with DMA channel 0 (transmit) and
+    DMA channel 1 (receive) in lock step with the SPI1 receive event, and
+    raises a single DMA channel 1 interrupt when the last byte has arrived.
+
+  Remarks:
+    Both modes may be mixed freely in the queue.
+*/
+
+typedef enum
+{
+    SPI_XFER_MODE_INTERRUPT = 0,
+
+    SPI_XFER_MODE_DMA
+
+} SPI_XFER_MODE;
+
+typedef struct _SPI_XFER_DESCRIPTOR SPI_XFER_DESCRIPTOR;
+
+// *****************************************************************************
+/* SPI Transaction Completion Callback
+
+  Summary:
+    Called when all bytes of a transaction have been exchanged.
+
+  Remarks:
+    The callback runs in the SPI1 interrupt context.  It may submit further
+    transactions but must not block.
+*/
+
+typedef void (*SPI_XFER_CALLBACK)(SPI_XFER_DESCRIPTOR * xfer, uintptr_t context);
+
+// *****************************************************************************
+/* SPI Transaction Descriptor
+
+  Summary:
+    Describes one chip select framed SPI1 transaction.
+
+  Description:
+    The descriptor and the buffers it points to are owned by the engine from
+    the moment SPI_XFER_Submit() accepts it until its status becomes
+    SPI_XFER_STATUS_COMPLETE.
+
+  Remarks:
+    The engine does not copy anything, so descriptors are normally statically
+    allocated by the module that issues the transaction.
+*/
+
+struct _SPI_XFER_DESCRIPTOR
+{
+    /* Chip select port channel and pin. Chip select is active low. */
+    PORTS_CHANNEL csChannel;
+    PORTS_BIT_POS csBitPos;
+
+    /* Bytes to transmit. If NULL, zeros are clocked out.
+       Required in SPI_XFER_MODE_DMA. */
+    const uint8_t * txBuffer;
+
+    /* Storage for received bytes. If NULL, received bytes are discarded.
+       Required in SPI_XFER_MODE_DMA. */
+    uint8_t * rxBuffer;
+
+    /* Number of bytes to exchange */
+    size_t length;
+
+    /* How the bytes are moved */
+    SPI_XFER_MODE mode;
+
+    /* Optional completion callback and its context */
+    SPI_XFER_CALLBACK callback;
+    uintptr_t context;
+
+    /* Life cycle of this descriptor. Updated by the engine. */
+    volatile SPI_XFER_STATUS status;
+
+    /* Engine private: byte position and queue link */
+    size_t index;
+    SPI_XFER_DESCRIPTOR * next;
+};
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: SPI Transaction Engine Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void SPI_XFER_Initialize ( void )
+
+  Summary:
+    Configures the SPI1 master, its DMA channels and their interrupts.
+
+  Description:
+    This function resets SPI1, configures it for 8-bit master operation at
+    5 MHz, binds DMA channels 0 and 1 to the SPI1 receive event and enables
+    the SPI1 receive and DMA channel 1 interrupt sources.  The interrupt
+    vector priorities are set by the system configuration.
+
+  Remarks:
+    Must be called from SYS_Initialize before any transaction is submitted.
+*/
+
+void SPI_XFER_Initialize ( void );
+
+/*******************************************************************************
+  Function:
+    bool SPI_XFER_Submit ( SPI_XFER_DESCRIPTOR * xfer )
+
+  Summary:
+    Queues a transaction and returns immediately.
+
+  Description:
+    This function appends the descriptor to the transaction queue.  If the bus
+    is idle, chip select is asserted and the first byte is written right away;
+    the rest of the transaction is driven by the SPI1 receive interrupt.
+    Transactions complete in the order they were submitted.
+
+  Returns:
+    true  - The transaction was queued.
+    false - The descriptor is already queued or active, its length is 0, or
+            it is a DMA mode descriptor without both buffers.
+
+  Remarks:
+    May be called from task context, from a completion callback or from
+    another interrupt at the SPI1/DMA1 priority level.  It must not be
+    called from a higher priority interrupt, since masking the completion
+    sources cannot stop a completion handler that is already running.
+*/
+
+bool SPI_XFER_Submit ( SPI_XFER_DESCRIPTOR * xfer );
+
+/*******************************************************************************
+  Function:
+    bool SPI_XFER_IsBusy ( void )
+
+  Summary:
+    Returns true while any transaction is queued or active.
+*/
+
+bool SPI_XFER_IsBusy ( void );
+
+/*******************************************************************************
+  Function:
+    void SPI_XFER_Tasks_ISR ( void )
+
+  Summary:
+    Advances the active transaction by one byte.
+
+  Remarks:
+    Must be called from the SPI1 interrupt vector of the system configuration.
+*/
+
+void SPI_XFER_Tasks_ISR ( void );
+
+/*******************************************************************************
+  Function:
+    void SPI_XFER_Tasks_ISR_DMA ( void )
+
+  Summary:
+    Retires a DMA mode transaction.
+
+  Remarks:
+    Must be called from the DMA channel 1 interrupt vector of the system
+    configuration.
+*/
+
+void SPI_XFER_Tasks_ISR_DMA ( void );
+
+#endif /* _SPI_XFER_H */
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,101 @@
+/*******************************************************************************
+  Single Producer / Single Consumer Ring Source File
+
+  File Name:
+    spsc_ring.c
+
+  Summary:
+    Lock-free FIFO for handing fixed size elements from one interrupt to one
+    task (or from one task to one interrupt).
+
+  Description:
+    The PIC32 has a single in-order core, so the only reordering to guard
+    against is the compiler's.  Each side fills or empties the slot first and
+    publishes its index afterwards, with a compiler barrier in between.
+*******************************************************************************/
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "system_config.h"
+#include "spsc_ring.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Keeps element copies from moving across an index update.  The cores
+   this runs on take both sides in program order, so the compiler is all
+   there is to stop.  A multi-core host overrides it with a real fence. */
+#ifndef SPSC_RING_BARRIER
+#define SPSC_RING_BARRIER()   __asm__ __volatile__("" ::: "memory")
+#endif
+
+static inline uint8_t * _SPSC_RING_Slot ( SPSC_RING * ring, unsigned int index )
+{
+    return (uint8_t *)ring->buffer + (index & ring->mask) * ring->elementSize;
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: SPSC Ring Functions
+// *****************************************************************************
+// *****************************************************************************
+
+bool SPSC_RING_Put ( SPSC_RING * ring, const void * element )
+{
+    unsigned int head = ring->head;
+
+    if((head - ring->tail) > ring->mask)
+    {
+        ring->overflows ++;
+        return false;
+    }
+
+    memcpy(_SPSC_RING_Slot(ring, head), element, ring->elementSize);
+    SPSC_RING_BARRIER();
+    ring->head = head + 1;
+
+    return true;
+}
+
+bool SPSC_RING_Get ( SPSC_RING * ring, void * element )
+{
+    unsigned int tail = ring->tail;
+
+    if(tail == ring->head)
+    {
+        return false;
+    }
+
+    SPSC_RING_BARRIER();
+    memcpy(element, _SPSC_RING_Slot(ring, tail), ring->elementSize);
+    SPSC_RING_BARRIER();
+    ring->tail = tail + 1;
+
+    return true;
+}
+
+unsigned int SPSC_RING_Count ( SPSC_RING * ring )
+{
+    return ring->head - ring->tail;
+}
+
+unsigned int SPSC_RING_OverflowsGet ( SPSC_RING * ring )
+{
+    return ring->overflows;
+}
+
+
+/*******************************************************************************
+ End of File
+ */
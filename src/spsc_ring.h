@@ -0,0 +1,161 @@
+/*******************************************************************************
+  Single Producer / Single Consumer Ring Header File
+
+  File Name:
+    spsc_ring.h
+
+  Summary:
+    Lock-free FIFO for handing fixed size elements from one interrupt to one
+    task (or from one task to one interrupt).
+
+  Description:
+    A ring is a power of two array of elements plus two free running indices.
+    The head index is only ever written by the producer and the tail index is
+    only ever written by the consumer, so neither side needs to disable
+    interrupts.  An element that does not fit is dropped and counted instead
+    of overwriting data the consumer has not read yet.
+
+    Rings are normally defined at file scope with SPSC_RING_DEFINE(), which
+    allocates the storage and fixes the element size and depth at compile
+    time.
+*******************************************************************************/
+
+#ifndef _SPSC_RING_H
+#define _SPSC_RING_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* SPSC Ring
+
+  Summary:
+    Describes one ring and its storage.
+
+  Remarks:
+    The members are private to the ring functions.  Use SPSC_RING_DEFINE()
+    to create a ring.
+*/
+
+typedef struct
+{
+    /* depth * elementSize bytes of element storage */
+    void * buffer;
+
+    /* Size of one element in bytes */
+    size_t elementSize;
+
+    /* depth - 1, depth being a power of two */
+    unsigned int mask;
+
+    /* Free running element counts. head is written by the producer only,
+       tail by the consumer only. */
+    volatile unsigned int head;
+    volatile unsigned int tail;
+
+    /* Elements dropped because the ring was full. Producer only. */
+    volatile unsigned int overflows;
+
+} SPSC_RING;
+
+// *****************************************************************************
+/* Macro:
+    SPSC_RING_DEFINE(name, type, depth)
+
+  Summary:
+    Defines a file scope ring called name holding depth elements of type.
+
+  Remarks:
+    depth must be a power of two; anything else fails to compile.
+*/
+
+#define SPSC_RING_DEFINE(name, type, depth)                                   \
+    typedef char name##_depth_is_a_power_of_two                               \
+            [((depth) > 0) && (((depth) & ((depth) - 1)) == 0) ? 1 : -1];     \
+    static type name##Storage[depth];                                         \
+    static SPSC_RING name = { name##Storage, sizeof(type), (depth) - 1, 0, 0, 0 }
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: SPSC Ring Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    bool SPSC_RING_Put ( SPSC_RING * ring, const void * element )
+
+  Summary:
+    Copies one element into the ring.
+
+  Returns:
+    true  - The element was queued.
+    false - The ring was full. The element was dropped and counted.
+
+  Remarks:
+    Producer side only.
+*/
+
+bool SPSC_RING_Put ( SPSC_RING * ring, const void * element );
+
+/*******************************************************************************
+  Function:
+    bool SPSC_RING_Get ( SPSC_RING * ring, void * element )
+
+  Summary:
+    Copies the oldest element out of the ring and removes it.
+
+  Returns:
+    true  - An element was copied to element.
+    false - The ring was empty.
+
+  Remarks:
+    Consumer side only.
+*/
+
+bool SPSC_RING_Get ( SPSC_RING * ring, void * element );
+
+/*******************************************************************************
+  Function:
+    unsigned int SPSC_RING_Count ( SPSC_RING * ring )
+
+  Summary:
+    Returns the number of queued elements.
+
+  Remarks:
+    May be called from either side.  The value is only a snapshot while the
+    other side is running.
+*/
+
+unsigned int SPSC_RING_Count ( SPSC_RING * ring );
+
+/*******************************************************************************
+  Function:
+    unsigned int SPSC_RING_OverflowsGet ( SPSC_RING * ring )
+
+  Summary:
+    Returns the number of elements dropped since the ring was defined.
+*/
+
+unsigned int SPSC_RING_OverflowsGet ( SPSC_RING * ring );
+
+#endif /* _SPSC_RING_H */
+/*******************************************************************************
+ End of File
+ */
@@ -168,7 +168,7 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 // *****************************************************************************
 // *****************************************************************************
 
-/* Tick time in 1msec units */
+/* Switch debounce time in milliseconds */
 
 #define APP_USB_SWITCH_DEBOUNCE_COUNT (160)
 
@@ -177,6 +177,11 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 
 #define APP_USB_CONVERT_TO_MILLISECOND (1)
 
+/* No LSM303D is routed on this board. SPI1 and INT2 are still set up, but
+ * acc_setup() is not called and the mouse reports no motion. */
+
+#define ACC_ENABLE false
+
 /* Macro defines USB internal DMA Buffer criteria*/
 
 #define APP_MAKE_BUFFER_DMA_READY
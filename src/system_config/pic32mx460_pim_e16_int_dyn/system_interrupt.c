@@ -73,7 +73,30 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 void __ISR(_USB_1_VECTOR, ipl4) _IntHandlerUSBInstance0(void)
 {
     USB_DEVICE_Tasks_ISR(sysObj.usbDevObject0);
-            
+    RUN_LOOP_Post();
+}
+
+void __ISR(_SPI_1_VECTOR, ipl3) _IntHandlerSPI1(void)
+{
+    SPI_XFER_Tasks_ISR();
+}
+
+void __ISR(_DMA_1_VECTOR, ipl3) _IntHandlerSPI1_DMA(void)
+{
+    /* Completes the accelerometer bursts */
+    SPI_XFER_Tasks_ISR_DMA();
+    RUN_LOOP_Post();
+}
+
+void __ISR(_EXTERNAL_2_VECTOR, ipl3) _IntHandlerAccelINT2(void)
+{
+    acc_int_isr();
+}
+
+void __ISR(_CORE_TIMER_VECTOR, ipl1) _IntHandlerCoreTimer(void)
+{
+    TIMEBASE_Tasks_ISR();
+    RUN_LOOP_Post();
 }
 
  
@@ -155,8 +155,9 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 
 /* HID Transfer Queue Size for both read and
    write. Applicable to all instances of the
-   function driver */
-#define USB_DEVICE_HID_QUEUE_DEPTH_COMBINED 2
+   function driver. One receive plus the
+   mouse report queue. */
+#define USB_DEVICE_HID_QUEUE_DEPTH_COMBINED (1 + APP_REPORT_QUEUE_DEPTH)
 
 // *****************************************************************************
 // *****************************************************************************
@@ -164,7 +165,7 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 // *****************************************************************************
 // *****************************************************************************
 
-/* Tick time in 1msec units */
+/* Switch debounce time in milliseconds */
 
 #define APP_USB_SWITCH_DEBOUNCE_COUNT (160)
 
@@ -173,6 +174,69 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 
 #define APP_USB_CONVERT_TO_MILLISECOND (1)
 
+/* Report X and Y as 16-bit values so that one frame can carry large
+ * movement. Selects the report descriptor in system_init.c and the
+ * MOUSE_REPORT layout in mouse.h. */
+
+#define MOUSE_HIGH_RESOLUTION true
+
+/* The report for a frame is built from the freshest sample this many
+ * microseconds before the next SOF. Leaves time for the motion update and
+ * the report send to finish before the host's IN token. */
+
+#define APP_REPORT_LEAD_US (150)
+
+/* One mouse report queued in the HID function driver. A second one only
+ * waits behind the first for the next IN token: with bInterval 4 the
+ * simulator measured 7.9 ms from sample to host at depth 2 against 3.9 ms
+ * at depth 1. The report pool needs a buffer for each. */
+
+#define APP_REPORT_QUEUE_DEPTH 1
+#define REPORT_POOL_BUFFERS APP_REPORT_QUEUE_DEPTH
+
+/* Sleep in WAIT between the interrupts that post work, instead of polling
+ * SYS_Tasks. Count loop passes and busy time per second in either mode. */
+
+#define RUN_LOOP_EVENT_DRIVEN true
+#define RUN_LOOP_ACCOUNTING true
+
+/* Time every call in SYS_Tasks and let the host read the histograms as a
+ * vendor feature report. With a second top-level collection in the report
+ * descriptor, every report needs a report ID. */
+
+#define PROFILER_ENABLE true
+#define PROFILER_REPORT_ID 2
+#define MOUSE_REPORT_ID 1
+
+/* Record each sample's way from the sensor to the host in a RAM ring,
+ * drained by the host as another vendor feature report. */
+
+#define TRACE_ENABLE true
+#define TRACE_REPORT_ID 3
+
+/* Reports per second, missed frames, lost motion and CPU load, read by
+ * the host as a vendor feature report to compare configurations. */
+
+#define APP_STATS_ENABLE true
+#define APP_STATS_REPORT_ID 4
+
+/* Stream the raw accelerometer samples to the host for record and replay.
+ * Off by default: EP0 is only 8 bytes, so the control transfers that
+ * carry them take a good part of every frame. */
+
+#define CAPTURE_ENABLE false
+#define CAPTURE_REPORT_ID 5
+
+/* Low pass the 1600 Hz samples down to one per frame before the tilt
+ * pipeline, with the default coefficients of decimator.h. Adds 2.44 ms of
+ * delay; tools/decimator_design.py trades it against the stop band. */
+
+#define DECIMATOR_ENABLE true
+
+/* The LSM303D on SPI1, routed in SYS_Initialize. */
+
+#define ACC_ENABLE true
+
 /* Application USB Device CDC Read Buffer Size. This should be a multiple of
  * the CDC Bulk Endpoint size */
 
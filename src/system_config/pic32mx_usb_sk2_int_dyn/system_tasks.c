@@ -76,17 +76,20 @@ void SYS_Tasks ( void )
     /* Maintain the state machines of all library modules executing polled in
     the system. */
 
+    /* Each call is timed by the profiler when it is enabled */
+
     /* Maintain system services */
-    SYS_DEVCON_Tasks(sysObj.sysDevcon);
+    PROFILER_MEASURE(PROFILER_TASK_DEVCON, SYS_DEVCON_Tasks(sysObj.sysDevcon));
+    PROFILER_MEASURE(PROFILER_TASK_TIMER_WHEEL, TIMER_WHEEL_Tasks());
 
     /* Maintain Device Drivers */
 
     /* Maintain USB Stack */
     /* Device layer tasks routine */ 
-    USB_DEVICE_Tasks(sysObj.usbDevObject0);
+    PROFILER_MEASURE(PROFILER_TASK_USB_DEVICE, USB_DEVICE_Tasks(sysObj.usbDevObject0));
 
     /* Maintain the application's state machine. */
-    APP_Tasks();
+    PROFILER_MEASURE(PROFILER_TASK_APP, APP_Tasks());
 }
 
 
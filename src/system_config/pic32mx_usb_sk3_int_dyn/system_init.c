@@ -111,31 +111,8 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
  ****************************************************/
 const uint8_t hid_rpt0[] =
 {
-    0x05, 0x01, /* Usage Page (Generic Desktop)        */
-   0x09, 0x02, /* Usage (Mouse)                       */
-   0xA1, 0x01, /* Collection (Application)            */
-   0x09, 0x01, /* Usage (Pointer)                     */
-   0xA1, 0x00, /* Collection (Physical)               */
-   0x05, 0x09, /* Usage Page (Buttons)                */
-   0x19, 0x01, /* Usage Minimum (01)                  */
-   0x29, 0x03, /* Usage Maximum (03)                  */
-   0x15, 0x00, /* Logical Minimum (0)                 */
-   0x25, 0x01, /* Logical Maximum (1)                 */
-   0x95, 0x03, /* Report Count (3)                    */
-   0x75, 0x01, /* Report Size (1)                     */
-   0x81, 0x02, /* Input (Data, Variable, Absolute)    */
-   0x95, 0x01, /* Report Count (1)                    */
-   0x75, 0x05, /* Report Size (5)                     */
-   0x81, 0x01, /* Input (Constant)    ;5 bit padding  */
-   0x05, 0x01, /* Usage Page (Generic Desktop)        */
-   0x09, 0x30, /* Usage (X)                           */
-   0x09, 0x31, /* Usage (Y)                           */
-   0x15, 0x81, /* Logical Minimum (-127)              */
-   0x25, 0x7F, /* Logical Maximum (127)               */
-   0x75, 0x08, /* Report Size (8)                     */
-   0x95, 0x02, /* Report Count (2)                    */
-   0x81, 0x06, /* Input (Data, Variable, Relative)    */
-   0xC0, 0xC0
+    /* Generated from the report schema in mouse.h */
+    MOUSE_REPORT_DESCRIPTOR
 };
 /**************************************************
  * USB Device Function Driver Init Data
@@ -225,7 +202,8 @@ const uint8_t fullSpeedConfigurationDescriptor[] =
     0x00,                           // Country Code (0x00 for Not supported)
     0x1,                            // Number of class descriptors, see usbcfg.h
     USB_HID_DESCRIPTOR_TYPES_REPORT,// Report descriptor type
-    0x32,0x00,                      // Size of the report descriptor
+    (uint8_t)sizeof(hid_rpt0),      // Size of the report descriptor
+    (uint8_t)(sizeof(hid_rpt0) >> 8),
 
     /* Endpoint Descriptor */
 
@@ -445,9 +423,42 @@ void SYS_Initialize ( void* data )
     SYS_PORTS_Initialize();
 
     /* Initialize Drivers */
+    /* Set priority of SPI1 interrupt source */
+    SYS_INT_VectorPrioritySet(INT_VECTOR_SPI1, INT_PRIORITY_LEVEL3);
 
-    /* Initialize System Services */
+    /* Set Sub-priority of SPI1 interrupt source */
+    SYS_INT_VectorSubprioritySet(INT_VECTOR_SPI1, INT_SUBPRIORITY_LEVEL0);
+
+    /* Set priority of the SPI1 receive DMA channel interrupt source */
+    SYS_INT_VectorPrioritySet(INT_VECTOR_DMA1, INT_PRIORITY_LEVEL3);
+
+    /* Set Sub-priority of the SPI1 receive DMA channel interrupt source */
+    SYS_INT_VectorSubprioritySet(INT_VECTOR_DMA1, INT_SUBPRIORITY_LEVEL0);
+
+    /* Set priority of the accelerometer FIFO watermark interrupt source.
+       Same level as SPI1 and DMA1, since it submits SPI1 transactions. */
+    SYS_INT_VectorPrioritySet(INT_VECTOR_INT2, INT_PRIORITY_LEVEL3);
 
+    /* Set Sub-priority of the accelerometer FIFO watermark interrupt source */
+    SYS_INT_VectorSubprioritySet(INT_VECTOR_INT2, INT_SUBPRIORITY_LEVEL0);
+
+    /* Initialize the SPI1 transaction engine. No accelerometer is routed on
+       this board (ACC_ENABLE), so nothing submits to it yet. */
+    SPI_XFER_Initialize();
+
+    /* Initialize System Services */
+    /* Set priority of the core timer interrupt source. It only keeps the
+       timebase extension up to date, so it runs at the lowest level. */
+    SYS_INT_VectorPrioritySet(INT_VECTOR_CT, INT_PRIORITY_LEVEL1);
+
+    /* Set Sub-priority of the core timer interrupt source */
+    SYS_INT_VectorSubprioritySet(INT_VECTOR_CT, INT_SUBPRIORITY_LEVEL0);
+
+    /* Initialize the monotonic timebase, the software timers and the run
+       loop's accounting */
+    TIMEBASE_Initialize();
+    TIMER_WHEEL_Initialize();
+    RUN_LOOP_Initialize();
 
     /* Initialize Middleware */
     /* Set priority of USB interrupt source */
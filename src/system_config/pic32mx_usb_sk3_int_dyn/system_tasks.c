@@ -78,6 +78,7 @@ void SYS_Tasks ( void )
 
     /* Maintain system services */
     SYS_DEVCON_Tasks(sysObj.sysDevcon);
+    TIMER_WHEEL_Tasks();
 
     /* Maintain Device Drivers */
 
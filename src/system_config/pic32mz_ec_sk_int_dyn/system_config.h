@@ -205,16 +205,29 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 // *****************************************************************************
 // *****************************************************************************
 
-/* Tick time in 125 usec units */
-#define APP_USB_SWITCH_DEBOUNCE_COUNT (1280)
+/* Switch debounce time in milliseconds */
+#define APP_USB_SWITCH_DEBOUNCE_COUNT (160)
 
 /* Macro defines the conversion factor to be
  * multiplied to convert to millisecs*/
 #define APP_USB_CONVERT_TO_MILLISECOND (1/8)
 
+/* No LSM303D is routed on this board. SPI1 and INT2 are still set up, but
+ * acc_setup() is not called and the mouse reports no motion. */
+
+#define ACC_ENABLE false
+
+/* SPI1 runs from PBCLK2, 100 MHz: 5 MHz SCK. */
+
+#define SPI_XFER_BRG 9
+
 /* Macro defines USB internal DMA Buffer criteria*/
 #define APP_MAKE_BUFFER_DMA_READY __attribute__((coherent, aligned(4)))
 
+/* The PIC32MZ EC core has the MIPS DSP ASE revision 2. Run the filter and
+ * gain curve kernels on it; this needs -mdspr2 in the compiler options. */
+#define DSP_ASE_ENABLE true
+
 /* Macros defines board specific led */
 #define APP_USB_LED_1    BSP_LED_1
 
@@ -77,11 +77,31 @@ void __ISR(_TIMER_2_VECTOR, ipl4) _IntHandlerDrvTmrInstance0(void)
  void __ISR(_USB_VECTOR, ipl4) _IntHandlerUSBInstance0(void)
 {
     USB_DEVICE_Tasks_ISR(sysObj.usbDevObject0);
-            
+    RUN_LOOP_Post();
 }
 void __ISR ( _USB_DMA_VECTOR,ipl4) _IntHandlerUSBInstance0_USBDMA ( void )
 {
     USB_DEVICE_Tasks_ISR_USBDMA(sysObj.usbDevObject0);
+    RUN_LOOP_Post();
+}
+void __ISR(_SPI1_RX_VECTOR, ipl3) _IntHandlerSPI1(void)
+{
+    SPI_XFER_Tasks_ISR();
+}
+void __ISR(_DMA1_VECTOR, ipl3) _IntHandlerSPI1_DMA(void)
+{
+    /* Completes the accelerometer bursts */
+    SPI_XFER_Tasks_ISR_DMA();
+    RUN_LOOP_Post();
+}
+void __ISR(_EXTERNAL_2_VECTOR, ipl3) _IntHandlerAccelINT2(void)
+{
+    acc_int_isr();
+}
+void __ISR(_CORE_TIMER_VECTOR, ipl1) _IntHandlerCoreTimer(void)
+{
+    TIMEBASE_Tasks_ISR();
+    RUN_LOOP_Post();
 }
 
  
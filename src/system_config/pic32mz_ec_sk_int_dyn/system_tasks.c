@@ -79,6 +79,7 @@ void SYS_Tasks ( void )
     /* Maintain system services */
     SYS_DEVCON_Tasks(sysObj.sysDevcon);
     SYS_TMR_Tasks(sysObj.sysTmr);
+    TIMER_WHEEL_Tasks();
 
     /* Maintain Device Drivers */
     DRV_TMR_Tasks(sysObj.drvTmr0);
@@ -0,0 +1,84 @@
+/*******************************************************************************
+  Tilt to Velocity Pipeline Source File
+
+  File Name:
+    tilt.c
+
+  Summary:
+    Maps the accelerometer's tilt to pointer velocity, in integer
+    arithmetic.
+*******************************************************************************/
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "tilt.h"
+#include "dsp.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Bits of a Q15 magnitude below the segment index */
+#define TILT_GAIN_FRACTION_BITS     (15 - TILT_GAIN_SEGMENT_BITS)
+
+static const int16_t tiltGainCurve[TILT_GAIN_SEGMENTS + 1] = { TILT_GAIN_CURVE };
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Tilt Pipeline Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void TILT_Initialize ( TILT_PIPELINE * tilt, unsigned int samplesNum,
+                       unsigned int samplesDen )
+{
+    unsigned int segment;
+    int32_t velocity;
+
+    tilt->biasX = TILT_BIAS_X;
+    tilt->biasY = TILT_BIAS_Y;
+
+    /* The curve is not negative. Saturating at INT16_MAX keeps it within
+       what DSP_CurvePairQ15() accepts. */
+    for(segment = 0; segment <= TILT_GAIN_SEGMENTS; segment ++)
+    {
+        velocity = (tiltGainCurve[segment] * (int32_t)samplesNum +
+                    (int32_t)(samplesDen / 2)) / (int32_t)samplesDen;
+        tilt->curve[segment] = (velocity > INT16_MAX) ? INT16_MAX : velocity;
+    }
+}
+
+void TILT_BiasCapture ( TILT_PIPELINE * tilt, const ACC_SAMPLE * sample )
+{
+    tilt->biasX = sample->x;
+    tilt->biasY = sample->y;
+}
+
+void TILT_Process ( const TILT_PIPELINE * tilt, const ACC_SAMPLE * sample,
+                    TILT_VELOCITY * velocity )
+{
+    /* Both axes at once. The dead zone is subtracted, so the output is
+       continuous at its edge. */
+    const int16_t input[2] = { sample->x, sample->y };
+    const int16_t offset[2] = { tilt->biasX, tilt->biasY };
+    int16_t output[2];
+
+    DSP_CurvePairQ15(input, offset, TILT_DEAD_ZONE, tilt->curve,
+                     TILT_GAIN_FRACTION_BITS, output);
+    velocity->x = output[0];
+    velocity->y = output[1];
+}
+
+
+/*******************************************************************************
+ End of File
+ */
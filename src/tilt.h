@@ -0,0 +1,163 @@
+/*******************************************************************************
+  Tilt to Velocity Pipeline Header File
+
+  File Name:
+    tilt.h
+
+  Summary:
+    Maps the accelerometer's tilt to pointer velocity, in integer
+    arithmetic.
+
+  Description:
+    Each sample goes through the same fixed steps, per axis:
+
+      1. Bias removal.  The reading at rest is subtracted, with saturation.
+      2. Dead zone.  Tilts within TILT_DEAD_ZONE of rest give no motion;
+         beyond it the dead zone is subtracted, so the output starts from 0
+         instead of jumping.
+      3. Gain curve.  The tilt magnitude indexes a lookup table of
+         TILT_GAIN_SEGMENTS + 1 velocities, linearly interpolated between
+         entries.  The table can hold any monotonic shape (piecewise
+         linear, exponential, ...) and is replaced by the configuration.
+      4. Saturation.  The signed velocity is clamped to int16_t.
+
+    Samples are Q15 fractions of the sensor's full scale (+/- 2 g, so 1 g
+    is about 16384).  Velocities are Q8.8 counts per pipeline step, which
+    is one sensor sample unless the samples are rate converted first; the
+    curve is scaled to the step once, at initialization.  There are no
+    loops and no division, so the cost per sample is constant.
+*******************************************************************************/
+
+#ifndef _TILT_H
+#define _TILT_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include "system_config.h"
+#include "accel.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants and Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Fraction bits of a velocity: Q8.8 counts per sample */
+#define TILT_VELOCITY_FRACTION_BITS 8
+#define TILT_VELOCITY_ONE           (1 << TILT_VELOCITY_FRACTION_BITS)
+
+/* The gain curve splits 0..32767 into 2^TILT_GAIN_SEGMENT_BITS segments */
+#define TILT_GAIN_SEGMENT_BITS      4
+#define TILT_GAIN_SEGMENTS          (1 << TILT_GAIN_SEGMENT_BITS)
+
+/* Tilt at rest on each axis, Q15 */
+#ifndef TILT_BIAS_X
+#define TILT_BIAS_X                 0
+#endif
+#ifndef TILT_BIAS_Y
+#define TILT_BIAS_Y                 0
+#endif
+
+/* Tilt that still counts as rest, Q15. 573 is about 2 degrees. */
+#ifndef TILT_DEAD_ZONE
+#define TILT_DEAD_ZONE              573
+#endif
+
+/* Velocity at the start of each segment and at full scale, Q8.8 counts
+   per sample, TILT_GAIN_SEGMENTS + 1 values.  The default roughly doubles
+   every 7 degrees, reaches 1.3 counts per sample (2100 counts/s at
+   1600 Hz) at 45 degrees and flattens out at 4 counts per sample. */
+#ifndef TILT_GAIN_CURVE
+#define TILT_GAIN_CURVE                                                       \
+    0, 8, 24, 56, 120, 248, 480, 640, 768, 832, 896, 960, 1024, 1024, 1024,   \
+    1024, 1024
+#endif
+
+// *****************************************************************************
+/* Tilt Pipeline State
+
+  Remarks:
+    Only the bias changes at run time.
+*/
+
+typedef struct
+{
+    int16_t biasX;
+    int16_t biasY;
+
+    /* TILT_GAIN_CURVE scaled from per sample to per step */
+    int16_t curve[TILT_GAIN_SEGMENTS + 1];
+
+} TILT_PIPELINE;
+
+// *****************************************************************************
+/* Pointer Velocity
+
+  Remarks:
+    Q8.8 counts per pipeline step.
+*/
+
+typedef struct
+{
+    int16_t x;
+    int16_t y;
+
+} TILT_VELOCITY;
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Tilt Pipeline Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void TILT_Initialize ( TILT_PIPELINE * tilt, unsigned int samplesNum,
+                           unsigned int samplesDen )
+
+  Summary:
+    Starts from the configured bias and gain curve.
+
+  Description:
+    Each pipeline step stands for samplesNum / samplesDen sensor samples.
+    The gain curve is scaled by that ratio, rounded to nearest once, so
+    the velocities need no further scaling.
+*/
+
+void TILT_Initialize ( TILT_PIPELINE * tilt, unsigned int samplesNum,
+                       unsigned int samplesDen );
+
+/*******************************************************************************
+  Function:
+    void TILT_BiasCapture ( TILT_PIPELINE * tilt, const ACC_SAMPLE * sample )
+
+  Summary:
+    Makes the given sample the rest position.
+*/
+
+void TILT_BiasCapture ( TILT_PIPELINE * tilt, const ACC_SAMPLE * sample );
+
+/*******************************************************************************
+  Function:
+    void TILT_Process ( const TILT_PIPELINE * tilt, const ACC_SAMPLE * sample,
+                        TILT_VELOCITY * velocity )
+
+  Summary:
+    Maps one sample to a pointer velocity.
+*/
+
+void TILT_Process ( const TILT_PIPELINE * tilt, const ACC_SAMPLE * sample,
+                    TILT_VELOCITY * velocity );
+
+#endif /* _TILT_H */
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,128 @@
+/*******************************************************************************
+  Monotonic Timebase Source File
+
+  File Name:
+    timebase.c
+
+  Summary:
+    64-bit monotonic time from the CP0 Count register.
+
+  Description:
+    The upper 32 bits are counted in software.  Every read compares the
+    counter against the previous read and carries when it has wrapped, which
+    is correct as long as reads are less than 2^32 ticks apart.  The core
+    timer interrupt guarantees that by reading the time every 2^30 ticks.
+*******************************************************************************/
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <xc.h>
+#include "timebase.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Core timer ticks between two compare interrupts */
+#define TIMEBASE_REFRESH_TICKS      0x40000000u
+
+/* An alarm closer than this could be passed while Compare is written */
+#define TIMEBASE_ALARM_MARGIN_TICKS 64
+
+static struct
+{
+    uint32_t high;
+    uint32_t last;
+
+    /* Time Compare is programmed for */
+    uint64_t compare;
+} timebase;
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Timebase Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void TIMEBASE_Initialize ( void )
+{
+    timebase.high = 0;
+    timebase.last = TIMEBASE_COUNT_GET();
+    timebase.compare = timebase.last + TIMEBASE_REFRESH_TICKS;
+
+    _CP0_SET_COMPARE((uint32_t)timebase.compare);
+    SYS_INT_SourceStatusClear(INT_SOURCE_TIMER_CORE);
+    SYS_INT_SourceEnable(INT_SOURCE_TIMER_CORE);
+}
+
+uint64_t TIMEBASE_TicksGet ( void )
+{
+    bool intState;
+    uint32_t low;
+    uint64_t ticks;
+
+    intState = SYS_INT_Disable();
+
+    low = TIMEBASE_COUNT_GET();
+    if(low < timebase.last)
+    {
+        timebase.high ++;
+    }
+    timebase.last = low;
+    ticks = ((uint64_t)timebase.high << 32) | low;
+
+    SYS_INT_Restore(intState);
+
+    return ticks;
+}
+
+uint64_t TIMEBASE_MicrosecondsGet ( void )
+{
+    return TIMEBASE_TicksGet() / TIMEBASE_TICKS_PER_US;
+}
+
+bool TIMEBASE_AlarmSet ( uint64_t deadline )
+{
+    bool intState;
+    bool armed = false;
+
+    intState = SYS_INT_Disable();
+
+    if(deadline > TIMEBASE_TicksGet() + TIMEBASE_ALARM_MARGIN_TICKS)
+    {
+        armed = true;
+        if(deadline < timebase.compare)
+        {
+            timebase.compare = deadline;
+            _CP0_SET_COMPARE((uint32_t)deadline);
+        }
+    }
+
+    SYS_INT_Restore(intState);
+
+    return armed;
+}
+
+void TIMEBASE_Tasks_ISR ( void )
+{
+    /* Any alarm is spent. Fall back to the refresh period. */
+    timebase.compare = TIMEBASE_TicksGet() + TIMEBASE_REFRESH_TICKS;
+
+    /* Writing Compare also clears the core timer interrupt request */
+    _CP0_SET_COMPARE((uint32_t)timebase.compare);
+    SYS_INT_SourceStatusClear(INT_SOURCE_TIMER_CORE);
+}
+
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,148 @@
+/*******************************************************************************
+  Monotonic Timebase Header File
+
+  File Name:
+    timebase.h
+
+  Summary:
+    64-bit monotonic time from the CP0 Count register.
+
+  Description:
+    The core timer counts at half the system clock and wraps every 2^32
+    ticks (about 107 seconds at 80 MHz).  This module extends it to 64 bits,
+    so time keeps running while the USB bus is suspended and never wraps
+    in practice.  The core timer compare interrupt fires at least twice per
+    wrap to keep the extension up to date, even if nobody reads the time.
+    It can also be brought forward as an alarm, so that the CPU is woken
+    from WAIT at a given time.
+
+    Time is kept in core timer ticks.  The conversion macros below scale by
+    the board's SYS_CLK_FREQ.
+*******************************************************************************/
+
+#ifndef _TIMEBASE_H
+#define _TIMEBASE_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "system_config.h"
+#include "system_definitions.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants and Macros
+// *****************************************************************************
+// *****************************************************************************
+
+/* Core timer ticks per microsecond */
+#define TIMEBASE_TICKS_PER_US       (SYS_CLK_FREQ / 2 / 1000000)
+
+/* Conversions to core timer ticks, 64-bit */
+#define TIMEBASE_US_TO_TICKS(us)    ((uint64_t)(us) * TIMEBASE_TICKS_PER_US)
+#define TIMEBASE_MS_TO_TICKS(ms)    ((uint64_t)(ms) * 1000 * TIMEBASE_TICKS_PER_US)
+
+/* Raw 32-bit counter. Every core timer read in the application goes
+   through this, so a build without the core timer (a host build) can
+   define it to read a counter of its own before including this file. */
+#ifndef TIMEBASE_COUNT_GET
+#include <xc.h>
+#define TIMEBASE_COUNT_GET()        _CP0_GET_COUNT()
+#endif
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Timebase Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void TIMEBASE_Initialize ( void )
+
+  Summary:
+    Starts the 64-bit extension and the core timer interrupt.
+
+  Remarks:
+    Must be called from SYS_Initialize.  The core timer vector priority is
+    set by the system configuration.
+*/
+
+void TIMEBASE_Initialize ( void );
+
+/*******************************************************************************
+  Function:
+    uint64_t TIMEBASE_TicksGet ( void )
+
+  Summary:
+    Returns the current time in core timer ticks since reset.
+
+  Remarks:
+    May be called from any context.  Interrupts are disabled for a few
+    instructions.
+*/
+
+uint64_t TIMEBASE_TicksGet ( void );
+
+/*******************************************************************************
+  Function:
+    uint64_t TIMEBASE_MicrosecondsGet ( void )
+
+  Summary:
+    Returns the current time in microseconds since reset.
+
+  Remarks:
+    Costs a 64-bit division.  Prefer comparing ticks against
+    TIMEBASE_US_TO_TICKS() constants on hot paths.
+*/
+
+uint64_t TIMEBASE_MicrosecondsGet ( void );
+
+/*******************************************************************************
+  Function:
+    bool TIMEBASE_AlarmSet ( uint64_t deadline )
+
+  Summary:
+    Makes the core timer interrupt fire no later than deadline.
+
+  Description:
+    An earlier alarm that is already pending is kept.  The alarm is one-shot:
+    once the interrupt has fired, callers that still need a wake-up set it
+    again.
+
+  Returns:
+    true  - The alarm is armed.
+    false - The deadline is already (or all but) due. Nothing was armed.
+
+  Remarks:
+    May be called from any context.
+*/
+
+bool TIMEBASE_AlarmSet ( uint64_t deadline );
+
+/*******************************************************************************
+  Function:
+    void TIMEBASE_Tasks_ISR ( void )
+
+  Summary:
+    Updates the extension and re-arms the core timer compare.
+
+  Remarks:
+    Must be called from the core timer interrupt vector of the system
+    configuration.
+*/
+
+void TIMEBASE_Tasks_ISR ( void );
+
+#endif /* _TIMEBASE_H */
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,234 @@
+/*******************************************************************************
+  Software Timer Wheel Source File
+
+  File Name:
+    timer_wheel.c
+
+  Summary:
+    One-shot software timers on the monotonic timebase.
+
+  Description:
+    A timer lives in slot (deadline >> TIMER_WHEEL_SLOT_SHIFT) modulo
+    TIMER_WHEEL_SLOTS.  wheel.position is the first slot number (not
+    reduced modulo the slot count) that may still hold an expired timer.
+    The current slot is revisited on every call until time has moved past
+    it, since its timers may expire at any point within it.
+*******************************************************************************/
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stddef.h>
+#include "timer_wheel.h"
+#include "run_loop.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+static struct
+{
+    TIMER_WHEEL_TIMER * slot[TIMER_WHEEL_SLOTS];
+    uint64_t position;
+
+    /* Timers on the wheel */
+    unsigned int active;
+} wheel;
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static TIMER_WHEEL_TIMER ** _TIMER_WHEEL_SlotGet ( uint64_t slotNumber )
+{
+    return &wheel.slot[slotNumber & (TIMER_WHEEL_SLOTS - 1)];
+}
+
+/* Takes a timer out of its list, slot or not */
+static void _TIMER_WHEEL_Remove ( TIMER_WHEEL_TIMER * timer )
+{
+    *timer->prev = timer->next;
+    if(timer->next != NULL)
+    {
+        timer->next->prev = timer->prev;
+    }
+    timer->next = NULL;
+    timer->prev = NULL;
+}
+
+static void _TIMER_WHEEL_Unlink ( TIMER_WHEEL_TIMER * timer )
+{
+    _TIMER_WHEEL_Remove(timer);
+    wheel.active --;
+}
+
+/* Runs the expired timers of one slot */
+static void _TIMER_WHEEL_SlotExpire ( uint64_t slotNumber, uint64_t now )
+{
+    TIMER_WHEEL_TIMER * timer = *_TIMER_WHEEL_SlotGet(slotNumber);
+    TIMER_WHEEL_TIMER * next;
+    TIMER_WHEEL_TIMER * expired = NULL;
+    TIMER_WHEEL_TIMER ** tail = &expired;
+
+    /* The callbacks may stop or re-arm any timer, so the expired ones are
+     * moved to a list of their own before the first one runs. They stay
+     * started on it: a callback that stops or re-arms one of them takes it
+     * off the list like off a slot. */
+    while(timer != NULL)
+    {
+        next = timer->next;
+        if(timer->deadline <= now)
+        {
+            _TIMER_WHEEL_Remove(timer);
+            timer->prev = tail;
+            *tail = timer;
+            tail = &timer->next;
+        }
+        timer = next;
+    }
+
+    while(expired != NULL)
+    {
+        timer = expired;
+        _TIMER_WHEEL_Unlink(timer);
+        timer->callback(timer, timer->context);
+    }
+}
+
+
+/* When TIMER_WHEEL_Tasks() next has something to do: the earliest deadline
+ * on the wheel.  Slot nowSlot + k only holds deadlines from the start of
+ * that slot on, so the walk stops at the first slot that starts after the
+ * earliest deadline seen so far.  Without a timer within one turn, every
+ * slot is looked at once. */
+static uint64_t _TIMER_WHEEL_NextCheckGet ( uint64_t nowSlot )
+{
+    uint64_t next = UINT64_MAX;
+    uint64_t slotNumber;
+    TIMER_WHEEL_TIMER * timer;
+
+    for(slotNumber = nowSlot; slotNumber < nowSlot + TIMER_WHEEL_SLOTS; slotNumber ++)
+    {
+        if(next <= (slotNumber << TIMER_WHEEL_SLOT_SHIFT))
+        {
+            break;
+        }
+        for(timer = *_TIMER_WHEEL_SlotGet(slotNumber); timer != NULL; timer = timer->next)
+        {
+            if(timer->deadline < next)
+            {
+                next = timer->deadline;
+            }
+        }
+    }
+    return next;
+}
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Timer Wheel Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void TIMER_WHEEL_Initialize ( void )
+{
+    int index;
+
+    for(index = 0; index < TIMER_WHEEL_SLOTS; index ++)
+    {
+        wheel.slot[index] = NULL;
+    }
+    wheel.position = TIMEBASE_TicksGet() >> TIMER_WHEEL_SLOT_SHIFT;
+    wheel.active = 0;
+}
+
+void TIMER_WHEEL_StartAt ( TIMER_WHEEL_TIMER * timer, uint64_t deadline,
+                           TIMER_WHEEL_CALLBACK callback, uintptr_t context )
+{
+    TIMER_WHEEL_TIMER ** slot;
+
+    TIMER_WHEEL_Stop(timer);
+
+    timer->deadline = deadline;
+    timer->callback = callback;
+    timer->context = context;
+
+    /* Anything already due is handled by the next pass over the current
+     * slot, so it is never filed behind the wheel position. */
+    if((deadline >> TIMER_WHEEL_SLOT_SHIFT) < wheel.position)
+    {
+        slot = _TIMER_WHEEL_SlotGet(wheel.position);
+    }
+    else
+    {
+        slot = _TIMER_WHEEL_SlotGet(deadline >> TIMER_WHEEL_SLOT_SHIFT);
+    }
+
+    timer->next = *slot;
+    timer->prev = slot;
+    if(*slot != NULL)
+    {
+        (*slot)->prev = &timer->next;
+    }
+    *slot = timer;
+    wheel.active ++;
+}
+
+void TIMER_WHEEL_Start ( TIMER_WHEEL_TIMER * timer, uint64_t delay,
+                         TIMER_WHEEL_CALLBACK callback, uintptr_t context )
+{
+    TIMER_WHEEL_StartAt(timer, TIMEBASE_TicksGet() + delay, callback, context);
+}
+
+void TIMER_WHEEL_Stop ( TIMER_WHEEL_TIMER * timer )
+{
+    if(timer->prev != NULL)
+    {
+        _TIMER_WHEEL_Unlink(timer);
+    }
+}
+
+bool TIMER_WHEEL_IsActive ( const TIMER_WHEEL_TIMER * timer )
+{
+    return (timer->prev != NULL);
+}
+
+void TIMER_WHEEL_Tasks ( void )
+{
+    uint64_t now = TIMEBASE_TicksGet();
+    uint64_t nowSlot = now >> TIMER_WHEEL_SLOT_SHIFT;
+
+    /* After a long stall one turn covers every slot */
+    if(nowSlot - wheel.position >= TIMER_WHEEL_SLOTS)
+    {
+        wheel.position = nowSlot - (TIMER_WHEEL_SLOTS - 1);
+    }
+
+    while(wheel.position < nowSlot)
+    {
+        _TIMER_WHEEL_SlotExpire(wheel.position, now);
+        wheel.position ++;
+    }
+    _TIMER_WHEEL_SlotExpire(nowSlot, now);
+
+    if(wheel.active != 0)
+    {
+        RUN_LOOP_WakeAt(_TIMER_WHEEL_NextCheckGet(nowSlot));
+    }
+}
+
+
+/*******************************************************************************
+ End of File
+ */
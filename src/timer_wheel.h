@@ -0,0 +1,167 @@
+/*******************************************************************************
+  Software Timer Wheel Header File
+
+  File Name:
+    timer_wheel.h
+
+  Summary:
+    One-shot software timers on the monotonic timebase.
+
+  Description:
+    Timers are caller owned descriptors hashed by deadline into a ring of
+    TIMER_WHEEL_SLOTS lists, each slot covering 2^TIMER_WHEEL_SLOT_SHIFT core
+    timer ticks.  Starting and stopping a timer is O(1).  TIMER_WHEEL_Tasks()
+    only looks at the slots that time has moved through since the previous
+    call, and runs the callbacks of the timers whose deadline has passed.
+    Timers further out than one turn of the wheel simply stay in their slot
+    until their turn comes.
+*******************************************************************************/
+
+#ifndef _TIMER_WHEEL_H
+#define _TIMER_WHEEL_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "timebase.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants and Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Slot width is 2^15 core timer ticks, 819 us at 80 MHz */
+#define TIMER_WHEEL_SLOT_SHIFT      15
+
+/* Number of slots, a power of two. One turn is about 52 ms at 80 MHz. */
+#define TIMER_WHEEL_SLOTS           64
+
+typedef struct _TIMER_WHEEL_TIMER TIMER_WHEEL_TIMER;
+
+// *****************************************************************************
+/* Timer Expiry Callback
+
+  Remarks:
+    Runs from TIMER_WHEEL_Tasks(), in task context.  It may start or stop
+    any timer, including the one that expired.
+*/
+
+typedef void (*TIMER_WHEEL_CALLBACK)(TIMER_WHEEL_TIMER * timer, uintptr_t context);
+
+// *****************************************************************************
+/* Timer Descriptor
+
+  Remarks:
+    Zero initialized descriptors are stopped.  The members are private to
+    the timer wheel.
+*/
+
+struct _TIMER_WHEEL_TIMER
+{
+    /* Expiry time in timebase ticks */
+    uint64_t deadline;
+
+    TIMER_WHEEL_CALLBACK callback;
+    uintptr_t context;
+
+    /* Slot list links. prev points at whatever points at this timer. */
+    TIMER_WHEEL_TIMER * next;
+    TIMER_WHEEL_TIMER ** prev;
+};
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Timer Wheel Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void TIMER_WHEEL_Initialize ( void )
+
+  Summary:
+    Empties the wheel and starts it at the current time.
+
+  Remarks:
+    Must be called from SYS_Initialize after TIMEBASE_Initialize().
+*/
+
+void TIMER_WHEEL_Initialize ( void );
+
+/*******************************************************************************
+  Function:
+    void TIMER_WHEEL_Start ( TIMER_WHEEL_TIMER * timer, uint64_t delay,
+                             TIMER_WHEEL_CALLBACK callback, uintptr_t context )
+
+  Summary:
+    (Re)starts a one-shot timer that expires delay ticks from now.
+
+  Remarks:
+    A running timer is restarted with the new delay.  Task context only.
+*/
+
+void TIMER_WHEEL_Start ( TIMER_WHEEL_TIMER * timer, uint64_t delay,
+                         TIMER_WHEEL_CALLBACK callback, uintptr_t context );
+
+/*******************************************************************************
+  Function:
+    void TIMER_WHEEL_StartAt ( TIMER_WHEEL_TIMER * timer, uint64_t deadline,
+                               TIMER_WHEEL_CALLBACK callback, uintptr_t context )
+
+  Summary:
+    Like TIMER_WHEEL_Start(), with an absolute deadline in timebase ticks.
+*/
+
+void TIMER_WHEEL_StartAt ( TIMER_WHEEL_TIMER * timer, uint64_t deadline,
+                           TIMER_WHEEL_CALLBACK callback, uintptr_t context );
+
+/*******************************************************************************
+  Function:
+    void TIMER_WHEEL_Stop ( TIMER_WHEEL_TIMER * timer )
+
+  Summary:
+    Stops a timer. Stopping a stopped timer does nothing.
+*/
+
+void TIMER_WHEEL_Stop ( TIMER_WHEEL_TIMER * timer );
+
+/*******************************************************************************
+  Function:
+    bool TIMER_WHEEL_IsActive ( const TIMER_WHEEL_TIMER * timer )
+
+  Summary:
+    Returns true while the timer is started and has not expired.
+*/
+
+bool TIMER_WHEEL_IsActive ( const TIMER_WHEEL_TIMER * timer );
+
+/*******************************************************************************
+  Function:
+    void TIMER_WHEEL_Tasks ( void )
+
+  Summary:
+    Runs the callbacks of all expired timers.
+
+  Description:
+    While any timer is started, a run loop wake-up is requested for the
+    next time there may be one to expire.
+
+  Remarks:
+    Must be called from SYS_Tasks.
+*/
+
+void TIMER_WHEEL_Tasks ( void );
+
+#endif /* _TIMER_WHEEL_H */
+/*******************************************************************************
+ End of File
+ */
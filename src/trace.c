@@ -0,0 +1,137 @@
+/*******************************************************************************
+  Latency Tracer Source File
+
+  File Name:
+    trace.c
+
+  Summary:
+    Timestamped records of each sample's way from the sensor to the host.
+
+  Description:
+    Records are written from the SPI/DMA and USB interrupts as well as from
+    task context, so the ring has several producers.  Each access is a few
+    instructions long and simply runs with interrupts disabled.
+*******************************************************************************/
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "trace.h"
+#include "system_definitions.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#if TRACE_ENABLE
+static struct
+{
+    TRACE_RECORD records[TRACE_RECORDS];
+
+    /* Free running indices. head - tail is the number of records held. */
+    uint32_t head;
+    uint32_t tail;
+
+    /* Records overwritten since the previous report */
+    uint32_t lost;
+} trace;
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Tracer Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void TRACE_Record ( TRACE_EVENT event, uint32_t time, uint8_t aux, uint16_t sequence )
+{
+    bool intState;
+    TRACE_RECORD * record;
+
+    intState = SYS_INT_Disable();
+
+    if(trace.head - trace.tail == TRACE_RECORDS)
+    {
+        /* Full: the oldest record makes room */
+        trace.tail ++;
+        trace.lost ++;
+    }
+
+    record = &trace.records[trace.head & (TRACE_RECORDS - 1)];
+    record->time = time;
+    record->event = (uint8_t)event;
+    record->aux = aux;
+    record->sequence = sequence;
+    trace.head ++;
+
+    SYS_INT_Restore(intState);
+}
+
+void TRACE_ReportGet ( uint8_t * report )
+{
+    bool intState;
+    uint32_t count;
+    uint32_t lost;
+    uint32_t index;
+    uint8_t * out;
+    const TRACE_RECORD * record;
+
+    intState = SYS_INT_Disable();
+
+    count = trace.head - trace.tail;
+    if(count > TRACE_REPORT_RECORDS)
+    {
+        count = TRACE_REPORT_RECORDS;
+    }
+    lost = (trace.lost > UINT16_MAX) ? UINT16_MAX : trace.lost;
+    trace.lost = 0;
+
+    out = &report[TRACE_REPORT_HEADER_BYTES];
+    for(index = 0; index < TRACE_REPORT_RECORDS; index ++)
+    {
+        if(index < count)
+        {
+            record = &trace.records[trace.tail & (TRACE_RECORDS - 1)];
+            trace.tail ++;
+
+            out[0] = (uint8_t)record->time;
+            out[1] = (uint8_t)(record->time >> 8);
+            out[2] = (uint8_t)(record->time >> 16);
+            out[3] = (uint8_t)(record->time >> 24);
+            out[4] = record->event;
+            out[5] = record->aux;
+            out[6] = (uint8_t)record->sequence;
+            out[7] = (uint8_t)(record->sequence >> 8);
+        }
+        else
+        {
+            out[0] = out[1] = out[2] = out[3] = 0;
+            out[4] = out[5] = out[6] = out[7] = 0;
+        }
+        out += TRACE_RECORD_BYTES;
+    }
+
+    SYS_INT_Restore(intState);
+
+    report[0] = TRACE_REPORT_ID;
+    report[1] = TRACE_REPORT_FORMAT;
+    report[2] = (uint8_t)count;
+    report[3] = 0;
+    report[4] = (uint8_t)lost;
+    report[5] = (uint8_t)(lost >> 8);
+    report[6] = 0;
+    report[7] = 0;
+}
+#endif
+
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,194 @@
+/*******************************************************************************
+  Latency Tracer Header File
+
+  File Name:
+    trace.h
+
+  Summary:
+    Timestamped records of each sample's way from the sensor to the host.
+
+  Description:
+    The accelerometer driver and the application record an event at each
+    stage a sample goes through: when it was produced, when its SPI burst
+    completed, when the application took it, when the report carrying it
+    was handed to the HID driver and when that report was sent.  Events
+    carry the core timer count and the 16-bit sequence number of the
+    sample, so the host can line the stages up again.
+
+    Records go into a fixed size RAM ring that overwrites its oldest
+    records when full.  The host drains it with a vendor defined feature
+    report in a top-level collection of its own, and tools/trace_decode.py
+    turns the dump into latency percentiles and a Chrome trace timeline.
+
+    Everything compiles away unless the system configuration sets
+    TRACE_ENABLE to true.
+*******************************************************************************/
+
+#ifndef _TRACE_H
+#define _TRACE_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "system_config.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants and Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE                false
+#endif
+
+/* Records held in RAM, a power of two */
+#define TRACE_RECORDS               256
+
+/* Records per feature report */
+#define TRACE_REPORT_RECORDS        32
+
+// *****************************************************************************
+/* Trace Events
+
+  Remarks:
+    The values are part of the dump format read by tools/trace_decode.py.
+*/
+
+typedef enum
+{
+    /* The newest sample of a FIFO burst was produced. Its time is the
+       sample's timestamp, not the time of recording. */
+    TRACE_EVENT_DATA_READY = 1,
+
+    /* The SPI burst holding the samples completed. aux is the number of
+       samples in it. */
+    TRACE_EVENT_SPI_DONE,
+
+    /* The application took the samples up to this one */
+    TRACE_EVENT_PIPELINE_OUT,
+
+    /* USB_DEVICE_HID_ReportSend() was called. aux is the report number. */
+    TRACE_EVENT_REPORT_SEND,
+
+    /* USB_DEVICE_HID_EVENT_REPORT_SENT arrived. aux is the report number. */
+    TRACE_EVENT_REPORT_SENT
+
+} TRACE_EVENT;
+
+// *****************************************************************************
+/* Trace Record
+
+  Description:
+    8 bytes, packed little endian into the feature report in this order.
+*/
+
+typedef struct
+{
+    /* Core timer count */
+    uint32_t time;
+
+    /* TRACE_EVENT */
+    uint8_t event;
+
+    /* Event specific */
+    uint8_t aux;
+
+    /* Sequence number of the newest sample concerned */
+    uint16_t sequence;
+
+} TRACE_RECORD;
+
+#define TRACE_RECORD_BYTES          8
+
+// *****************************************************************************
+/* Trace Feature Report
+
+  Description:
+    Report ID, format (1), number of records that follow, one reserved
+    byte, records lost to overwriting since the previous report (16-bit
+    little endian, saturating), two reserved bytes, then TRACE_REPORT_RECORDS
+    record slots.  Each report returns the oldest records in the ring and
+    removes them; the host reads until the count is zero.
+*/
+
+#define TRACE_REPORT_FORMAT         1
+#define TRACE_REPORT_HEADER_BYTES   8
+#define TRACE_REPORT_SIZE           (TRACE_REPORT_HEADER_BYTES + \
+                                     TRACE_REPORT_RECORDS * TRACE_RECORD_BYTES)
+
+#define TRACE_REPORT_DESCRIPTOR                                               \
+    0x06, 0x00, 0xFF,           /* Usage Page (Vendor Defined FF00)  */       \
+    0x09, 0x03,                 /* Usage (3)                         */       \
+    0xA1, 0x01,                 /* Collection (Application)          */       \
+    0x85, TRACE_REPORT_ID,      /*   Report ID                       */       \
+    0x09, 0x04,                 /*   Usage (4)                       */       \
+    0x15, 0x00,                 /*   Logical Minimum (0)             */       \
+    0x26, 0xFF, 0x00,           /*   Logical Maximum (255)           */       \
+    0x75, 0x08,                 /*   Report Size (8)                 */       \
+    0x96, (uint8_t)(TRACE_REPORT_SIZE - 1),                                   \
+          (uint8_t)((TRACE_REPORT_SIZE - 1) >> 8),                            \
+                                /*   Report Count                    */       \
+    0xB1, 0x02,                 /*   Feature (Data, Variable, Abs)   */       \
+    0xC0                        /* End Collection                    */
+
+// *****************************************************************************
+/* Event Recording
+
+  Summary:
+    Records event at time, for the sample numbered sequence.
+*/
+
+#if TRACE_ENABLE
+#define TRACE_RECORD_EVENT(event, time, aux, sequence)                        \
+    TRACE_Record((event), (time), (aux), (sequence))
+#else
+#define TRACE_RECORD_EVENT(event, time, aux, sequence)
+#endif
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Tracer Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/*******************************************************************************
+  Function:
+    void TRACE_Record ( TRACE_EVENT event, uint32_t time, uint8_t aux,
+                        uint16_t sequence )
+
+  Summary:
+    Appends a record, overwriting the oldest one if the ring is full.
+
+  Remarks:
+    May be called from any context.  Normally called through
+    TRACE_RECORD_EVENT().
+*/
+
+void TRACE_Record ( TRACE_EVENT event, uint32_t time, uint8_t aux, uint16_t sequence );
+
+/*******************************************************************************
+  Function:
+    void TRACE_ReportGet ( uint8_t * report )
+
+  Summary:
+    Moves the oldest records into TRACE_REPORT_SIZE bytes of feature report.
+
+  Remarks:
+    May be called from the USB interrupt.
+*/
+
+void TRACE_ReportGet ( uint8_t * report );
+
+#endif /* _TRACE_H */
+/*******************************************************************************
+ End of File
+ */
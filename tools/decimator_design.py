@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+"""Design the coefficients of the hid_mouse firmware's rate converter.
+
+The decimator (src/decimator.h) converts the accelerometer's output data
+rate to the report rate by a rational factor UP/DOWN with a polyphase FIR
+filter.  This script designs the Kaiser windowed sinc prototype for a
+given pair of rates, splits it into UP phases of TAPS coefficients each,
+quantizes every phase to Q15 with a DC gain of exactly 1 (so that a
+steady tilt gives the same output whatever the phase) and prints the
+system_config.h lines that select it, with the filter's delay, cost and
+response.
+
+    tools/decimator_design.py --odr 1600 --rate 1000 --taps 8
+"""
+
+import argparse
+import math
+
+Q15 = 1 << 15
+
+
+def bessel_i0(x):
+    term = total = 1.0
+    k = 1
+    while term > 1e-12 * total:
+        term *= (x / (2.0 * k)) ** 2
+        total += term
+        k += 1
+    return total
+
+
+def prototype(length, cutoff, beta):
+    """Low pass of the given length, cutoff as a fraction of the sample rate."""
+    middle = (length - 1) / 2.0
+    taps = []
+    for n in range(length):
+        t = n - middle
+        sinc = 2.0 * cutoff if t == 0 else math.sin(2.0 * math.pi * cutoff * t) / (math.pi * t)
+        window = bessel_i0(beta * math.sqrt(1.0 - (t / middle) ** 2)) / bessel_i0(beta)
+        taps.append(sinc * window)
+    return taps
+
+
+def quantize_phase(values):
+    """Round to Q15 and put the rounding error on the largest coefficient."""
+    scale = Q15 / sum(values)
+    coefficients = [int(round(v * scale)) for v in values]
+    largest = max(range(len(values)), key=lambda i: abs(coefficients[i]))
+    coefficients[largest] += Q15 - sum(coefficients)
+    return coefficients
+
+
+def response_db(phases, up, frequency, rate):
+    """Gain of the quantized prototype at frequency, rate being its sample rate."""
+    real = imag = 0.0
+    for p, phase in enumerate(phases):
+        for k, c in enumerate(reversed(phase)):
+            n = p + k * up
+            real += c * math.cos(2.0 * math.pi * frequency * n / rate)
+            imag -= c * math.sin(2.0 * math.pi * frequency * n / rate)
+    gain = math.hypot(real, imag) / (up * Q15)
+    return 20.0 * math.log10(max(gain, 1e-12))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--odr", type=int, default=1600, help="sensor output data rate, Hz")
+    parser.add_argument("--rate", type=int, default=1000, help="output (report) rate, Hz")
+    parser.add_argument("--taps", type=int, default=8, help="coefficients per phase")
+    parser.add_argument("--cutoff", type=float,
+                        help="-6 dB frequency, Hz (default half the lower rate)")
+    parser.add_argument("--beta", type=float, default=5.0, help="Kaiser window shape")
+    parser.add_argument("--tick-hz", type=float, default=40e6,
+                        help="core timer rate, SYS_CLK_FREQ / 2 (default 40 MHz)")
+    args = parser.parse_args()
+
+    common = math.gcd(args.odr, args.rate)
+    up = args.rate // common
+    down = args.odr // common
+    if up > down:
+        parser.error("the output rate must not be above the sensor rate")
+
+    upsampled = args.odr * up
+    cutoff = args.cutoff if args.cutoff else min(args.odr, args.rate) / 2.0
+    taps = prototype(up * args.taps, cutoff / upsampled, args.beta)
+    phases = [quantize_phase(list(reversed(taps[p::up]))) for p in range(up)]
+
+    for phase in phases:
+        if max(abs(c) for c in phase) >= Q15:
+            parser.error("a coefficient does not fit Q15, use more taps or a lower cutoff")
+        if sum(abs(c) for c in phase) >= 2 * Q15:
+            parser.error("a phase could overflow the 32-bit accumulator")
+
+    delay = (up * args.taps - 1) / 2.0 / upsampled
+    print("/* %d Hz to %d Hz, %d taps per phase, -6 dB at %.0f Hz, Kaiser beta %.1f." % (
+        args.odr, args.rate, args.taps, cutoff, args.beta))
+    print("   Delay %.2f ms (%d core timer ticks), %d multiplies per output and axis." % (
+        delay * 1e3, round(delay * args.tick_hz), args.taps))
+    # the pointer band, the cutoff, what aliases onto 50 Hz at the output rate
+    # and, when interpolating, the first image of 50 Hz
+    frequencies = [10, 50, cutoff, args.rate - 50]
+    if up > 1:
+        frequencies.append(args.odr - 50)
+    print("   Response: %s */" % ", ".join(
+        "%.0f Hz %.1f dB" % (f, response_db(phases, up, f, upsampled)) for f in frequencies))
+    print()
+    print("#define DECIMATOR_UP %d" % up)
+    print("#define DECIMATOR_DOWN %d" % down)
+    print("#define DECIMATOR_TAPS %d" % args.taps)
+    print("%-76s\\" % "#define DECIMATOR_COEFFICIENTS")
+    for p, phase in enumerate(phases):
+        line = "    " + ", ".join("%6d" % c for c in phase) + ("," if p < up - 1 else "")
+        print("%-76s\\" % line if p < up - 1 else line)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,178 @@
+#!/usr/bin/env python3
+"""Record raw accelerometer samples from the hid_mouse firmware.
+
+The firmware (src/capture.c, CAPTURE_ENABLE) streams every sample the
+application consumes through feature report CAPTURE_REPORT_ID.  This tool
+reads it with the hidapi Python package and stores the samples in a
+compact trace file, or prints a trace file as CSV.
+
+Trace file format, all integers little endian:
+
+    header   "ACCT", version (u8, 1), 3 reserved bytes,
+             core timer rate in Hz (u32), sensor data rate in Hz (u16),
+             2 reserved bytes
+    records  one per sample, five unsigned LEB128 varints:
+             sequence step - 1, timestamp step - sequence step * nominal
+             sample period (zigzag), then x, y and z steps (zigzag)
+
+Steps are taken from the previous record, starting from sequence 0xFFFF,
+time 0 and a zero sample.  Sequence numbers are 16-bit and timestamps
+32-bit core timer counts, both wrapping.  A gapless stream of a sensor at
+rest costs about five bytes per sample, twelve on the wire.
+
+Each 248-byte report takes 33 transactions on the device's 8-byte EP0 and
+the device needs 80 of them a second at 1600 Hz.  A host that cannot poll
+that fast sees the drop count rise; build the firmware with
+CAPTURE_DECIMATION 2 or 4 to thin the stream at the source instead.
+
+read_trace() is the reader for replay tools.  host/test/replay.c feeds a
+trace through the whole firmware on the host simulator and prints the
+mouse reports it sends.
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+MAGIC = b"ACCT"
+VERSION = 1
+HEADER = struct.Struct("<4sB3xIH2x")
+
+REPORT_FORMAT = 1
+REPORT_HEADER_BYTES = 8
+SAMPLE_BYTES = 12
+REPORT_SAMPLES = 20
+REPORT_SIZE = REPORT_HEADER_BYTES + REPORT_SAMPLES * SAMPLE_BYTES
+
+
+def zigzag(value):
+    return (value << 1) if value >= 0 else ((-value << 1) - 1)
+
+
+def unzigzag(value):
+    return (value >> 1) if not (value & 1) else -((value + 1) >> 1)
+
+
+def put_varint(out, value):
+    while value >= 0x80:
+        out.append((value & 0x7F) | 0x80)
+        value >>= 7
+    out.append(value)
+
+
+def get_varint(data, offset):
+    value = 0
+    shift = 0
+    while True:
+        byte = data[offset]
+        offset += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value, offset
+
+
+def signed(value, bits):
+    value &= (1 << bits) - 1
+    return value - (1 << bits) if value >= (1 << (bits - 1)) else value
+
+
+class TraceWriter:
+    def __init__(self, stream, tick_hz, odr_hz):
+        self.stream = stream
+        self.period = tick_hz // odr_hz
+        self.sequence = 0xFFFF
+        self.time = 0
+        self.sample = (0, 0, 0)
+        stream.write(HEADER.pack(MAGIC, VERSION, tick_hz, odr_hz))
+
+    def write(self, sequence, timestamp, x, y, z):
+        out = bytearray()
+        step = (sequence - self.sequence) & 0xFFFF or 0x10000
+        put_varint(out, step - 1)
+        put_varint(out, zigzag(signed(timestamp - self.time - step * self.period, 32)))
+        for new, old in zip((x, y, z), self.sample):
+            put_varint(out, zigzag(new - old))
+        self.stream.write(out)
+        self.sequence, self.time, self.sample = sequence, timestamp, (x, y, z)
+
+
+def read_trace(path):
+    """Yields (sequence, ticks, x, y, z) per sample.
+
+    sequence and ticks are extended so that they never wrap; ticks counts
+    from the first sample's timestamp."""
+    with open(path, "rb") as f:
+        data = f.read()
+    magic, version, tick_hz, odr_hz = HEADER.unpack_from(data)
+    if magic != MAGIC or version != VERSION:
+        raise ValueError("%s is not a version %d sensor trace" % (path, VERSION))
+    period = tick_hz // odr_hz
+    offset = HEADER.size
+    sequence, ticks, sample = -1, None, [0, 0, 0]
+    while offset < len(data):
+        step, offset = get_varint(data, offset)
+        step += 1
+        jitter, offset = get_varint(data, offset)
+        delta = step * period + unzigzag(jitter)
+        ticks = 0 if ticks is None else ticks + delta
+        sequence += step
+        for axis in range(3):
+            change, offset = get_varint(data, offset)
+            sample[axis] += unzigzag(change)
+        yield sequence, ticks, sample[0], sample[1], sample[2]
+
+
+def capture(args):
+    import hid  # hidapi
+
+    device = hid.device()
+    device.open(args.vid, args.pid)
+    count = 0
+    dropped = 0
+    try:
+        with open(args.trace, "wb") as f:
+            writer = TraceWriter(f, int(args.tick_hz), args.odr_hz)
+            end = time.monotonic() + args.seconds
+            while time.monotonic() < end:
+                report = bytes(device.get_feature_report(args.report_id, REPORT_SIZE))
+                if report[1] != REPORT_FORMAT:
+                    raise ValueError("unknown capture format %d" % report[1])
+                dropped = struct.unpack_from("<I", report, 4)[0]
+                for index in range(report[2]):
+                    x, y, z, sequence, timestamp = struct.unpack_from(
+                        "<hhhHI", report, REPORT_HEADER_BYTES + index * SAMPLE_BYTES)
+                    writer.write(sequence, timestamp, x, y, z)
+                    count += 1
+                if report[2] < REPORT_SAMPLES:
+                    time.sleep(0.002)
+    finally:
+        device.close()
+    sys.stderr.write("%d samples, %d dropped by the device since reset\n" % (count, dropped))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("trace", help="trace file to write, or to print with --csv")
+    parser.add_argument("--csv", action="store_true", help="print the trace as CSV")
+    parser.add_argument("--seconds", type=float, default=10)
+    parser.add_argument("--vid", type=lambda v: int(v, 0), default=0x0458)
+    parser.add_argument("--pid", type=lambda v: int(v, 0), default=0x0000)
+    parser.add_argument("--report-id", type=int, default=5)
+    parser.add_argument("--tick-hz", type=float, default=40e6,
+                        help="core timer rate, SYS_CLK_FREQ / 2 (default 40 MHz)")
+    parser.add_argument("--odr-hz", type=int, default=1600, help="ACC_ODR_HZ")
+    args = parser.parse_args()
+
+    if args.csv:
+        print("sequence,ticks,x,y,z")
+        for record in read_trace(args.trace):
+            print(",".join(str(v) for v in record))
+    else:
+        capture(args)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+"""Print the hid_mouse firmware's delivery statistics once per second.
+
+Reads feature report APP_STATS_REPORT_ID (src/app.h) with the hidapi
+Python package.  Run it against each firmware configuration with the same
+motion to compare them: reports per second, frames that ended with
+movement pending but no report, the longest gap between two reports
+while movement kept going out, movement lost to saturation, sensor
+samples lost, the worst sample age and the CPU load.
+"""
+
+import argparse
+import struct
+import time
+
+REPORT_FORMAT = 2
+REPORT_SIZE = 4 + 12 * 4
+FIELDS = ("frames", "reports", "missed", "gapMax", "saturated", "overflows",
+          "overruns", "ageMax", "passes", "wakeups", "busyTicks", "windowTicks")
+
+
+def parse(report):
+    report = bytes(report)
+    if report[1] != REPORT_FORMAT:
+        raise ValueError("unknown statistics format %d" % report[1])
+    stats = dict(zip(FIELDS, struct.unpack_from("<12I", report, 4)))
+    stats["queueDepth"] = report[2]
+    return stats
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--vid", type=lambda v: int(v, 0), default=0x0458)
+    parser.add_argument("--pid", type=lambda v: int(v, 0), default=0x0000)
+    parser.add_argument("--report-id", type=int, default=4)
+    parser.add_argument("--tick-hz", type=float, default=40e6,
+                        help="core timer rate, SYS_CLK_FREQ / 2 (default 40 MHz)")
+    parser.add_argument("--seconds", type=int, default=10)
+    args = parser.parse_args()
+
+    import hid  # hidapi
+
+    device = hid.device()
+    device.open(args.vid, args.pid)
+    try:
+        s = parse(device.get_feature_report(args.report_id, REPORT_SIZE))
+        print("report queue depth %d" % s["queueDepth"])
+        print("%8s %8s %8s %10s %10s %9s %9s %10s %8s %8s %6s" % (
+            "frames", "reports", "missed", "gapMax us", "saturated", "overflow",
+            "overrun", "ageMax us", "passes", "wakeups", "busy%"))
+        for _ in range(args.seconds):
+            time.sleep(1)
+            s = parse(device.get_feature_report(args.report_id, REPORT_SIZE))
+            busy = 100.0 * s["busyTicks"] / s["windowTicks"] if s["windowTicks"] else 0.0
+            print("%8d %8d %8d %10.1f %10d %9d %9d %10.1f %8d %8d %6.1f" % (
+                s["frames"], s["reports"], s["missed"],
+                s["gapMax"] * 1e6 / args.tick_hz, s["saturated"],
+                s["overflows"], s["overruns"], s["ageMax"] * 1e6 / args.tick_hz,
+                s["passes"], s["wakeups"], busy))
+    finally:
+        device.close()
+
+
+if __name__ == "__main__":
+    main()
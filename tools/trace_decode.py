@@ -0,0 +1,199 @@
+#!/usr/bin/env python3
+"""Decode a latency trace dumped by the hid_mouse firmware.
+
+The firmware (src/trace.c) records every stage a sensor sample goes through
+in a RAM ring that the host drains with feature report TRACE_REPORT_ID.
+A dump is the concatenation of those feature reports, report ID included,
+as returned by any HID library.  --capture reads one directly with the
+hidapi Python package.
+
+Prints the latency percentiles of each stage and, with --chrome, writes a
+timeline that chrome://tracing or https://ui.perfetto.dev can open.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+REPORT_FORMAT = 1
+HEADER_BYTES = 8
+RECORD_BYTES = 8
+REPORT_RECORDS = 32
+REPORT_SIZE = HEADER_BYTES + REPORT_RECORDS * RECORD_BYTES
+
+DATA_READY, SPI_DONE, PIPELINE_OUT, REPORT_SEND, REPORT_SENT = range(1, 6)
+
+# Samples followed at once, a few frames' worth
+MAX_OPEN = 64
+
+STAGES = [
+    ("sensor -> SPI done", DATA_READY, SPI_DONE),
+    ("SPI done -> pipeline", SPI_DONE, PIPELINE_OUT),
+    ("pipeline -> ReportSend", PIPELINE_OUT, REPORT_SEND),
+    ("ReportSend -> REPORT_SENT", REPORT_SEND, REPORT_SENT),
+    ("sensor -> REPORT_SENT", DATA_READY, REPORT_SENT),
+]
+
+
+def parse_reports(data):
+    """Yields (records, lost) for each feature report in a dump."""
+    for offset in range(0, len(data) - REPORT_SIZE + 1, REPORT_SIZE):
+        report = data[offset:offset + REPORT_SIZE]
+        _, fmt, count, _, lost = struct.unpack_from("<BBBBH", report)
+        if fmt != REPORT_FORMAT:
+            raise ValueError("report at offset %d has format %d" % (offset, fmt))
+        records = [struct.unpack_from("<IBBH", report, HEADER_BYTES + i * RECORD_BYTES)
+                   for i in range(count)]
+        yield records, lost
+
+
+def unwrap(records):
+    """Extends the 32-bit core timer counts to a monotonic 64-bit time.
+
+    Records are in the order they were written.  DATA_READY carries the
+    sample's own (earlier) timestamp, so steps are taken as signed."""
+    base = None
+    last = 0
+    out = []
+    for time, event, aux, sequence in records:
+        if base is None:
+            base = time
+            last = 0
+        delta = (time - base - last) & 0xFFFFFFFF
+        if delta >= 0x80000000:
+            delta -= 0x100000000
+        last += delta
+        out.append((last, event, aux, sequence))
+    return out
+
+
+def newer_or_same(sequence, reference):
+    """16-bit serial number comparison."""
+    return ((sequence - reference) & 0xFFFF) < 0x8000
+
+
+def correlate(records):
+    """Follows each traced sample through the stages.
+
+    A sample reaches a later stage with the first event of that stage that
+    covers its sequence number.  REPORT_SENT is matched to REPORT_SEND by
+    report number."""
+    samples = []
+    open_samples = []
+    sent_by_report = {}
+
+    for time, event, aux, sequence in records:
+        if event == DATA_READY:
+            sample = {"sequence": sequence, DATA_READY: time}
+            samples.append(sample)
+            open_samples.append(sample)
+        elif event in (SPI_DONE, PIPELINE_OUT, REPORT_SEND):
+            for sample in open_samples:
+                if event not in sample and newer_or_same(sequence, sample["sequence"]):
+                    sample[event] = time
+                    if event == REPORT_SEND:
+                        sample["report"] = aux
+                        sent_by_report.setdefault(aux, []).append(sample)
+            # Samples that never made it into a report are given up on
+            open_samples = [s for s in open_samples if REPORT_SEND not in s][-MAX_OPEN:]
+        elif event == REPORT_SENT:
+            for sample in sent_by_report.pop(aux, []):
+                sample[REPORT_SENT] = time
+    return samples
+
+
+def percentile(values, fraction):
+    index = min(len(values) - 1, int(round(fraction * (len(values) - 1))))
+    return values[index]
+
+
+def print_stats(samples, tick_hz, out):
+    scale = 1e6 / tick_hz
+    out.write("%-28s %8s %9s %9s %9s %9s\n" % ("stage (us)", "n", "p50", "p90", "p99", "max"))
+    for name, start, end in STAGES:
+        values = sorted((s[end] - s[start]) * scale for s in samples
+                        if start in s and end in s)
+        if not values:
+            out.write("%-28s %8d\n" % (name, 0))
+            continue
+        out.write("%-28s %8d %9.1f %9.1f %9.1f %9.1f\n" % (
+            name, len(values), percentile(values, 0.5), percentile(values, 0.9),
+            percentile(values, 0.99), values[-1]))
+
+
+def chrome_trace(samples, tick_hz):
+    scale = 1e6 / tick_hz
+    events = []
+    for tid, (name, start, end) in enumerate(STAGES[:-1]):
+        events.append({"ph": "M", "name": "thread_name", "pid": 1, "tid": tid,
+                       "args": {"name": name}})
+        for sample in samples:
+            if start in sample and end in sample:
+                events.append({
+                    "ph": "X", "pid": 1, "tid": tid,
+                    "name": "sample %d" % sample["sequence"],
+                    "ts": sample[start] * scale,
+                    "dur": (sample[end] - sample[start]) * scale,
+                    "args": {"report": sample.get("report")},
+                })
+    return {"traceEvents": events, "displayTimeUnit": "ms"}
+
+
+def capture(vid, pid, report_id, seconds):
+    import time
+    import hid  # hidapi
+
+    device = hid.device()
+    device.open(vid, pid)
+    data = bytearray()
+    end = time.monotonic() + seconds
+    try:
+        while time.monotonic() < end:
+            report = bytes(device.get_feature_report(report_id, REPORT_SIZE))
+            data += report
+            if report[2] == 0:
+                time.sleep(0.005)
+    finally:
+        device.close()
+    return bytes(data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("dump", help="dump file to read, or to write with --capture")
+    parser.add_argument("--capture", type=float, metavar="SECONDS",
+                        help="read the trace from the device for this long first")
+    parser.add_argument("--vid", type=lambda v: int(v, 0), default=0x0458)
+    parser.add_argument("--pid", type=lambda v: int(v, 0), default=0x0000)
+    parser.add_argument("--report-id", type=int, default=3)
+    parser.add_argument("--tick-hz", type=float, default=40e6,
+                        help="core timer rate, SYS_CLK_FREQ / 2 (default 40 MHz)")
+    parser.add_argument("--chrome", metavar="JSON", help="write a Chrome trace timeline")
+    args = parser.parse_args()
+
+    if args.capture:
+        with open(args.dump, "wb") as f:
+            f.write(capture(args.vid, args.pid, args.report_id, args.capture))
+
+    with open(args.dump, "rb") as f:
+        data = f.read()
+
+    records = []
+    lost = 0
+    for report_records, report_lost in parse_reports(data):
+        records.extend(report_records)
+        lost += report_lost
+
+    samples = correlate(unwrap(records))
+    sys.stdout.write("%d records, %d lost, %d samples\n" % (len(records), lost, len(samples)))
+    print_stats(samples, args.tick_hz, sys.stdout)
+
+    if args.chrome:
+        with open(args.chrome, "w") as f:
+            json.dump(chrome_trace(samples, args.tick_hz), f)
+
+
+if __name__ == "__main__":
+    main()